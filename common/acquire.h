@@ -0,0 +1,166 @@
+#ifndef ACQUIRE_H
+#define ACQUIRE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+
+#include "spsc_queue.h"
+
+//-----------------------------------------------------------------------------
+// Timer triggered sampling of a fixed set of ADC channels
+//
+// Sample sequencer 0 of ADC0 and of ADC1 get one step per channel, TIMER0
+// starts both of them at the sample rate and the conversions run in the
+// hardware, the CPU is not involved until the last step of a sequencer is
+// done. Its interrupt copies the results out of the FIFO, and when both
+// sequencers of a sample are in, the whole sample (an AcquireFrame, ADC0
+// channels first, then ADC1) goes into a queue. The main loop only takes
+// frames out of the queue with acquire_get, nothing waits for a conversion.
+//
+//   const uint32_t adc0[] = {ADC_CTL_CH2, ADC_CTL_CH1};
+//   acquire_init(clock, 1000, adc0, 2, NULL, 0);
+//   while (1)
+//   {
+//       while (!acquire_get(&frame))
+//       {
+//           SysCtlSleep();
+//       }
+//       ...frame.values[0], frame.values[1]
+//   }
+//
+// If the main loop falls behind by more than ACQUIRE_QUEUE_SIZE frames new
+// frames are dropped and counted in acquire_dropped. The pins of the
+// channels have to be set to ADC (GPIOPinTypeADC) by the caller.
+//-----------------------------------------------------------------------------
+// Steps of sample sequencer 0
+#define ACQUIRE_MAX_STEPS 8
+#define ACQUIRE_MAX_CHANNELS (2 * ACQUIRE_MAX_STEPS)
+// Frames the main loop can be behind, power of two
+#ifndef ACQUIRE_QUEUE_SIZE
+#define ACQUIRE_QUEUE_SIZE 32
+#endif
+
+typedef struct
+{
+    // Results in the order of the channels given to acquire_init
+    uint16_t values[ACQUIRE_MAX_CHANNELS];
+} AcquireFrame;
+
+SPSC_QUEUE(AcquireQueue, AcquireFrame, ACQUIRE_QUEUE_SIZE)
+
+AcquireQueue acquire_queue;
+// Frame being filled by the interrupts, bit 0 when ADC0 is in, bit 1 for ADC1
+AcquireFrame acquire_frame;
+uint8_t acquire_done;
+// Bits of acquire_done of the ADCs that are used
+uint8_t acquire_used;
+uint8_t acquire_steps[2];
+// Since start: complete frames, frames lost because the queue was full
+volatile uint32_t acquire_frames;
+volatile uint32_t acquire_dropped;
+
+//-----------------------------------------------------------------------------
+// Sequencer 0 of adc (0 or 1) is done
+void acquire_interrupt(uint8_t adc)
+{
+    uint32_t base = adc ? ADC1_BASE : ADC0_BASE;
+    uint32_t samples[ACQUIRE_MAX_STEPS];
+    uint16_t* values = &acquire_frame.values[adc ? acquire_steps[0] : 0];
+    int32_t count;
+    int32_t i;
+
+    ADCIntClear(base, 0);
+    count = ADCSequenceDataGet(base, 0, samples);
+    for (i = 0; i < count && i < acquire_steps[adc]; i++)
+    {
+        values[i] = samples[i];
+    }
+    acquire_done |= 1 << adc;
+    if (acquire_done == acquire_used)
+    {
+        acquire_done = 0;
+        acquire_frames++;
+        if (!AcquireQueue_enqueue(&acquire_queue, acquire_frame))
+        {
+            acquire_dropped++;
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void acquire_adc0_interrupt(void)
+{
+    acquire_interrupt(0);
+}
+//-----------------------------------------------------------------------------
+void acquire_adc1_interrupt(void)
+{
+    acquire_interrupt(1);
+}
+//-----------------------------------------------------------------------------
+// Sequencer 0 of adc with one step per channel (ADC_CTL_CHn), interrupt after the last
+void acquire_sequence_init(uint8_t adc, const uint32_t* channels, uint8_t count)
+{
+    uint32_t base = adc ? ADC1_BASE : ADC0_BASE;
+    uint8_t i;
+
+    acquire_steps[adc] = count;
+    if (count == 0)
+    {
+        return;
+    }
+    SysCtlPeripheralEnable(adc ? SYSCTL_PERIPH_ADC1 : SYSCTL_PERIPH_ADC0);
+    while (!SysCtlPeripheralReady(adc ? SYSCTL_PERIPH_ADC1 : SYSCTL_PERIPH_ADC0))
+    {
+    }
+    ADCSequenceDisable(base, 0);
+    ADCSequenceConfigure(base, 0, ADC_TRIGGER_TIMER, 0);
+    for (i = 0; i < count; i++)
+    {
+        ADCSequenceStepConfigure(base, 0, i, channels[i] | ((i == count - 1) ? ADC_CTL_IE | ADC_CTL_END : 0));
+    }
+    ADCSequenceEnable(base, 0);
+    ADCIntClear(base, 0);
+    ADCIntRegister(base, 0, adc ? acquire_adc1_interrupt : acquire_adc0_interrupt);
+    ADCIntEnable(base, 0);
+    acquire_used |= 1 << adc;
+}
+//-----------------------------------------------------------------------------
+// Sample the channels of ADC0 and ADC1 (up to ACQUIRE_MAX_STEPS each, count 0
+// to leave one out) rate_hz times per second, clock_hz is the system clock
+void acquire_init(uint32_t clock_hz, uint32_t rate_hz,
+                  const uint32_t* adc0_channels, uint8_t adc0_count,
+                  const uint32_t* adc1_channels, uint8_t adc1_count)
+{
+    AcquireQueue_init(&acquire_queue);
+    acquire_done = 0;
+    acquire_used = 0;
+    acquire_sequence_init(0, adc0_channels, adc0_count);
+    acquire_sequence_init(1, adc1_channels, adc1_count);
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER0))
+    {
+    }
+    TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(TIMER0_BASE, TIMER_A, clock_hz / rate_hz - 1);
+    TimerControlTrigger(TIMER0_BASE, TIMER_A, true);
+    TimerADCEventSet(TIMER0_BASE, TIMER_ADC_TIMEOUT_A);
+    IntMasterEnable();
+    TimerEnable(TIMER0_BASE, TIMER_A);
+}
+//-----------------------------------------------------------------------------
+// Oldest frame not taken yet, returns false if there is none
+bool acquire_get(AcquireFrame* frame)
+{
+    return AcquireQueue_dequeue(&acquire_queue, frame);
+}
+//-----------------------------------------------------------------------------
+
+#endif
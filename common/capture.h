@@ -0,0 +1,159 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "inc/hw_adc.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+
+#include "dma.h"
+
+//-----------------------------------------------------------------------------
+// One ADC channel sampled at a fixed rate into two buffers by the uDMA
+//
+// PWM0 generator 3 only serves as the sample clock: once per period it
+// triggers sample sequencer 3 of ADC1, which converts the channel, and the
+// uDMA moves the result from the FIFO into a buffer. The channel runs in
+// ping-pong mode, when one buffer is full it goes on with the other one by
+// itself, and the ADC interrupt hands the full buffer to the callback and
+// sets it up again. The CPU does nothing per sample, only once per buffer.
+//
+// The callback runs in the interrupt. It has CAPTURE_BUFFER_SIZE samples of
+// time (16 ms at 16 kHz) before the uDMA writes to that buffer again; if both
+// buffers fill up before the interrupt has run, the capture restarts and
+// capture_overruns counts it.
+//
+// A PWM trigger (not TIMER0 like acquire.h, the timer ADC triggers of all
+// timers are or'ed together) so that both can run at their own rate. The
+// period of the generator is 16 bits, the PWM clock is the system clock
+// divided by the smallest of 1 to 64 that fits it: rates from
+// clock_hz / 64 / 65535 (9.5 Hz at 40 MHz) up, slower ones get that rate.
+//-----------------------------------------------------------------------------
+// Samples per buffer, at most 1024 (one uDMA transfer)
+#ifndef CAPTURE_BUFFER_SIZE
+#define CAPTURE_BUFFER_SIZE 256
+#endif
+#define CAPTURE_DMA_CHANNEL 27
+
+typedef void (*CaptureCallback)(const uint16_t* samples, uint16_t count);
+
+uint16_t capture_buffers[2][CAPTURE_BUFFER_SIZE];
+CaptureCallback capture_callback;
+// Since start: buffers given to the callback, restarts because both were full
+volatile uint32_t capture_count;
+volatile uint32_t capture_overruns;
+
+//-----------------------------------------------------------------------------
+// Set up buffer 0 (primary) or 1 (alternate) for the next transfer
+void capture_buffer_start(uint8_t buffer)
+{
+    uDMAChannelTransferSet(CAPTURE_DMA_CHANNEL | (buffer ? UDMA_ALT_SELECT : UDMA_PRI_SELECT), UDMA_MODE_PINGPONG,
+                           (void*)(ADC1_BASE + ADC_O_SSFIFO3), capture_buffers[buffer], CAPTURE_BUFFER_SIZE);
+}
+//-----------------------------------------------------------------------------
+// uDMA transfer of a buffer done
+void capture_interrupt(void)
+{
+    bool done[2];
+    uint8_t i;
+
+    ADCIntClearEx(ADC1_BASE, ADC_INT_DMA_SS3);
+    done[0] = uDMAChannelModeGet(CAPTURE_DMA_CHANNEL | UDMA_PRI_SELECT) == UDMA_MODE_STOP;
+    done[1] = uDMAChannelModeGet(CAPTURE_DMA_CHANNEL | UDMA_ALT_SELECT) == UDMA_MODE_STOP;
+    // Both full, the uDMA has stopped; both are dropped and it starts over with the primary
+    if (done[0] && done[1])
+    {
+        capture_overruns++;
+        capture_buffer_start(0);
+        capture_buffer_start(1);
+        uDMAChannelAttributeDisable(CAPTURE_DMA_CHANNEL, UDMA_ATTR_ALTSELECT);
+        uDMAChannelEnable(CAPTURE_DMA_CHANNEL);
+        return;
+    }
+    for (i = 0; i < 2; i++)
+    {
+        if (done[i])
+        {
+            // The uDMA only gets back to it after the other buffer, the callback runs in the meantime
+            capture_buffer_start(i);
+            capture_count++;
+            capture_callback(capture_buffers[i], CAPTURE_BUFFER_SIZE);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+// Sample channel (ADC_CTL_CHn) rate_hz times per second, clock_hz is the system clock
+// The pin of the channel has to be set to ADC (GPIOPinTypeADC) by the caller
+void capture_init(uint32_t clock_hz, uint32_t rate_hz, uint32_t channel, CaptureCallback callback)
+{
+    const uint32_t dividers[7] = {PWM_SYSCLK_DIV_1, PWM_SYSCLK_DIV_2, PWM_SYSCLK_DIV_4, PWM_SYSCLK_DIV_8,
+                                  PWM_SYSCLK_DIV_16, PWM_SYSCLK_DIV_32, PWM_SYSCLK_DIV_64};
+    // System clock cycles per sample, split below into the PWM clock divider and the period
+    uint32_t period = (rate_hz != 0) ? clock_hz / rate_hz : 0xFFFFFFFF;
+    uint32_t divider = 0;
+
+    capture_callback = callback;
+    dma_init();
+
+    // ADC1 sequencer 3, one step, asks the uDMA for every sample
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC1);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC1))
+    {
+    }
+    ADCSequenceDisable(ADC1_BASE, 3);
+    ADCSequenceConfigure(ADC1_BASE, 3, ADC_TRIGGER_PWM3, 1);
+    ADCSequenceStepConfigure(ADC1_BASE, 3, 0, channel | ADC_CTL_IE | ADC_CTL_END);
+    ADCSequenceEnable(ADC1_BASE, 3);
+    ADCSequenceDMAEnable(ADC1_BASE, 3);
+
+    // 16 bit samples from the FIFO register into the buffers
+    uDMAChannelAssign(UDMA_CH27_ADC1_3);
+    uDMAChannelAttributeDisable(CAPTURE_DMA_CHANNEL, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(CAPTURE_DMA_CHANNEL | UDMA_PRI_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+    uDMAChannelControlSet(CAPTURE_DMA_CHANNEL | UDMA_ALT_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+    capture_buffer_start(0);
+    capture_buffer_start(1);
+    uDMAChannelEnable(CAPTURE_DMA_CHANNEL);
+
+    ADCIntClearEx(ADC1_BASE, ADC_INT_DMA_SS3);
+    ADCIntRegister(ADC1_BASE, 3, capture_interrupt);
+    ADCIntEnableEx(ADC1_BASE, ADC_INT_DMA_SS3);
+
+    // Sample clock, the ADC trigger when the counter reaches 0
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_PWM0))
+    {
+    }
+    // Smallest divider that fits the period in 16 bits, the slowest rate if none does
+    while ((period >> divider) > 65535 && divider < 6)
+    {
+        divider++;
+    }
+    period >>= divider;
+    if (period > 65535)
+    {
+        period = 65535;
+    }
+    else if (period == 0)
+    {
+        period = 1;
+    }
+    PWMClockSet(PWM0_BASE, dividers[divider]);
+    PWMGenConfigure(PWM0_BASE, PWM_GEN_3, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_NO_SYNC);
+    PWMGenPeriodSet(PWM0_BASE, PWM_GEN_3, period);
+    PWMGenIntTrigEnable(PWM0_BASE, PWM_GEN_3, PWM_TR_CNT_ZERO);
+    IntMasterEnable();
+    PWMGenEnable(PWM0_BASE, PWM_GEN_3);
+}
+//-----------------------------------------------------------------------------
+
+#endif
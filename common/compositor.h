@@ -0,0 +1,242 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "grlib/grlib.h"
+
+//-----------------------------------------------------------------------------
+// Dirty rectangle compositor for games made of filled rectangles
+//
+// Instead of erasing every object with the background color and drawing it
+// again at its new position, the game registers each object once (a pointer to
+// its tRectangle and a color), moves it by changing that tRectangle and calls
+// compositor_flush once per frame. The flush compares every object with what
+// is on the screen and only draws the parts that changed:
+//  - the part of the old rectangle that the new one does not cover is exposed,
+//    it is redrawn with the background and whatever objects are there now
+//  - the part of the new rectangle that the old one did not cover is drawn
+//    with the object's color (all of it if the color changed)
+// Objects added later are on top, where objects overlap the pixels are
+// always given the color of the top one. Objects that did not change cost
+// nothing, so walls and rackets that stand still are not redrawn.
+// Anything drawn on the screen outside the compositor (text, clearing the
+// screen) is not known to it, call compositor_invalidate after clearing the
+// screen so that the next flush draws every object again.
+//-----------------------------------------------------------------------------
+// Max number of objects
+#define COMPOSITOR_MAX_OBJECTS 32
+
+typedef struct
+{
+    // Where the object should be, owned by the game
+    const tRectangle* rect;
+    uint32_t color;
+    bool visible;
+    // What is on the screen
+    tRectangle drawn_rect;
+    uint32_t drawn_color;
+    bool drawn_visible;
+} CompositorObject;
+
+typedef struct
+{
+    tContext* context;
+    uint32_t background;
+    CompositorObject objects[COMPOSITOR_MAX_OBJECTS];
+    uint16_t count;
+} Compositor;
+//-----------------------------------------------------------------------------
+// Background is the color of the screen where there are no objects
+void compositor_init(Compositor* c, tContext* context, uint32_t background)
+{
+    c->context = context;
+    c->background = background;
+    c->count = 0;
+}
+//-----------------------------------------------------------------------------
+// Add an object on top of the others, visible from the next flush
+// rect has to stay valid as long as the compositor is used
+// Returns its id, or -1 if there are too many objects
+int16_t compositor_add(Compositor* c, const tRectangle* rect, uint32_t color)
+{
+    CompositorObject* object;
+
+    if (c->count >= COMPOSITOR_MAX_OBJECTS)
+    {
+        return -1;
+    }
+    object = &c->objects[c->count];
+    object->rect = rect;
+    object->color = color;
+    object->visible = true;
+    object->drawn_visible = false;
+    return c->count++;
+}
+//-----------------------------------------------------------------------------
+void compositor_show(Compositor* c, int16_t id, bool visible)
+{
+    c->objects[id].visible = visible;
+}
+//-----------------------------------------------------------------------------
+void compositor_set_color(Compositor* c, int16_t id, uint32_t color)
+{
+    c->objects[id].color = color;
+}
+//-----------------------------------------------------------------------------
+// The screen has been cleared to the background, nothing of the objects is on it anymore
+void compositor_invalidate(Compositor* c)
+{
+    uint16_t i;
+
+    for (i = 0; i < c->count; i++)
+    {
+        c->objects[i].drawn_visible = false;
+    }
+}
+//-----------------------------------------------------------------------------
+// Overlapping part of a and b in out, returns false if they don't overlap
+bool compositor_rect_intersect(const tRectangle* a, const tRectangle* b, tRectangle* out)
+{
+    out->i16XMin = (a->i16XMin > b->i16XMin) ? a->i16XMin : b->i16XMin;
+    out->i16YMin = (a->i16YMin > b->i16YMin) ? a->i16YMin : b->i16YMin;
+    out->i16XMax = (a->i16XMax < b->i16XMax) ? a->i16XMax : b->i16XMax;
+    out->i16YMax = (a->i16YMax < b->i16YMax) ? a->i16YMax : b->i16YMax;
+    return (out->i16XMin <= out->i16XMax) && (out->i16YMin <= out->i16YMax);
+}
+//-----------------------------------------------------------------------------
+// The part of a that b does not cover, as up to 4 rectangles (above, below, left and right of b)
+// Returns the number of rectangles in out
+uint16_t compositor_rect_subtract(const tRectangle* a, const tRectangle* b, tRectangle out[4])
+{
+    tRectangle overlap;
+    uint16_t n = 0;
+
+    if (!compositor_rect_intersect(a, b, &overlap))
+    {
+        out[0] = *a;
+        return 1;
+    }
+    // Above, full width of a
+    if (a->i16YMin < overlap.i16YMin)
+    {
+        out[n] = *a;
+        out[n].i16YMax = overlap.i16YMin - 1;
+        n++;
+    }
+    // Below, full width of a
+    if (a->i16YMax > overlap.i16YMax)
+    {
+        out[n] = *a;
+        out[n].i16YMin = overlap.i16YMax + 1;
+        n++;
+    }
+    // Left and right, only the rows of the overlap
+    if (a->i16XMin < overlap.i16XMin)
+    {
+        out[n].i16XMin = a->i16XMin;
+        out[n].i16XMax = overlap.i16XMin - 1;
+        out[n].i16YMin = overlap.i16YMin;
+        out[n].i16YMax = overlap.i16YMax;
+        n++;
+    }
+    if (a->i16XMax > overlap.i16XMax)
+    {
+        out[n].i16XMin = overlap.i16XMax + 1;
+        out[n].i16XMax = a->i16XMax;
+        out[n].i16YMin = overlap.i16YMin;
+        out[n].i16YMax = overlap.i16YMax;
+        n++;
+    }
+    return n;
+}
+//-----------------------------------------------------------------------------
+// Fill area with color, then draw the parts of the visible objects from id first and up that are in area
+void compositor_draw_area(Compositor* c, const tRectangle* area, uint16_t first, uint32_t color)
+{
+    CompositorObject* object;
+    tRectangle visible;
+    tRectangle part;
+    uint16_t i;
+
+    // Nothing to do for the parts outside the screen (objects that are moving in or out)
+    if (!compositor_rect_intersect(area, &c->context->sClipRegion, &visible))
+    {
+        return;
+    }
+    GrContextForegroundSet(c->context, color);
+    GrRectFill(c->context, &visible);
+    for (i = first; i < c->count; i++)
+    {
+        object = &c->objects[i];
+        if (object->visible && compositor_rect_intersect(&visible, object->rect, &part))
+        {
+            GrContextForegroundSet(c->context, object->color);
+            GrRectFill(c->context, &part);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+// Draw everything that changed since the last flush
+// The foreground color of the context is the same afterwards
+void compositor_flush(Compositor* c)
+{
+    CompositorObject* object;
+    tRectangle pieces[4];
+    uint32_t foreground = c->context->ui32Foreground;
+    uint16_t n;
+    uint16_t i;
+    uint16_t j;
+
+    for (i = 0; i < c->count; i++)
+    {
+        object = &c->objects[i];
+        if (object->visible == object->drawn_visible &&
+                (!object->visible ||
+                 (object->color == object->drawn_color &&
+                  memcmp(object->rect, &object->drawn_rect, sizeof(tRectangle)) == 0)))
+        {
+            continue;
+        }
+
+        // Exposed part of the old position, the background and every object there now
+        if (object->drawn_visible)
+        {
+            n = 1;
+            pieces[0] = object->drawn_rect;
+            if (object->visible)
+            {
+                n = compositor_rect_subtract(&object->drawn_rect, object->rect, pieces);
+            }
+            for (j = 0; j < n; j++)
+            {
+                compositor_draw_area(c, &pieces[j], 0, c->background);
+            }
+        }
+        // New part of the object, then the objects above it
+        if (object->visible)
+        {
+            n = 1;
+            pieces[0] = *object->rect;
+            if (object->drawn_visible && object->color == object->drawn_color)
+            {
+                n = compositor_rect_subtract(object->rect, &object->drawn_rect, pieces);
+            }
+            for (j = 0; j < n; j++)
+            {
+                compositor_draw_area(c, &pieces[j], i + 1, object->color);
+            }
+        }
+
+        object->drawn_rect = *object->rect;
+        object->drawn_color = object->color;
+        object->drawn_visible = object->visible;
+    }
+    // Already translated, set it back without GrContextForegroundSet
+    c->context->ui32Foreground = foreground;
+}
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef CYCLES_H
+#define CYCLES_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Cycle counter, for timing short pieces of code
+//
+// On the TM4C129 (Cortex-M4) this is the DWT cycle counter, which counts CPU
+// clock cycles. On an x86 host it is the time stamp counter (constant rate, not
+// the core clock, but good enough to compare two versions of the same code),
+// anywhere else it falls back to nanoseconds from clock_gettime.
+// The counter is 32 bits and wraps (after 107 s at 40 MHz, about 1 s on the
+// host), only take differences of readings close together.
+//-----------------------------------------------------------------------------
+#if defined(__arm__)
+// Cortex-M4 debug registers
+#define CYCLES_DEMCR        (*(volatile uint32_t*)0xE000EDFC)
+#define CYCLES_DWT_CTRL     (*(volatile uint32_t*)0xE0001000)
+#define CYCLES_DWT_CYCCNT   (*(volatile uint32_t*)0xE0001004)
+#else
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+// Counts per second, set by cycles_init
+uint32_t cycles_hz;
+
+//-----------------------------------------------------------------------------
+// Read the counter
+// The empty asm keeps the compiler from moving the code being timed across it
+static inline uint32_t cycles_now(void)
+{
+    uint32_t now;
+
+    __asm volatile ("" ::: "memory");
+#if defined(__arm__)
+    now = CYCLES_DWT_CYCCNT;
+#elif defined(__x86_64__) || defined(__i386__)
+    now = (uint32_t)__rdtsc();
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    now = (uint32_t)(time.tv_sec * 1000000000ull + time.tv_nsec);
+#endif
+    __asm volatile ("" ::: "memory");
+    return now;
+}
+//-----------------------------------------------------------------------------
+// Start the counter, clock_hz is the CPU clock (the return value of SysCtlClockFreqSet)
+// On the host the counter rate is measured instead, takes about 20 ms
+void cycles_init(uint32_t clock_hz)
+{
+#if defined(__arm__)
+    // Enable trace (TRCENA), then the cycle counter (CYCCNTENA)
+    CYCLES_DEMCR |= 0x01000000;
+    CYCLES_DWT_CYCCNT = 0;
+    CYCLES_DWT_CTRL |= 1;
+    cycles_hz = clock_hz;
+#elif defined(__x86_64__) || defined(__i386__)
+    struct timespec start;
+    struct timespec now;
+    uint32_t start_count;
+    uint64_t ns;
+
+    (void)clock_hz;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    start_count = cycles_now();
+    do
+    {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        ns = (now.tv_sec - start.tv_sec) * 1000000000ull + now.tv_nsec - start.tv_nsec;
+    }
+    while(ns < 20000000);
+    cycles_hz = (uint32_t)((cycles_now() - start_count) * 1000000000ull / ns);
+#else
+    (void)clock_hz;
+    cycles_hz = 1000000000;
+#endif
+}
+//-----------------------------------------------------------------------------
+// Counts to nanoseconds
+uint32_t cycles_to_ns(uint32_t count)
+{
+    return (uint32_t)(count * 1000000000ull / cycles_hz);
+}
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef DMA_H
+#define DMA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+
+//-----------------------------------------------------------------------------
+// uDMA controller setup, shared by everything in a program that uses DMA
+//
+// The uDMA reads the control structures of its channels from one table in
+// RAM that has to be aligned to 1024 bytes. dma_init enables the controller
+// and sets the table the first time it is called, after that it does nothing.
+//-----------------------------------------------------------------------------
+#if defined(ewarm)
+#pragma data_alignment=1024
+uint8_t dma_control_table[1024];
+#elif defined(ccs)
+#pragma DATA_ALIGN(dma_control_table, 1024)
+uint8_t dma_control_table[1024];
+#else
+uint8_t dma_control_table[1024] __attribute__((aligned(1024)));
+#endif
+
+bool dma_ready;
+
+//-----------------------------------------------------------------------------
+void dma_init(void)
+{
+    if (dma_ready)
+    {
+        return;
+    }
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA))
+    {
+    }
+    uDMAEnable();
+    uDMAControlBaseSet(dma_control_table);
+    dma_ready = true;
+}
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "grlib/grlib.h"
+
+//-----------------------------------------------------------------------------
+// Draw list in front of a grlib display driver
+//
+// Every GrRectFill (and horizontal/vertical line) on the LCD sets its own
+// window (CASET, RASET, RAMWR: 11 bytes) before the pixels. draw_list_display
+// records the fills of a frame instead and sends them at GrFlush:
+//  - a fill is merged into an earlier fill of the same color when together
+//    they are one rectangle (same columns and touching rows, or the other way
+//    around), or dropped if that fill already covers it
+//  - it can only move back past fills it does not overlap, so the screen ends
+//    up the same as when drawing in order
+//  - earlier fills that it covers completely (any color) are dropped
+// Pixels and text (PixelDraw, PixelDrawMultiple) are not recorded, the list is
+// sent before them. Anything drawn on the LCD without the context (clearing
+// the screen) has to come after a GrFlush.
+//
+//   draw_list_init(&g_sCF128x128x16_ST7735S);
+//   GrContextInit(&context, &draw_list_display);
+//
+// Compiling with -DDRAW_LIST_STATS prints the number of fills and windows
+// with UARTprintf, at exit on the host and every DRAW_LIST_REPORT_FRAMES
+// frames on the board.
+//-----------------------------------------------------------------------------
+// Max fills recorded, the list is sent early when it is full
+#define DRAW_LIST_MAX 32
+// Command bytes to set a window on the ST7735S
+#define DRAW_LIST_WINDOW_BYTES 11
+#ifndef DRAW_LIST_REPORT_FRAMES
+#define DRAW_LIST_REPORT_FRAMES 1000
+#endif
+
+typedef struct
+{
+    tRectangle rect;
+    // Translated color
+    uint32_t color;
+} DrawListFill;
+
+typedef struct
+{
+    const tDisplay* display;
+    DrawListFill fills[DRAW_LIST_MAX];
+    uint16_t count;
+    // Since start: GrFlush calls, fills drawn with the context, windows sent to the driver
+    uint32_t frames;
+    uint32_t recorded;
+    uint32_t windows;
+} DrawList;
+
+DrawList draw_list;
+
+//-----------------------------------------------------------------------------
+// Totals as one line of JSON: frames, fills drawn, windows sent and the window
+// command bytes they cost (one window per fill without the list)
+void draw_list_report(void)
+{
+    UARTprintf("{\"draw_list\":\"total\",\"frames\":%u,\"fills\":%u,\"windows\":%u,"
+               "\"command_bytes\":%u,\"command_bytes_saved\":%u}\n",
+               draw_list.frames, draw_list.recorded, draw_list.windows,
+               draw_list.windows * DRAW_LIST_WINDOW_BYTES,
+               (draw_list.recorded - draw_list.windows) * DRAW_LIST_WINDOW_BYTES);
+}
+//-----------------------------------------------------------------------------
+// Send the recorded fills to the driver and empty the list
+void draw_list_submit(DrawList* list)
+{
+    uint16_t i;
+
+    for (i = 0; i < list->count; i++)
+    {
+        list->display->pfnRectFill(list->display->pvDisplayData, &list->fills[i].rect, list->fills[i].color);
+    }
+    list->windows += list->count;
+    list->count = 0;
+}
+//-----------------------------------------------------------------------------
+bool draw_list_overlap(const tRectangle* a, const tRectangle* b)
+{
+    return a->i16XMin <= b->i16XMax && a->i16XMax >= b->i16XMin &&
+           a->i16YMin <= b->i16YMax && a->i16YMax >= b->i16YMin;
+}
+//-----------------------------------------------------------------------------
+bool draw_list_covers(const tRectangle* a, const tRectangle* b)
+{
+    return b->i16XMin >= a->i16XMin && b->i16XMax <= a->i16XMax &&
+           b->i16YMin >= a->i16YMin && b->i16YMax <= a->i16YMax;
+}
+//-----------------------------------------------------------------------------
+// a and b as one rectangle in a, returns false if their union is not a rectangle
+bool draw_list_merge(tRectangle* a, const tRectangle* b)
+{
+    if (draw_list_covers(a, b))
+    {
+        return true;
+    }
+    // Same columns, rows touch or overlap
+    if (a->i16XMin == b->i16XMin && a->i16XMax == b->i16XMax &&
+            b->i16YMin <= a->i16YMax + 1 && b->i16YMax >= a->i16YMin - 1)
+    {
+        a->i16YMin = (b->i16YMin < a->i16YMin) ? b->i16YMin : a->i16YMin;
+        a->i16YMax = (b->i16YMax > a->i16YMax) ? b->i16YMax : a->i16YMax;
+        return true;
+    }
+    // Same rows, columns touch or overlap
+    if (a->i16YMin == b->i16YMin && a->i16YMax == b->i16YMax &&
+            b->i16XMin <= a->i16XMax + 1 && b->i16XMax >= a->i16XMin - 1)
+    {
+        a->i16XMin = (b->i16XMin < a->i16XMin) ? b->i16XMin : a->i16XMin;
+        a->i16XMax = (b->i16XMax > a->i16XMax) ? b->i16XMax : a->i16XMax;
+        return true;
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+// Record a fill, rect is already clipped to the screen by grlib
+void draw_list_add(DrawList* list, const tRectangle* rect, uint32_t color)
+{
+    DrawListFill* fill;
+    int16_t i;
+    uint16_t j;
+
+    list->recorded++;
+    // Back to the last fill that overlaps it, a fill of the same color on the way can take it
+    for (i = list->count - 1; i >= 0; i--)
+    {
+        fill = &list->fills[i];
+        if (fill->color == color && draw_list_merge(&fill->rect, rect))
+        {
+            return;
+        }
+        if (draw_list_overlap(&fill->rect, rect))
+        {
+            break;
+        }
+    }
+    // Fills it paints over completely would never be seen
+    for (i = 0, j = 0; i < list->count; i++)
+    {
+        if (!draw_list_covers(rect, &list->fills[i].rect))
+        {
+            list->fills[j++] = list->fills[i];
+        }
+    }
+    list->count = j;
+    if (list->count == DRAW_LIST_MAX)
+    {
+        draw_list_submit(list);
+    }
+    fill = &list->fills[list->count++];
+    fill->rect = *rect;
+    fill->color = color;
+}
+//-----------------------------------------------------------------------------
+// grlib display functions, display_data is the DrawList
+void draw_list_pixel_draw(void* display_data, int32_t x, int32_t y, uint32_t value)
+{
+    DrawList* list = display_data;
+
+    draw_list_submit(list);
+    list->display->pfnPixelDraw(list->display->pvDisplayData, x, y, value);
+}
+//-----------------------------------------------------------------------------
+void draw_list_pixel_draw_multiple(void* display_data, int32_t x, int32_t y, int32_t x0, int32_t count,
+                                   int32_t bpp, const uint8_t* data, const uint8_t* palette)
+{
+    DrawList* list = display_data;
+
+    draw_list_submit(list);
+    list->display->pfnPixelDrawMultiple(list->display->pvDisplayData, x, y, x0, count, bpp, data, palette);
+}
+//-----------------------------------------------------------------------------
+void draw_list_line_draw_h(void* display_data, int32_t x1, int32_t x2, int32_t y, uint32_t value)
+{
+    tRectangle rect = {x1, y, x2, y};
+
+    draw_list_add(display_data, &rect, value);
+}
+//-----------------------------------------------------------------------------
+void draw_list_line_draw_v(void* display_data, int32_t x, int32_t y1, int32_t y2, uint32_t value)
+{
+    tRectangle rect = {x, y1, x, y2};
+
+    draw_list_add(display_data, &rect, value);
+}
+//-----------------------------------------------------------------------------
+void draw_list_rect_fill(void* display_data, const tRectangle* rect, uint32_t value)
+{
+    draw_list_add(display_data, rect, value);
+}
+//-----------------------------------------------------------------------------
+uint32_t draw_list_color_translate(void* display_data, uint32_t value)
+{
+    DrawList* list = display_data;
+
+    return list->display->pfnColorTranslate(list->display->pvDisplayData, value);
+}
+//-----------------------------------------------------------------------------
+void draw_list_flush(void* display_data)
+{
+    DrawList* list = display_data;
+
+    draw_list_submit(list);
+    list->display->pfnFlush(list->display->pvDisplayData);
+    list->frames++;
+#if defined(DRAW_LIST_STATS) && defined(__arm__)
+    if (list->frames % DRAW_LIST_REPORT_FRAMES == 0)
+    {
+        draw_list_report();
+    }
+#endif
+}
+//-----------------------------------------------------------------------------
+// Same size as the display it draws to, set by draw_list_init
+tDisplay draw_list_display =
+{
+    sizeof(tDisplay),
+    &draw_list,
+    0,
+    0,
+    draw_list_pixel_draw,
+    draw_list_pixel_draw_multiple,
+    draw_list_line_draw_h,
+    draw_list_line_draw_v,
+    draw_list_rect_fill,
+    draw_list_color_translate,
+    draw_list_flush
+};
+//-----------------------------------------------------------------------------
+void draw_list_init(const tDisplay* display)
+{
+    draw_list.display = display;
+    draw_list.count = 0;
+    draw_list_display.ui16Width = display->ui16Width;
+    draw_list_display.ui16Height = display->ui16Height;
+#if defined(DRAW_LIST_STATS) && !defined(__arm__)
+    atexit(draw_list_report);
+#endif
+}
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,588 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <string.h>
+
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ssi.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/ssi.h"
+#include "driverlib/udma.h"
+#include "grlib/grlib.h"
+#include "drivers/CF128x128x16_ST7735S.h"
+#include "dma.h"
+
+//-----------------------------------------------------------------------------
+// Off-screen framebuffer for the 128x128 ST7735S LCD, sent to it with uDMA
+//
+// framebuffer_display is a grlib display driver like g_sCF128x128x16_ST7735S,
+// but drawing only writes to a copy of the screen in RAM and remembers which
+// ranges of every row (scanline) changed. GrFlush sends the changed ranges to
+// the panel: ranges in consecutive rows are grouped into windows (one CASET,
+// RASET and RAMWR each) and the pixels of every row go out over SSI2 by uDMA.
+// The SSI interrupt starts the next row or window when one is done, so the
+// CPU can go on with the game while the frame is sent. Drawing waits for the
+// last flush to finish before it touches the RAM copy (framebuffer_wait).
+//
+// The copy holds 4 bit palette indices, 8 KB instead of 32 KB for RGB565.
+// Colors get a palette entry the first time they are used (the translated
+// color of grlib is the index), once all 16 are taken the closest one is used.
+// The rows are turned into RGB565 only when they are sent, into one of two
+// line buffers: the next rows are expanded into one while the uDMA sends the
+// other.
+//
+// Use after CF128x128x16_ST7735SInit (which sets up SSI2 and the pins):
+//   framebuffer_init();
+//   GrContextInit(&context, &framebuffer_display);
+// and framebuffer_clear instead of CF128x128x16_ST7735SClear. Nothing is on
+// the screen before GrFlush.
+//-----------------------------------------------------------------------------
+#define FRAMEBUFFER_WIDTH       LCD_HORIZONTAL_MAX
+#define FRAMEBUFFER_HEIGHT      LCD_VERTICAL_MAX
+// LCD of the Educational BoosterPack MKII on BoosterPack 1 of the EK-TM4C1294XL:
+// SPI on SSI2, LCD RS (DC) on J4.31 = PL3 and LCD CS on J2.13 = PN2, the same
+// header as the S2 button (J4.32 = PL2) and the joystick (J1.2 = PE4, AIN9)
+#define FRAMEBUFFER_SSI_BASE    SSI2_BASE
+#define FRAMEBUFFER_DC_BASE     GPIO_PORTL_BASE
+#define FRAMEBUFFER_DC_PIN      GPIO_PIN_3
+#define FRAMEBUFFER_CS_BASE     GPIO_PORTN_BASE
+#define FRAMEBUFFER_CS_PIN      GPIO_PIN_2
+// The 128x128 glass starts at column 2, row 3 of the controller RAM (132x162)
+// in the default orientation, TI's driver for this panel adds the same offsets
+#define FRAMEBUFFER_X_OFFSET    2
+#define FRAMEBUFFER_Y_OFFSET    3
+#define FRAMEBUFFER_DMA_CHANNEL 13
+// ST7735S commands
+#define FRAMEBUFFER_CASET       0x2A
+#define FRAMEBUFFER_RASET       0x2B
+#define FRAMEBUFFER_RAMWR       0x2C
+// Bytes to set a window, about as much as 6 pixels
+#define FRAMEBUFFER_WINDOW_PIXELS 6
+// Max bytes of one DMA transfer (1024 items of 1 byte), the size of a line buffer
+#define FRAMEBUFFER_DMA_MAX     1024
+#define FRAMEBUFFER_COLORS      16
+// Changed ranges kept per row, more are merged with the closest one
+#define FRAMEBUFFER_SPANS       4
+// Max windows per flush, the rest are merged into the last one
+#define FRAMEBUFFER_MAX_RUNS    128
+
+// Columns x_min to x_max of a row
+typedef struct
+{
+    int16_t x_min;
+    int16_t x_max;
+} FramebufferSpan;
+
+// Rows y_min to y_max that are sent with one window, columns x_min to x_max
+typedef struct
+{
+    int16_t y_min;
+    int16_t y_max;
+    int16_t x_min;
+    int16_t x_max;
+} FramebufferRun;
+
+// Palette indices, 2 pixels per byte, the even one in the high nibble like 4 bpp images in grlib
+uint8_t framebuffer[FRAMEBUFFER_HEIGHT][FRAMEBUFFER_WIDTH / 2];
+// Colors of the indices as RGB565 with the bytes swapped, so that sending them
+// as bytes puts the high byte first like the panel wants
+uint16_t framebuffer_palette[FRAMEBUFFER_COLORS];
+uint8_t framebuffer_palette_count;
+// Rows expanded to RGB565 for the uDMA, one is sent while the other is filled
+uint16_t framebuffer_lines[2][FRAMEBUFFER_DMA_MAX / 2];
+uint8_t framebuffer_line;
+// Changed ranges of every row since the last flush, they don't overlap or touch
+FramebufferSpan framebuffer_dirty[FRAMEBUFFER_HEIGHT][FRAMEBUFFER_SPANS];
+uint8_t framebuffer_dirty_count[FRAMEBUFFER_HEIGHT];
+// Flush in progress: the windows, and the window and row to expand next
+FramebufferRun framebuffer_runs[FRAMEBUFFER_MAX_RUNS];
+uint16_t framebuffer_run_count;
+uint16_t framebuffer_run;
+int16_t framebuffer_row;
+// Expanded and waiting in framebuffer_lines[framebuffer_line]: its size (0
+// when everything has been sent) and the window it starts, or -1 if it
+// continues the last one
+uint32_t framebuffer_ready_bytes;
+int16_t framebuffer_ready_window;
+volatile bool framebuffer_busy;
+
+//-----------------------------------------------------------------------------
+// Wait until the last flush has been sent
+void framebuffer_wait(void)
+{
+    while (framebuffer_busy)
+    {
+    }
+}
+//-----------------------------------------------------------------------------
+// Columns x1 to x2 of row y have changed
+void framebuffer_mark(int32_t x1, int32_t x2, int32_t y)
+{
+    FramebufferSpan* spans = framebuffer_dirty[y];
+    uint8_t count = framebuffer_dirty_count[y];
+    uint8_t closest;
+    int32_t gap;
+    int32_t closest_gap;
+    uint8_t i;
+
+    while (1)
+    {
+        // Ranges that overlap or touch the new one become part of it
+        for (i = 0; i < count; )
+        {
+            if (spans[i].x_min <= x2 + 1 && spans[i].x_max >= x1 - 1)
+            {
+                x1 = (spans[i].x_min < x1) ? spans[i].x_min : x1;
+                x2 = (spans[i].x_max > x2) ? spans[i].x_max : x2;
+                spans[i] = spans[--count];
+            }
+            else
+            {
+                i++;
+            }
+        }
+        if (count < FRAMEBUFFER_SPANS)
+        {
+            break;
+        }
+        // No room, take in the closest range and check the others again
+        closest = 0;
+        closest_gap = FRAMEBUFFER_WIDTH;
+        for (i = 0; i < count; i++)
+        {
+            gap = (spans[i].x_min > x2) ? spans[i].x_min - x2 : x1 - spans[i].x_max;
+            if (gap < closest_gap)
+            {
+                closest = i;
+                closest_gap = gap;
+            }
+        }
+        x1 = (spans[closest].x_min < x1) ? spans[closest].x_min : x1;
+        x2 = (spans[closest].x_max > x2) ? spans[closest].x_max : x2;
+    }
+    spans[count].x_min = x1;
+    spans[count].x_max = x2;
+    framebuffer_dirty_count[y] = count + 1;
+}
+//-----------------------------------------------------------------------------
+// 24-bit RGB to the palette index of its RGB565 color
+uint32_t framebuffer_color_translate(void* display_data, uint32_t value)
+{
+    uint32_t color = ((value >> 8) & 0xF800) | ((value >> 5) & 0x07E0) | ((value >> 3) & 0x001F);
+    uint32_t entry;
+    int32_t red;
+    int32_t green;
+    int32_t blue;
+    int32_t distance;
+    int32_t closest_distance = 0x7FFFFFFF;
+    uint8_t closest = 0;
+    uint8_t i;
+
+    (void)display_data;
+    color = ((color >> 8) | (color << 8)) & 0xFFFF;
+    for (i = 0; i < framebuffer_palette_count; i++)
+    {
+        if (framebuffer_palette[i] == color)
+        {
+            return i;
+        }
+    }
+    if (framebuffer_palette_count < FRAMEBUFFER_COLORS)
+    {
+        framebuffer_palette[framebuffer_palette_count] = color;
+        return framebuffer_palette_count++;
+    }
+    // Palette full, closest color by the 5/6/5 bit components
+    for (i = 0; i < FRAMEBUFFER_COLORS; i++)
+    {
+        entry = framebuffer_palette[i];
+        red = (int32_t)((entry >> 3) & 0x1F) - (int32_t)((color >> 3) & 0x1F);
+        green = (int32_t)(((entry << 3) & 0x38) | (entry >> 13)) - (int32_t)(((color << 3) & 0x38) | (color >> 13));
+        blue = (int32_t)((entry >> 8) & 0x1F) - (int32_t)((color >> 8) & 0x1F);
+        distance = red * red + green * green + blue * blue;
+        if (distance < closest_distance)
+        {
+            closest = i;
+            closest_distance = distance;
+        }
+    }
+    return closest;
+}
+//-----------------------------------------------------------------------------
+void framebuffer_pixel_set(int32_t x, int32_t y, uint32_t index)
+{
+    uint8_t* pair = &framebuffer[y][x / 2];
+
+    if (x & 1)
+    {
+        *pair = (*pair & 0xF0) | index;
+    }
+    else
+    {
+        *pair = (*pair & 0x0F) | (index << 4);
+    }
+}
+//-----------------------------------------------------------------------------
+// Pixels x1 to x2 of row y, whole bytes in the middle
+void framebuffer_span_fill(int32_t x1, int32_t x2, int32_t y, uint32_t index)
+{
+    if (x1 & 1)
+    {
+        framebuffer_pixel_set(x1++, y, index);
+    }
+    if (!(x2 & 1))
+    {
+        framebuffer_pixel_set(x2--, y, index);
+    }
+    if (x1 < x2)
+    {
+        memset(&framebuffer[y][x1 / 2], (index << 4) | index, (x2 - x1 + 1) / 2);
+    }
+}
+//-----------------------------------------------------------------------------
+// grlib clips everything to the screen before calling the driver functions
+void framebuffer_pixel_draw(void* display_data, int32_t x, int32_t y, uint32_t value)
+{
+    (void)display_data;
+    framebuffer_wait();
+    framebuffer_pixel_set(x, y, value);
+    framebuffer_mark(x, x, y);
+}
+//-----------------------------------------------------------------------------
+// Row of count pixels from x, y, 1, 4 or 8 bits per pixel like the LCD driver
+void framebuffer_pixel_draw_multiple(void* display_data, int32_t x, int32_t y, int32_t x0, int32_t count,
+                                     int32_t bpp, const uint8_t* data, const uint8_t* palette)
+{
+    const uint32_t* colors = (const uint32_t*)palette;
+    const uint8_t* entry;
+    uint32_t index;
+    int32_t i;
+
+    framebuffer_wait();
+    for (i = 0; i < count; i++)
+    {
+        // 1 bpp: the palette is 2 translated colors
+        if (bpp == 1)
+        {
+            index = (data[(x0 + i) / 8] >> (7 - (x0 + i) % 8)) & 1;
+            framebuffer_pixel_set(x + i, y, colors[index]);
+            continue;
+        }
+        // 4 and 8 bpp: the palette is 24-bit RGB, 3 bytes per entry
+        if (bpp == 4)
+        {
+            index = (data[(x0 + i) / 2] >> (((x0 + i) & 1) ? 0 : 4)) & 0xF;
+        }
+        else
+        {
+            index = data[i];
+        }
+        entry = &palette[index * 3];
+        framebuffer_pixel_set(x + i, y, framebuffer_color_translate(display_data, ((uint32_t)entry[2] << 16) |
+                                                                    ((uint32_t)entry[1] << 8) | entry[0]));
+    }
+    framebuffer_mark(x, x + count - 1, y);
+}
+//-----------------------------------------------------------------------------
+void framebuffer_line_draw_h(void* display_data, int32_t x1, int32_t x2, int32_t y, uint32_t value)
+{
+    (void)display_data;
+    framebuffer_wait();
+    framebuffer_span_fill(x1, x2, y, value);
+    framebuffer_mark(x1, x2, y);
+}
+//-----------------------------------------------------------------------------
+void framebuffer_line_draw_v(void* display_data, int32_t x, int32_t y1, int32_t y2, uint32_t value)
+{
+    int32_t y;
+
+    (void)display_data;
+    framebuffer_wait();
+    for (y = y1; y <= y2; y++)
+    {
+        framebuffer_pixel_set(x, y, value);
+        framebuffer_mark(x, x, y);
+    }
+}
+//-----------------------------------------------------------------------------
+void framebuffer_rect_fill(void* display_data, const tRectangle* rect, uint32_t value)
+{
+    int32_t y;
+
+    (void)display_data;
+    framebuffer_wait();
+    for (y = rect->i16YMin; y <= rect->i16YMax; y++)
+    {
+        framebuffer_span_fill(rect->i16XMin, rect->i16XMax, y, value);
+        framebuffer_mark(rect->i16XMin, rect->i16XMax, y);
+    }
+}
+//-----------------------------------------------------------------------------
+// Command byte with DC low, then its data bytes with DC high
+// The bytes before it have to be out of the SSI before DC changes
+void framebuffer_command(uint8_t command, const uint8_t* data, uint16_t count)
+{
+    uint16_t i;
+
+    while (SSIBusy(FRAMEBUFFER_SSI_BASE))
+    {
+    }
+    GPIOPinWrite(FRAMEBUFFER_DC_BASE, FRAMEBUFFER_DC_PIN, 0);
+    SSIDataPut(FRAMEBUFFER_SSI_BASE, command);
+    while (SSIBusy(FRAMEBUFFER_SSI_BASE))
+    {
+    }
+    GPIOPinWrite(FRAMEBUFFER_DC_BASE, FRAMEBUFFER_DC_PIN, FRAMEBUFFER_DC_PIN);
+    for (i = 0; i < count; i++)
+    {
+        SSIDataPut(FRAMEBUFFER_SSI_BASE, data[i]);
+    }
+}
+//-----------------------------------------------------------------------------
+// Set the window of a run and start writing to it, pixel data follows with DC high
+void framebuffer_window(const FramebufferRun* run)
+{
+    uint8_t columns[4] = {0, (uint8_t)(run->x_min + FRAMEBUFFER_X_OFFSET), 0, (uint8_t)(run->x_max + FRAMEBUFFER_X_OFFSET)};
+    uint8_t rows[4] = {0, (uint8_t)(run->y_min + FRAMEBUFFER_Y_OFFSET), 0, (uint8_t)(run->y_max + FRAMEBUFFER_Y_OFFSET)};
+
+    framebuffer_command(FRAMEBUFFER_CASET, columns, 4);
+    framebuffer_command(FRAMEBUFFER_RASET, rows, 4);
+    framebuffer_command(FRAMEBUFFER_RAMWR, 0, 0);
+}
+//-----------------------------------------------------------------------------
+// Pixels x_min to x_max of row y as RGB565, to out
+void framebuffer_expand(uint16_t* out, int16_t x_min, int16_t x_max, int16_t y)
+{
+    const uint8_t* pair = &framebuffer[y][x_min / 2];
+    int16_t x = x_min;
+
+    if (x & 1)
+    {
+        *out++ = framebuffer_palette[*pair++ & 0xF];
+        x++;
+    }
+    for (; x < x_max; x += 2)
+    {
+        *out++ = framebuffer_palette[*pair >> 4];
+        *out++ = framebuffer_palette[*pair++ & 0xF];
+    }
+    if (x == x_max)
+    {
+        *out = framebuffer_palette[*pair >> 4];
+    }
+}
+//-----------------------------------------------------------------------------
+// Expand the next row of the flush into the free line buffer, or the next
+// rows if the window is full width (they follow each other on the panel)
+void framebuffer_prepare(void)
+{
+    const FramebufferRun* run = &framebuffer_runs[framebuffer_run];
+    uint16_t* out = framebuffer_lines[framebuffer_line];
+    int16_t width;
+    int16_t rows = 1;
+    int16_t i;
+
+    if (framebuffer_row > run->y_max)
+    {
+        if (framebuffer_run + 1 >= framebuffer_run_count)
+        {
+            framebuffer_ready_bytes = 0;
+            return;
+        }
+        framebuffer_run++;
+        run++;
+        framebuffer_row = run->y_min;
+    }
+    framebuffer_ready_window = (framebuffer_row == run->y_min) ? (int16_t)framebuffer_run : -1;
+
+    width = run->x_max - run->x_min + 1;
+    if (width == FRAMEBUFFER_WIDTH)
+    {
+        rows = FRAMEBUFFER_DMA_MAX / (FRAMEBUFFER_WIDTH * 2);
+        if (rows > run->y_max - framebuffer_row + 1)
+        {
+            rows = run->y_max - framebuffer_row + 1;
+        }
+    }
+    for (i = 0; i < rows; i++)
+    {
+        framebuffer_expand(out, run->x_min, run->x_max, framebuffer_row++);
+        out += width;
+    }
+    framebuffer_ready_bytes = width * rows * 2;
+}
+//-----------------------------------------------------------------------------
+// Start the DMA of the expanded rows, then expand the ones after them into the other buffer
+void framebuffer_send(void)
+{
+    if (framebuffer_ready_window >= 0)
+    {
+        framebuffer_window(&framebuffer_runs[framebuffer_ready_window]);
+    }
+    uDMAChannelTransferSet(FRAMEBUFFER_DMA_CHANNEL | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+                           framebuffer_lines[framebuffer_line], (void*)(FRAMEBUFFER_SSI_BASE + SSI_O_DR),
+                           framebuffer_ready_bytes);
+    uDMAChannelEnable(FRAMEBUFFER_DMA_CHANNEL);
+    framebuffer_line ^= 1;
+    framebuffer_prepare();
+}
+//-----------------------------------------------------------------------------
+// SSI2 interrupt, the DMA of a line buffer is done
+void framebuffer_ssi_interrupt(void)
+{
+    SSIIntClear(FRAMEBUFFER_SSI_BASE, SSI_DMATX);
+    if (!framebuffer_busy || uDMAChannelIsEnabled(FRAMEBUFFER_DMA_CHANNEL))
+    {
+        return;
+    }
+    if (framebuffer_ready_bytes > 0)
+    {
+        framebuffer_send();
+        return;
+    }
+    // All sent
+    while (SSIBusy(FRAMEBUFFER_SSI_BASE))
+    {
+    }
+    GPIOPinWrite(FRAMEBUFFER_CS_BASE, FRAMEBUFFER_CS_PIN, FRAMEBUFFER_CS_PIN);
+    framebuffer_busy = false;
+}
+//-----------------------------------------------------------------------------
+// Group the changed ranges into windows and start sending them
+// A range joins an overlapping window that ends on the row above if sending the
+// pixels in between (the window gets as wide as both) costs less than a new window
+void framebuffer_flush(void)
+{
+    FramebufferRun* run;
+    FramebufferSpan* span;
+    // Windows that end on the row above, and on this row
+    uint16_t open[FRAMEBUFFER_SPANS];
+    uint16_t next[FRAMEBUFFER_SPANS];
+    uint8_t open_count = 0;
+    uint8_t next_count;
+    int32_t joined;
+    int32_t split;
+    int16_t x_min;
+    int16_t x_max;
+    int16_t y;
+    uint8_t i;
+    uint8_t j;
+
+    framebuffer_wait();
+    framebuffer_run_count = 0;
+    for (y = 0; y < FRAMEBUFFER_HEIGHT; y++)
+    {
+        next_count = 0;
+        for (i = 0; i < framebuffer_dirty_count[y]; i++)
+        {
+            span = &framebuffer_dirty[y][i];
+            run = 0;
+            for (j = 0; j < open_count; j++)
+            {
+                run = &framebuffer_runs[open[j]];
+                if (run->y_max == y - 1 && run->x_min <= span->x_max && run->x_max >= span->x_min)
+                {
+                    x_min = (span->x_min < run->x_min) ? span->x_min : run->x_min;
+                    x_max = (span->x_max > run->x_max) ? span->x_max : run->x_max;
+                    joined = (x_max - x_min + 1) * (y - run->y_min + 1);
+                    split = (run->x_max - run->x_min + 1) * (y - run->y_min) +
+                            (span->x_max - span->x_min + 1) + FRAMEBUFFER_WINDOW_PIXELS;
+                    if (joined <= split)
+                    {
+                        break;
+                    }
+                }
+                run = 0;
+            }
+            if (run == 0 && framebuffer_run_count < FRAMEBUFFER_MAX_RUNS)
+            {
+                run = &framebuffer_runs[framebuffer_run_count++];
+                run->y_min = y;
+                run->x_min = span->x_min;
+                run->x_max = span->x_max;
+            }
+            // Out of windows, the last one grows over the rest (covering more is never wrong)
+            else if (run == 0)
+            {
+                run = &framebuffer_runs[framebuffer_run_count - 1];
+            }
+            run->x_min = (span->x_min < run->x_min) ? span->x_min : run->x_min;
+            run->x_max = (span->x_max > run->x_max) ? span->x_max : run->x_max;
+            run->y_max = y;
+            if (next_count < FRAMEBUFFER_SPANS)
+            {
+                next[next_count++] = run - framebuffer_runs;
+            }
+        }
+        framebuffer_dirty_count[y] = 0;
+        for (i = 0; i < next_count; i++)
+        {
+            open[i] = next[i];
+        }
+        open_count = next_count;
+    }
+    if (framebuffer_run_count == 0)
+    {
+        return;
+    }
+
+    framebuffer_run = 0;
+    framebuffer_row = framebuffer_runs[0].y_min;
+    framebuffer_prepare();
+    framebuffer_busy = true;
+    GPIOPinWrite(FRAMEBUFFER_CS_BASE, FRAMEBUFFER_CS_PIN, 0);
+    // The interrupt uses the second line buffer, it has to wait until it is expanded
+    IntDisable(INT_SSI2);
+    framebuffer_send();
+    IntEnable(INT_SSI2);
+}
+//-----------------------------------------------------------------------------
+void framebuffer_flush_display(void* display_data)
+{
+    (void)display_data;
+    framebuffer_flush();
+}
+//-----------------------------------------------------------------------------
+// Fill the whole screen with a 24-bit RGB color
+void framebuffer_clear(uint32_t color)
+{
+    tRectangle screen = {0, 0, FRAMEBUFFER_WIDTH - 1, FRAMEBUFFER_HEIGHT - 1};
+
+    framebuffer_rect_fill(0, &screen, framebuffer_color_translate(0, color));
+}
+//-----------------------------------------------------------------------------
+const tDisplay framebuffer_display =
+{
+    sizeof(tDisplay),
+    framebuffer,
+    FRAMEBUFFER_WIDTH,
+    FRAMEBUFFER_HEIGHT,
+    framebuffer_pixel_draw,
+    framebuffer_pixel_draw_multiple,
+    framebuffer_line_draw_h,
+    framebuffer_line_draw_v,
+    framebuffer_rect_fill,
+    framebuffer_color_translate,
+    framebuffer_flush_display
+};
+//-----------------------------------------------------------------------------
+// SSI2 sends every byte the uDMA gives it, the interrupt comes when a transfer is done
+void framebuffer_init(void)
+{
+    dma_init();
+    uDMAChannelAssign(UDMA_CH13_SSI2TX);
+    uDMAChannelAttributeDisable(FRAMEBUFFER_DMA_CHANNEL, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(FRAMEBUFFER_DMA_CHANNEL | UDMA_PRI_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4);
+    SSIIntRegister(FRAMEBUFFER_SSI_BASE, framebuffer_ssi_interrupt);
+    SSIIntEnable(FRAMEBUFFER_SSI_BASE, SSI_DMATX);
+    SSIDMAEnable(FRAMEBUFFER_SSI_BASE, SSI_DMA_TX);
+}
+//-----------------------------------------------------------------------------
+
+#endif
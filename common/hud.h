@@ -0,0 +1,283 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "grlib/grlib.h"
+
+//-----------------------------------------------------------------------------
+// Numbers on the screen in fixed width, right aligned fields
+//
+// hud_init draws the digits (and ' ', '-') of a font once with grlib into a
+// small cache of 1 bit glyphs. A HudField remembers which glyph is in each of
+// its cells, hud_field_set turns the new value into glyphs (two digits per
+// division, filled in from the right so nothing has to be reversed) and only
+// sends the cells from the first to the last one that changed, one
+// PixelDrawMultiple per row, in the foreground and background colors of the
+// context. Nothing is measured or drawn blank first like with
+// GrStringDrawCentered.
+//
+// A new field counts as blank, blank cells are only drawn to erase a digit
+// that was there. Call hud_field_clear to paint the whole field with the
+// background, and hud_field_invalidate when the screen under it was cleared.
+// Fields have to be inside the screen, they are not clipped. A value that
+// does not fit is shown as the largest (or smallest) one that does, 9999 or
+// -999 in a field of 4, so a number that is too big never looks like a
+// smaller one.
+//-----------------------------------------------------------------------------
+// Max cells of a field
+#define HUD_FIELD_MAX   8
+// Max size of a glyph, the cache is one byte per row
+#define HUD_GLYPH_WIDTH 8
+#define HUD_GLYPH_ROWS  8
+// Glyphs after the 10 digits
+#define HUD_BLANK       10
+#define HUD_MINUS       11
+#define HUD_GLYPHS      12
+
+typedef struct
+{
+    // Upper left corner
+    int16_t x;
+    int16_t y;
+    uint8_t width;
+    // Largest value that fits, -(max / 10) is the smallest
+    int32_t max;
+    // Glyph on the screen in every cell
+    uint8_t shown[HUD_FIELD_MAX];
+} HudField;
+
+// Rows of every glyph, bits MSB first (the 1 bpp format of PixelDrawMultiple)
+uint8_t hud_glyphs[HUD_GLYPHS][HUD_GLYPH_ROWS];
+uint8_t hud_glyph_width;
+uint8_t hud_glyph_height;
+// Two digits per entry, "00" to "99"
+const char hud_pairs[200] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+// Glyph being drawn by grlib in hud_init
+uint8_t* hud_capture;
+
+//-----------------------------------------------------------------------------
+// Display that grlib draws the glyphs on, anything not black is a set bit
+void hud_capture_pixel_draw(void* display_data, int32_t x, int32_t y, uint32_t value)
+{
+    (void)display_data;
+    if (value)
+    {
+        hud_capture[y] |= 0x80 >> x;
+    }
+}
+//-----------------------------------------------------------------------------
+void hud_capture_pixel_draw_multiple(void* display_data, int32_t x, int32_t y, int32_t x0, int32_t count,
+                                     int32_t bpp, const uint8_t* data, const uint8_t* palette)
+{
+    const uint32_t* colors = (const uint32_t*)palette;
+    int32_t i;
+
+    // Fonts are 1 bpp, the palette is 2 translated colors
+    for (i = 0; bpp == 1 && i < count; i++)
+    {
+        hud_capture_pixel_draw(display_data, x + i, y, colors[(data[(x0 + i) / 8] >> (7 - (x0 + i) % 8)) & 1]);
+    }
+}
+//-----------------------------------------------------------------------------
+void hud_capture_line_draw_h(void* display_data, int32_t x1, int32_t x2, int32_t y, uint32_t value)
+{
+    for (; x1 <= x2; x1++)
+    {
+        hud_capture_pixel_draw(display_data, x1, y, value);
+    }
+}
+//-----------------------------------------------------------------------------
+void hud_capture_line_draw_v(void* display_data, int32_t x, int32_t y1, int32_t y2, uint32_t value)
+{
+    for (; y1 <= y2; y1++)
+    {
+        hud_capture_pixel_draw(display_data, x, y1, value);
+    }
+}
+//-----------------------------------------------------------------------------
+void hud_capture_rect_fill(void* display_data, const tRectangle* rect, uint32_t value)
+{
+    int32_t y;
+
+    for (y = rect->i16YMin; y <= rect->i16YMax; y++)
+    {
+        hud_capture_line_draw_h(display_data, rect->i16XMin, rect->i16XMax, y, value);
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t hud_capture_color_translate(void* display_data, uint32_t value)
+{
+    (void)display_data;
+    return value != ClrBlack;
+}
+//-----------------------------------------------------------------------------
+void hud_capture_flush(void* display_data)
+{
+    (void)display_data;
+}
+//-----------------------------------------------------------------------------
+const tDisplay hud_capture_display =
+{
+    sizeof(tDisplay),
+    0,
+    HUD_GLYPH_WIDTH,
+    HUD_GLYPH_ROWS,
+    hud_capture_pixel_draw,
+    hud_capture_pixel_draw_multiple,
+    hud_capture_line_draw_h,
+    hud_capture_line_draw_v,
+    hud_capture_rect_fill,
+    hud_capture_color_translate,
+    hud_capture_flush
+};
+//-----------------------------------------------------------------------------
+// Draw the glyphs of font into the cache, once before the fields are used
+// The font has to fit in HUD_GLYPH_WIDTH x HUD_GLYPH_ROWS (g_sFontFixed6x8 does)
+void hud_init(const tFont* font)
+{
+    const char* characters = "0123456789 -";
+    tContext capture;
+    uint8_t i;
+
+    GrContextInit(&capture, &hud_capture_display);
+    GrContextFontSet(&capture, font);
+    GrContextForegroundSet(&capture, ClrWhite);
+    GrContextBackgroundSet(&capture, ClrBlack);
+    memset(hud_glyphs, 0, sizeof(hud_glyphs));
+    for (i = 0; i < HUD_GLYPHS; i++)
+    {
+        hud_capture = hud_glyphs[i];
+        GrStringDraw(&capture, &characters[i], 1, 0, 0, true);
+    }
+    hud_glyph_width = GrStringWidthGet(&capture, "0", 1);
+    hud_glyph_height = font->ui8Height;
+}
+//-----------------------------------------------------------------------------
+// Field of width cells (up to HUD_FIELD_MAX) with its upper left corner at x, y
+void hud_field_init(HudField* field, int16_t x, int16_t y, uint8_t width)
+{
+    field->x = x;
+    field->y = y;
+    field->width = width;
+    field->max = 9;
+    while (--width > 0)
+    {
+        field->max = field->max * 10 + 9;
+    }
+    memset(field->shown, HUD_BLANK, sizeof(field->shown));
+}
+//-----------------------------------------------------------------------------
+// The screen under the field has been cleared, nothing to erase there
+void hud_field_invalidate(HudField* field)
+{
+    memset(field->shown, HUD_BLANK, sizeof(field->shown));
+}
+//-----------------------------------------------------------------------------
+// Draw cells first to last with the glyphs in cells
+void hud_field_draw(const HudField* field, const tContext* context, const uint8_t* cells, uint8_t first, uint8_t last)
+{
+    const tDisplay* display = context->psDisplay;
+    uint32_t palette[2] = {context->ui32Background, context->ui32Foreground};
+    uint8_t row[(HUD_FIELD_MAX * HUD_GLYPH_WIDTH + 7) / 8];
+    uint32_t bits;
+    uint8_t count;
+    uint8_t y;
+    uint8_t i;
+
+    for (y = 0; y < hud_glyph_height; y++)
+    {
+        // Glyph rows side by side, MSB first
+        memset(row, 0, sizeof(row));
+        count = 0;
+        for (i = first; i <= last; i++)
+        {
+            bits = (uint32_t)hud_glyphs[cells[i]][y] << (24 - count % 8);
+            row[count / 8] |= bits >> 24;
+            if (count / 8 + 1 < (uint8_t)sizeof(row))
+            {
+                row[count / 8 + 1] |= bits >> 16;
+            }
+            count += hud_glyph_width;
+        }
+        display->pfnPixelDrawMultiple(display->pvDisplayData, field->x + first * hud_glyph_width, field->y + y,
+                                      0, count, 1, row, (const uint8_t*)palette);
+    }
+}
+//-----------------------------------------------------------------------------
+// Show value, the largest or smallest one that fits if it does not
+void hud_field_set(HudField* field, const tContext* context, int32_t value)
+{
+    uint8_t cells[HUD_FIELD_MAX];
+    uint32_t number;
+    const char* pair;
+    int8_t i = field->width;
+    int8_t first;
+    int8_t last;
+
+    if (value > field->max)
+    {
+        value = field->max;
+    }
+    else if (value < -(field->max / 10))
+    {
+        value = -(field->max / 10);
+    }
+    number = (value < 0) ? -(uint32_t)value : (uint32_t)value;
+
+    // Two digits at a time from the right
+    while (number >= 100 && i >= 2)
+    {
+        pair = &hud_pairs[(number % 100) * 2];
+        number /= 100;
+        cells[--i] = pair[1] - '0';
+        cells[--i] = pair[0] - '0';
+    }
+    if (number >= 10 && i >= 2)
+    {
+        cells[--i] = hud_pairs[number * 2 + 1] - '0';
+        cells[--i] = hud_pairs[number * 2] - '0';
+    }
+    else if (i >= 1)
+    {
+        cells[--i] = number % 10;
+    }
+    if (value < 0 && i >= 1)
+    {
+        cells[--i] = HUD_MINUS;
+    }
+    while (i > 0)
+    {
+        cells[--i] = HUD_BLANK;
+    }
+
+    for (first = 0; first < field->width && cells[first] == field->shown[first]; first++)
+    {
+    }
+    if (first == field->width)
+    {
+        return;
+    }
+    for (last = field->width - 1; cells[last] == field->shown[last]; last--)
+    {
+    }
+    hud_field_draw(field, context, cells, first, last);
+    memcpy(&field->shown[first], &cells[first], last - first + 1);
+}
+//-----------------------------------------------------------------------------
+// Paint the whole field with the background color of the context
+void hud_field_clear(HudField* field, const tContext* context)
+{
+    memset(field->shown, HUD_BLANK, field->width);
+    hud_field_draw(field, context, field->shown, 0, field->width - 1);
+}
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Fixed size pool allocator, capacity fixed at compile time
+//
+// POOL(name, type, size) declares a struct called name with room for size
+// elements of type, together with name_alloc, name_free and name_reset.
+// A pool declared as a global (or static) needs no initialization, all zero
+// is an empty pool.
+//
+// Free elements are kept in a singly linked free list that is stored inside
+// the free elements themselves, so alloc and free are O(1) and there is no
+// per element overhead. Elements that have never been handed out are taken
+// from the end of the used part (used), which is what makes name_reset O(1):
+// it forgets the free list and sets used back to 0, releasing everything that
+// was allocated from the pool in one operation.
+//-----------------------------------------------------------------------------
+#define POOL(name, type, size)                                                  \
+typedef union name##_slot                                                       \
+{                                                                               \
+    type item;                                                                  \
+    union name##_slot* next_free;                                               \
+} name##_slot;                                                                  \
+                                                                                \
+typedef struct                                                                  \
+{                                                                               \
+    name##_slot slots[size];                                                    \
+    name##_slot* free_list;                                                     \
+    uint32_t used;                                                              \
+} name;                                                                         \
+                                                                                \
+/* Get a zeroed element (like calloc), returns NULL if the pool is empty */     \
+type* name##_alloc(name* pool)                                                  \
+{                                                                               \
+    name##_slot* slot;                                                          \
+    if (pool->free_list != NULL)                                                \
+    {                                                                           \
+        slot = pool->free_list;                                                 \
+        pool->free_list = slot->next_free;                                      \
+    }                                                                           \
+    else if (pool->used < (size))                                               \
+    {                                                                           \
+        slot = &pool->slots[pool->used++];                                      \
+    }                                                                           \
+    else                                                                        \
+    {                                                                           \
+        return NULL;                                                            \
+    }                                                                           \
+    memset(&slot->item, 0, sizeof(type));                                       \
+    return &slot->item;                                                         \
+}                                                                               \
+                                                                                \
+/* Give an element back to the pool */                                          \
+void name##_free(name* pool, type* item)                                        \
+{                                                                               \
+    name##_slot* slot = (name##_slot*)item;                                     \
+    slot->next_free = pool->free_list;                                          \
+    pool->free_list = slot;                                                     \
+}                                                                               \
+                                                                                \
+/* Release every element in the pool at once */                                 \
+void name##_reset(name* pool)                                                   \
+{                                                                               \
+    pool->free_list = NULL;                                                     \
+    pool->used = 0;                                                             \
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Section profiler, compiled out unless PROFILE is defined
+//
+// PROFILE_BEGIN(name) and PROFILE_END(name) around a piece of code (in the same
+// block) time it with the cycle counter in cycles.h and add the time to the
+// section called name. PROFILE_INIT(clock) once at start, PROFILE_FRAME() once
+// per pass of the main loop.
+//
+// The report is one line of JSON per section, printed with UARTprintf:
+//   {"section":"frame","count":1000,"cycles":5310,"ns":132,"min":4100,"max":9800}
+// cycles and ns are per call, the cost of the measurement itself (measured in
+// profile_init) is already subtracted. The target prints a report every
+// PROFILE_REPORT_FRAMES frames, the host build prints one when the program
+// exits (HOST_FRAMES, end of a replay), so two builds can be compared by
+// replaying the same input trace and diffing the output.
+//-----------------------------------------------------------------------------
+#ifdef PROFILE
+
+#include "cycles.h"
+
+#ifndef PROFILE_MAX_SECTIONS
+#define PROFILE_MAX_SECTIONS 16
+#endif
+#ifndef PROFILE_REPORT_FRAMES
+#define PROFILE_REPORT_FRAMES 1000
+#endif
+
+#define PROFILE_INIT(clock_hz)  profile_init(clock_hz)
+#define PROFILE_BEGIN(name)     uint32_t profile_start_##name = cycles_now()
+#define PROFILE_END(name)       profile_add(#name, cycles_now() - profile_start_##name)
+#define PROFILE_FRAME()         profile_frame()
+
+typedef struct
+{
+    const char* name;
+    uint32_t count;
+    uint64_t total;
+    uint32_t min;
+    uint32_t max;
+} ProfileSection;
+
+ProfileSection profile_sections[PROFILE_MAX_SECTIONS];
+uint16_t profile_section_count;
+uint32_t profile_frames;
+// Cycles of an empty BEGIN/END pair
+uint32_t profile_overhead;
+
+//-----------------------------------------------------------------------------
+// Add one measurement to section name, creates the section the first time
+void profile_add(const char* name, uint32_t count)
+{
+    ProfileSection* section;
+    uint16_t i;
+
+    for(i = 0; i < profile_section_count; i++)
+    {
+        // Usually the same string literal, strcmp only if it isn't
+        if(profile_sections[i].name == name || strcmp(profile_sections[i].name, name) == 0)
+        {
+            break;
+        }
+    }
+    if(i == profile_section_count)
+    {
+        if(i == PROFILE_MAX_SECTIONS)
+        {
+            return;
+        }
+        profile_sections[i].name = name;
+        profile_sections[i].min = 0xFFFFFFFF;
+        profile_section_count++;
+    }
+    section = &profile_sections[i];
+
+    count = (count > profile_overhead) ? count - profile_overhead : 0;
+    section->count++;
+    section->total += count;
+    if(count < section->min)
+        section->min = count;
+    if(count > section->max)
+        section->max = count;
+}
+//-----------------------------------------------------------------------------
+// Print every section as one line of JSON
+void profile_report(void)
+{
+    ProfileSection* section;
+    uint32_t average;
+    uint16_t i;
+
+    for(i = 0; i < profile_section_count; i++)
+    {
+        section = &profile_sections[i];
+        average = (uint32_t)(section->total / section->count);
+        UARTprintf("{\"section\":\"%s\",\"count\":%u,\"cycles\":%u,\"ns\":%u,\"min\":%u,\"max\":%u}\n",
+                   section->name, section->count, average, cycles_to_ns(average), section->min, section->max);
+    }
+}
+//-----------------------------------------------------------------------------
+void profile_frame(void)
+{
+    profile_frames++;
+#if defined(__arm__)
+    if(profile_frames % PROFILE_REPORT_FRAMES == 0)
+    {
+        profile_report();
+    }
+#endif
+}
+//-----------------------------------------------------------------------------
+void profile_init(uint32_t clock_hz)
+{
+    uint32_t start;
+    uint32_t count;
+    uint16_t i;
+
+    cycles_init(clock_hz);
+    // Smallest time of an empty measurement
+    profile_overhead = 0xFFFFFFFF;
+    for(i = 0; i < 100; i++)
+    {
+        start = cycles_now();
+        count = cycles_now() - start;
+        if(count < profile_overhead)
+            profile_overhead = count;
+    }
+#if !defined(__arm__)
+    atexit(profile_report);
+#endif
+}
+//-----------------------------------------------------------------------------
+
+#else
+
+#define PROFILE_INIT(clock_hz)
+#define PROFILE_BEGIN(name)
+#define PROFILE_END(name)
+#define PROFILE_FRAME()
+
+#endif
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef RECT_BATCH_H
+#define RECT_BATCH_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "grlib/grlib.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// Batch of equally sized rectangles stored as a structure of arrays
+//
+// Instead of one tRectangle (or x, y struct) per object, the upper left corners
+// are kept in separate x[] and y[] arrays and width/height are shared, this is
+// what lets rect_batch_overlap test several rectangles per instruction.
+// Works for anything that has many objects of the same size, like the bricks in
+// breakout or the asteroids in asteroids.
+//-----------------------------------------------------------------------------
+// Max number of rectangles in a batch, one bit each in the hit mask
+// Has to be a multiple of 8 (SSE2 version tests 8 at a time)
+#define RECT_BATCH_MAX 32
+
+typedef struct
+{
+    // i16XMin of every rectangle
+    int16_t x[RECT_BATCH_MAX];
+    // i16YMin of every rectangle
+    int16_t y[RECT_BATCH_MAX];
+    // i16XMax - i16XMin, same for every rectangle
+    int16_t width;
+    // i16YMax - i16YMin, same for every rectangle
+    int16_t height;
+    uint16_t count;
+} RectBatch;
+//-----------------------------------------------------------------------------
+// Empty the batch and set the size of the rectangles
+void rect_batch_init(RectBatch* batch, int16_t width, int16_t height)
+{
+    // Zero so that the unused slots read by the wide versions are defined
+    memset(batch, 0, sizeof(RectBatch));
+    batch->width = width;
+    batch->height = height;
+}
+//-----------------------------------------------------------------------------
+// Add a rectangle with upper left corner x, y
+// Returns its index, or -1 if the batch is full
+int16_t rect_batch_add(RectBatch* batch, int16_t x, int16_t y)
+{
+    if (batch->count >= RECT_BATCH_MAX)
+    {
+        return -1;
+    }
+    batch->x[batch->count] = x;
+    batch->y[batch->count] = y;
+    return batch->count++;
+}
+//-----------------------------------------------------------------------------
+// Get rectangle i as a tRectangle (for drawing)
+void rect_batch_get(RectBatch* batch, int16_t i, tRectangle* rect)
+{
+    rect->i16XMin = batch->x[i];
+    rect->i16YMin = batch->y[i];
+    rect->i16XMax = batch->x[i] + batch->width;
+    rect->i16YMax = batch->y[i] + batch->height;
+}
+//-----------------------------------------------------------------------------
+// Bits 0 to count-1 set
+uint32_t rect_batch_mask(RectBatch* batch)
+{
+    if (batch->count >= 32)
+    {
+        return 0xFFFFFFFF;
+    }
+    return ((uint32_t)1 << batch->count) - 1;
+}
+//-----------------------------------------------------------------------------
+// Test rect against every rectangle in the batch, one at a time
+// Returns a mask where bit i is 1 if rectangle i overlaps rect
+// Same (inclusive) overlap rule as GrRectOverlapCheck, reference for the other versions
+uint32_t rect_batch_overlap_scalar(RectBatch* batch, tRectangle* rect)
+{
+    // Rectangle i overlaps if x[i] <= XMax and x[i] + width >= XMin, and the same for y
+    int16_t x_min = rect->i16XMin - batch->width;
+    int16_t y_min = rect->i16YMin - batch->height;
+    uint32_t hit = 0;
+    uint16_t i;
+
+    for (i = 0; i < batch->count; i++)
+    {
+        if ((batch->x[i] <= rect->i16XMax) && (batch->x[i] >= x_min) &&
+                (batch->y[i] <= rect->i16YMax) && (batch->y[i] >= y_min))
+        {
+            hit |= (uint32_t)1 << i;
+        }
+    }
+    return hit;
+}
+//-----------------------------------------------------------------------------
+#if defined(__ARM_FEATURE_DSP) || defined(RECT_BATCH_EMULATE_DSP)
+// Keep the 16-bit halves of mask where a - b >= 0 (signed), clear the others
+// On the M4 this is ssub16 (__SSUB16), which sets the GE flags of a half if its result is >= 0,
+// then sel (__SEL), which keeps the bytes of mask where the GE flags are set. Both are in one
+// asm statement, the compiler knows nothing about the GE flags and could otherwise move
+// something that changes them in between. RECT_BATCH_EMULATE_DSP builds the same thing in C,
+// so that rect_batch_overlap_dsp can be checked on the host.
+uint32_t rect_batch_keep_ge(uint32_t a, uint32_t b, uint32_t mask)
+{
+    uint32_t result;
+#if defined(__ARM_FEATURE_DSP)
+    uint32_t difference;
+
+    __asm ("ssub16 %1, %2, %3\n\t"
+           "sel %0, %4, %5"
+           : "=r" (result), "=&r" (difference)
+           : "r" (a), "r" (b), "r" (mask), "r" (0)
+           : "cc");
+#else
+    result = mask;
+    if ((int16_t)a - (int16_t)b < 0)
+    {
+        result &= 0xFFFF0000;
+    }
+    if ((int16_t)(a >> 16) - (int16_t)(b >> 16) < 0)
+    {
+        result &= 0x0000FFFF;
+    }
+#endif
+    return result;
+}
+//-----------------------------------------------------------------------------
+// Cortex-M4 version, tests two rectangles per step
+// Two neighbouring x (or y) values are loaded as one 32-bit word and compared
+// in both halves at once with rect_batch_keep_ge.
+uint32_t rect_batch_overlap_dsp(RectBatch* batch, tRectangle* rect)
+{
+    uint32_t x_max = (uint16_t)rect->i16XMax * 0x00010001u;
+    uint32_t x_min = (uint16_t)(rect->i16XMin - batch->width) * 0x00010001u;
+    uint32_t y_max = (uint16_t)rect->i16YMax * 0x00010001u;
+    uint32_t y_min = (uint16_t)(rect->i16YMin - batch->height) * 0x00010001u;
+    uint32_t hit = 0;
+    uint32_t x;
+    uint32_t y;
+    uint32_t mask;
+    uint16_t i;
+
+    for (i = 0; i < batch->count; i += 2)
+    {
+        memcpy(&x, &batch->x[i], sizeof(x));
+        memcpy(&y, &batch->y[i], sizeof(y));
+        // x <= XMax
+        mask = rect_batch_keep_ge(x_max, x, 0xFFFFFFFF);
+        // x >= XMin - width
+        mask = rect_batch_keep_ge(x, x_min, mask);
+        // y <= YMax
+        mask = rect_batch_keep_ge(y_max, y, mask);
+        // y >= YMin - height
+        mask = rect_batch_keep_ge(y, y_min, mask);
+        hit |= ((mask & 1) | ((mask >> 15) & 2)) << i;
+    }
+    return hit & rect_batch_mask(batch);
+}
+#endif
+//-----------------------------------------------------------------------------
+#if defined(__SSE2__)
+// Host (x86) version, tests eight rectangles per step
+uint32_t rect_batch_overlap_sse2(RectBatch* batch, tRectangle* rect)
+{
+    __m128i x_max = _mm_set1_epi16(rect->i16XMax);
+    __m128i x_min = _mm_set1_epi16(rect->i16XMin - batch->width);
+    __m128i y_max = _mm_set1_epi16(rect->i16YMax);
+    __m128i y_min = _mm_set1_epi16(rect->i16YMin - batch->height);
+    __m128i x;
+    __m128i y;
+    __m128i miss;
+    uint32_t hit = 0;
+    uint16_t i;
+
+    for (i = 0; i < batch->count; i += 8)
+    {
+        x = _mm_loadu_si128((const __m128i*)&batch->x[i]);
+        y = _mm_loadu_si128((const __m128i*)&batch->y[i]);
+        miss = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi16(x, x_max), _mm_cmpgt_epi16(x_min, x)),
+                            _mm_or_si128(_mm_cmpgt_epi16(y, y_max), _mm_cmpgt_epi16(y_min, y)));
+        // One byte per 16-bit lane, then one bit per byte
+        hit |= (uint32_t)(~_mm_movemask_epi8(_mm_packs_epi16(miss, miss)) & 0xFF) << i;
+    }
+    return hit & rect_batch_mask(batch);
+}
+#endif
+//-----------------------------------------------------------------------------
+// Test rect against every rectangle in the batch with the fastest version available
+// Returns a mask where bit i is 1 if rectangle i overlaps rect
+uint32_t rect_batch_overlap(RectBatch* batch, tRectangle* rect)
+{
+#if defined(__ARM_FEATURE_DSP)
+    return rect_batch_overlap_dsp(batch, rect);
+#elif defined(__SSE2__)
+    return rect_batch_overlap_sse2(batch, rect);
+#else
+    return rect_batch_overlap_scalar(batch, rect);
+#endif
+}
+//-----------------------------------------------------------------------------
+
+#endif
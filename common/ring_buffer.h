@@ -0,0 +1,173 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <stdint.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Generic ring buffer with element type and capacity fixed at compile time
+//
+// RING_BUFFER(name, type, size) declares a struct called name that holds size
+// elements of type, together with name_check_full, name_check_empty,
+// name_count, name_clear, name_enqueue, name_dequeue, name_at, name_spans,
+// name_enqueue_n and name_dequeue_n.
+//
+// size has to be a power of two (checked at compile time) and at most 32768.
+// head and tail are free running counters that only ever increase (and wrap
+// around at 65536, which is a multiple of size), the slot in the buffer is
+// found by masking with size-1. This means:
+// - no % (and thus no hardware divide) on enqueue, dequeue or when stepping
+//   through the elements
+// - no -1 sentinels, empty is head == tail and full is tail - head == size
+//
+// The oldest element is at index head, the newest at index tail-1.
+//
+// Since the elements only wrap around once, the content is always at most two
+// contiguous spans of the buffer (name_spans). Looping over the spans instead
+// of stepping with name_at gives plain linear loops without any masking.
+//-----------------------------------------------------------------------------
+#define RING_BUFFER_INDEX(size, counter) ((uint16_t)(counter) & ((size) - 1))
+
+#define RING_BUFFER(name, type, size)                                           \
+typedef char name##_size_must_be_power_of_two                                   \
+    [((((size) & ((size) - 1)) == 0) && ((size) <= 32768)) ? 1 : -1];           \
+                                                                                \
+typedef struct                                                                  \
+{                                                                               \
+    uint16_t head;                                                              \
+    uint16_t tail;                                                              \
+    type buffer[size];                                                          \
+} name;                                                                         \
+                                                                                \
+/* Number of elements in the ring buffer */                                     \
+uint16_t name##_count(name* rb)                                                 \
+{                                                                               \
+    return (uint16_t)(rb->tail - rb->head);                                     \
+}                                                                               \
+                                                                                \
+/* Returns 1 if the ring buffer is full */                                      \
+int16_t name##_check_full(name* rb)                                             \
+{                                                                               \
+    return (uint16_t)(rb->tail - rb->head) == (size);                           \
+}                                                                               \
+                                                                                \
+/* Returns 1 if the ring buffer is empty */                                     \
+int16_t name##_check_empty(name* rb)                                            \
+{                                                                               \
+    return rb->head == rb->tail;                                                \
+}                                                                               \
+                                                                                \
+/* Remove all elements */                                                       \
+void name##_clear(name* rb)                                                     \
+{                                                                               \
+    rb->head = 0;                                                               \
+    rb->tail = 0;                                                               \
+}                                                                               \
+                                                                                \
+/* Add element last (at tail), returns 0 if the ring buffer is full */          \
+int16_t name##_enqueue(name* rb, type value)                                    \
+{                                                                               \
+    if (name##_check_full(rb))                                                  \
+    {                                                                           \
+        return 0;                                                               \
+    }                                                                           \
+    rb->buffer[RING_BUFFER_INDEX(size, rb->tail)] = value;                      \
+    rb->tail++;                                                                 \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Remove first element (at head), returns 0 if the ring buffer is empty */     \
+int16_t name##_dequeue(name* rb, type* value)                                   \
+{                                                                               \
+    if (name##_check_empty(rb))                                                 \
+    {                                                                           \
+        return 0;                                                               \
+    }                                                                           \
+    *value = rb->buffer[RING_BUFFER_INDEX(size, rb->head)];                     \
+    rb->head++;                                                                 \
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Element i counted from head (0 is the oldest), no bounds check */            \
+type* name##_at(name* rb, uint16_t i)                                           \
+{                                                                               \
+    return &rb->buffer[RING_BUFFER_INDEX(size, rb->head + i)];                  \
+}                                                                               \
+                                                                                \
+/* Content as at most two contiguous spans, oldest first */                     \
+/* Returns the number of spans (0, 1 or 2), unused spans get count 0 */         \
+int16_t name##_spans(name* rb, type** first, uint16_t* first_count,             \
+                     type** second, uint16_t* second_count)                     \
+{                                                                               \
+    uint16_t count = name##_count(rb);                                          \
+    uint16_t start = RING_BUFFER_INDEX(size, rb->head);                         \
+    uint16_t until_end = (size) - start;                                        \
+                                                                                \
+    *first = &rb->buffer[start];                                                \
+    *second = &rb->buffer[0];                                                   \
+    if (count <= until_end)                                                     \
+    {                                                                           \
+        *first_count = count;                                                   \
+        *second_count = 0;                                                      \
+        return count ? 1 : 0;                                                   \
+    }                                                                           \
+    *first_count = until_end;                                                   \
+    *second_count = count - until_end;                                          \
+    return 2;                                                                   \
+}                                                                               \
+                                                                                \
+/* Add up to n elements last, returns the number that fit */                    \
+uint16_t name##_enqueue_n(name* rb, const type* values, uint16_t n)             \
+{                                                                               \
+    uint16_t free_count = (size) - name##_count(rb);                            \
+    uint16_t start = RING_BUFFER_INDEX(size, rb->tail);                         \
+    uint16_t until_end = (size) - start;                                        \
+                                                                                \
+    if (n > free_count)                                                         \
+    {                                                                           \
+        n = free_count;                                                         \
+    }                                                                           \
+    if (n <= until_end)                                                         \
+    {                                                                           \
+        memcpy(&rb->buffer[start], values, n * sizeof(type));                   \
+    }                                                                           \
+    else                                                                        \
+    {                                                                           \
+        memcpy(&rb->buffer[start], values, until_end * sizeof(type));           \
+        memcpy(&rb->buffer[0], values + until_end,                              \
+               (n - until_end) * sizeof(type));                                 \
+    }                                                                           \
+    rb->tail += n;                                                              \
+    return n;                                                                   \
+}                                                                               \
+                                                                                \
+/* Remove up to n elements first, returns the number that were removed */       \
+/* values may be NULL to just drop them */                                      \
+uint16_t name##_dequeue_n(name* rb, type* values, uint16_t n)                   \
+{                                                                               \
+    uint16_t count = name##_count(rb);                                          \
+    uint16_t start = RING_BUFFER_INDEX(size, rb->head);                         \
+    uint16_t until_end = (size) - start;                                        \
+                                                                                \
+    if (n > count)                                                              \
+    {                                                                           \
+        n = count;                                                              \
+    }                                                                           \
+    if (values != NULL)                                                         \
+    {                                                                           \
+        if (n <= until_end)                                                     \
+        {                                                                       \
+            memcpy(values, &rb->buffer[start], n * sizeof(type));               \
+        }                                                                       \
+        else                                                                    \
+        {                                                                       \
+            memcpy(values, &rb->buffer[start], until_end * sizeof(type));       \
+            memcpy(values + until_end, &rb->buffer[0],                          \
+                   (n - until_end) * sizeof(type));                             \
+        }                                                                       \
+    }                                                                           \
+    rb->head += n;                                                              \
+    return n;                                                                   \
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "ring_buffer.h"
+
+//-----------------------------------------------------------------------------
+// Lock-free single producer / single consumer variant of RING_BUFFER
+//
+// SPSC_QUEUE(name, type, size) declares a struct called name that holds size
+// elements of type, together with name_init, name_count, name_check_full,
+// name_check_empty, name_enqueue and name_dequeue.
+//
+// Meant for handing data from an interrupt handler (producer, only calls
+// enqueue) to the main loop (consumer, only calls dequeue and check_empty),
+// or between two threads on the host. Neither side ever waits for the other,
+// enqueue returns 0 when the queue is full and dequeue returns 0 when it is
+// empty, so both are safe to call from an ISR.
+//
+// Only the producer writes tail and only the consumer writes head. The
+// element is written before tail is published (release) and the producer
+// reads head with acquire before reusing a slot, and the other way around
+// for the consumer, so an element is never read before it has been written
+// or overwritten before it has been read.
+//
+// Same size rules as RING_BUFFER: power of two, at most 32768.
+//-----------------------------------------------------------------------------
+#define SPSC_QUEUE(name, type, size)                                            \
+typedef char name##_size_must_be_power_of_two                                   \
+    [((((size) & ((size) - 1)) == 0) && ((size) <= 32768)) ? 1 : -1];           \
+                                                                                \
+typedef struct                                                                  \
+{                                                                               \
+    _Atomic uint16_t head;                                                      \
+    _Atomic uint16_t tail;                                                      \
+    type buffer[size];                                                          \
+} name;                                                                         \
+                                                                                \
+/* Must be called before producer and consumer start using the queue */         \
+void name##_init(name* q)                                                       \
+{                                                                               \
+    atomic_init(&q->head, 0);                                                   \
+    atomic_init(&q->tail, 0);                                                   \
+}                                                                               \
+                                                                                \
+/* Number of elements, only exact when called from producer or consumer */      \
+uint16_t name##_count(name* q)                                                  \
+{                                                                               \
+    return (uint16_t)(atomic_load_explicit(&q->tail, memory_order_acquire) -    \
+                      atomic_load_explicit(&q->head, memory_order_acquire));    \
+}                                                                               \
+                                                                                \
+/* Returns 1 if the queue is full, call from producer */                        \
+int16_t name##_check_full(name* q)                                              \
+{                                                                               \
+    return (uint16_t)(atomic_load_explicit(&q->tail, memory_order_relaxed) -    \
+                      atomic_load_explicit(&q->head, memory_order_acquire))     \
+           == (size);                                                           \
+}                                                                               \
+                                                                                \
+/* Returns 1 if the queue is empty, call from consumer */                       \
+int16_t name##_check_empty(name* q)                                             \
+{                                                                               \
+    return atomic_load_explicit(&q->head, memory_order_relaxed) ==              \
+           atomic_load_explicit(&q->tail, memory_order_acquire);                \
+}                                                                               \
+                                                                                \
+/* Add element last, returns 0 if the queue is full, producer only */           \
+int16_t name##_enqueue(name* q, type value)                                     \
+{                                                                               \
+    uint16_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);       \
+    uint16_t head = atomic_load_explicit(&q->head, memory_order_acquire);       \
+    if ((uint16_t)(tail - head) == (size))                                      \
+    {                                                                           \
+        return 0;                                                               \
+    }                                                                           \
+    q->buffer[RING_BUFFER_INDEX(size, tail)] = value;                           \
+    atomic_store_explicit(&q->tail, (uint16_t)(tail + 1), memory_order_release);\
+    return 1;                                                                   \
+}                                                                               \
+                                                                                \
+/* Remove first element, returns 0 if the queue is empty, consumer only */      \
+int16_t name##_dequeue(name* q, type* value)                                    \
+{                                                                               \
+    uint16_t head = atomic_load_explicit(&q->head, memory_order_relaxed);       \
+    uint16_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);       \
+    if (head == tail)                                                           \
+    {                                                                           \
+        return 0;                                                               \
+    }                                                                           \
+    *value = q->buffer[RING_BUFFER_INDEX(size, head)];                          \
+    atomic_store_explicit(&q->head, (uint16_t)(head + 1), memory_order_release);\
+    return 1;                                                                   \
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Running statistics of one ADC channel, integer math only
+//
+// stats_add takes one sample (0-4095) and updates everything with a few adds,
+// one multiply and no division, nothing is stored per sample, so it can be
+// called from an ADC interrupt. The mean, min, max and variance are over the
+// window since stats_reset (or stats_init), the EMA (exponential moving
+// average, weight 1 / 2^ema_shift for the new sample) over everything since
+// stats_init: stats_reset keeps it, so it goes on smoothly from one window to
+// the next.
+//
+// Mean and variance come from the sum and the sum of squares of the samples
+// minus the first one of the window (the shift keeps the sums small when the
+// signal sits far from 0). Unlike with floats these sums are exact, so there
+// is none of the cancellation Welford's method is meant to avoid; its integer
+// version instead rounds delta / count every sample and drifts once the
+// window is long. The divisions are in stats_get, when something is shown.
+//
+// The display picks what it shows with stats_get:
+//   stats_add(&stats, sample);                 // every sample
+//   value = stats_get(&stats, STATS_MEAN);     // any time
+//   stats_reset(&stats);                       // new window, EMA goes on
+//
+// A window can hold up to 2^32 samples (about 25 days at 2 kHz). When
+// samples come from an interrupt, read with that interrupt disabled.
+//-----------------------------------------------------------------------------
+typedef enum
+{
+    STATS_MEAN,
+    STATS_MIN,
+    STATS_MAX,
+    // Population variance and standard deviation, in ADC counts
+    STATS_VARIANCE,
+    STATS_STDDEV,
+    STATS_EMA
+} StatsKind;
+
+typedef struct
+{
+    // Window since the last reset
+    uint32_t count;
+    // First sample of the window, the sums are of sample - shift
+    uint16_t shift;
+    int64_t sum;
+    uint64_t sum_squares;
+    uint16_t min;
+    uint16_t max;
+    // 16.16, over every sample since stats_init
+    int32_t ema;
+    uint8_t ema_shift;
+    bool ema_started;
+} Stats;
+
+//-----------------------------------------------------------------------------
+// Start a new window, the EMA is kept
+void stats_reset(Stats* s)
+{
+    s->count = 0;
+    s->shift = 0;
+    s->sum = 0;
+    s->sum_squares = 0;
+    s->min = 0xFFFF;
+    s->max = 0;
+}
+//-----------------------------------------------------------------------------
+// ema_shift 0 to 15, the EMA follows a step to 63% in about 2^ema_shift samples
+void stats_init(Stats* s, uint8_t ema_shift)
+{
+    stats_reset(s);
+    s->ema = 0;
+    s->ema_shift = ema_shift;
+    s->ema_started = false;
+}
+//-----------------------------------------------------------------------------
+void stats_add(Stats* s, uint16_t sample)
+{
+    int32_t value = (int32_t)sample << 16;
+    int32_t delta;
+
+    if (s->count == 0)
+    {
+        s->shift = sample;
+    }
+    delta = (int32_t)sample - s->shift;
+    s->count++;
+    s->sum += delta;
+    s->sum_squares += (uint32_t)(delta * delta);
+    if (sample < s->min)
+    {
+        s->min = sample;
+    }
+    if (sample > s->max)
+    {
+        s->max = sample;
+    }
+    // The first sample starts the EMA where the signal is instead of at 0
+    if (!s->ema_started)
+    {
+        s->ema = value;
+        s->ema_started = true;
+    }
+    s->ema += (value - s->ema) >> s->ema_shift;
+}
+//-----------------------------------------------------------------------------
+// Rounded 16.16 to integer
+uint32_t stats_round(int32_t value)
+{
+    return (value < 0) ? 0 : (uint32_t)(value + 0x8000) >> 16;
+}
+//-----------------------------------------------------------------------------
+// Integer square root, rounded down
+uint32_t stats_sqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+//-----------------------------------------------------------------------------
+// Mean of the window minus shift in 16.16, rounded
+int32_t stats_mean_shifted(const Stats* s)
+{
+    int64_t sum = s->sum * 65536;
+    int64_t half = s->count / 2;
+
+    return (int32_t)(((sum < 0) ? sum - half : sum + half) / s->count);
+}
+//-----------------------------------------------------------------------------
+// Population variance of the window in 24.8: mean of the squares - square of the mean
+uint32_t stats_variance_q8(const Stats* s)
+{
+    int64_t mean = stats_mean_shifted(s);
+    int64_t variance = (int64_t)((s->sum_squares * 256 + s->count / 2) / s->count) - ((mean * mean + 0x800000) >> 24);
+
+    return (variance < 0) ? 0 : (uint32_t)variance;
+}
+//-----------------------------------------------------------------------------
+// kind of the window (or the EMA) rounded to an integer, 0 when the window is empty
+uint32_t stats_get(const Stats* s, StatsKind kind)
+{
+    if (s->count == 0 && kind != STATS_EMA)
+    {
+        return 0;
+    }
+    switch (kind)
+    {
+    case STATS_MEAN:
+        return stats_round(((int32_t)s->shift << 16) + stats_mean_shifted(s));
+    case STATS_MIN:
+        return s->min;
+    case STATS_MAX:
+        return s->max;
+    case STATS_VARIANCE:
+        return (stats_variance_q8(s) + 0x80) >> 8;
+    case STATS_STDDEV:
+        // sqrt of 24.8 is 12.4
+        return (stats_sqrt(stats_variance_q8(s)) + 8) >> 4;
+    case STATS_EMA:
+        return stats_round(s->ema);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+//-----------------------------------------------------------------------------
+// Host benchmarks: timing and report shared by the programs in host/bench
+//
+// Every benchmark is one .c file with its own main that includes the code it
+// measures straight from common/ or the lab directory, like the labs do:
+//   gcc -O2 -Ihost/include host/bench/ring_buffer_bench.c -o ring_buffer_bench
+// (the ones that draw also need host/src/*.c and -lm, see the top of each file).
+// Each measurement is one line of JSON:
+//   {"bench":"ring_buffer","case":"old_queue","size":30,"ops":20000000,"ns":6.98}
+// where ns is per operation, so two versions can be compared by diffing the
+// output. Numbers are only comparable on the same machine and compiler.
+//-----------------------------------------------------------------------------
+// Results are added here so the compiler can not drop the code being timed
+volatile uint32_t bench_sink;
+
+//-----------------------------------------------------------------------------
+// Nanoseconds from a monotonic clock
+uint64_t bench_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+//-----------------------------------------------------------------------------
+// Print one measurement, ns is the time of all ops together
+void bench_report(const char* bench, const char* name, uint32_t size, uint64_t ops, uint64_t ns)
+{
+    printf("{\"bench\":\"%s\",\"case\":\"%s\",\"size\":%u,\"ops\":%llu,\"ns\":%.2f}\n",
+           bench, name, size, (unsigned long long)ops, (double)ns / ops);
+}
+//-----------------------------------------------------------------------------
+// Print a memory footprint in the same form, bytes per element instead of ns
+//   {"bench":"unrolled_list","case":"unrolled","size":1024,"bytes":5.33}
+void bench_report_bytes(const char* bench, const char* name, uint32_t size, double bytes)
+{
+    printf("{\"bench\":\"%s\",\"case\":\"%s\",\"size\":%u,\"bytes\":%.2f}\n",
+           bench, name, size, bytes);
+}
+//-----------------------------------------------------------------------------
+
+#endif
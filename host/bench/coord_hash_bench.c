@@ -0,0 +1,126 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: search_list and delete_node of lab2_4.1/linked_list.h with
+// and without the coord_hash.h index
+//
+//   gcc -O2 -Ihost/include host/bench/coord_hash_bench.c -o coord_hash_bench
+//
+// A list of size nodes with distinct coordinates is built with insert_at_end,
+// once with an index (75% max load, starting from 16 entries so it grows on
+// the way) and once without. Cases, ns per operation:
+//   build      insert_at_end, keeping the index up to date (with growing)
+//   hit        search_list of a coordinat in the list
+//   miss       search_list of a coordinat not in the list
+//   delete     delete_node of a coordinat in the list + insert_at_end of it
+//              again, so the length stays the same
+// The coordinates are looked up in a random order. linear_* is the same
+// without an index (walking the list), with fewer operations since each one
+// takes O(size).
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#define NODE_POOL_SIZE 1000016
+#include "../../lab2_4.1/linked_list.h"
+
+#define OPS 4000000
+// Nodes walked by the linear versions per size
+#define LINEAR_WALK 200000000
+
+// Coordinat of node i, distinct for every i below 2^20
+#define NODE_X(i) ((int16_t)((i) & 1023))
+#define NODE_Y(i) ((int16_t)((i) >> 10))
+
+// Random node numbers, the same for both versions
+uint32_t order[OPS];
+
+//-----------------------------------------------------------------------------
+void bench_size(uint32_t size, int16_t indexed)
+{
+    LinkedList list;
+    CoordHash index;
+    const char* prefix = indexed ? "" : "linear_";
+    char name[32];
+    uint32_t ops = indexed ? OPS : LINEAR_WALK / size;
+    uint64_t start;
+    uint32_t hits = 0;
+    uint32_t i;
+
+    if (ops > OPS)
+    {
+        ops = OPS;
+    }
+    for (i = 0; i < ops; i++)
+    {
+        order[i] = ((uint32_t)rand() << 16 ^ (uint32_t)rand()) % size;
+    }
+    init_list(&list);
+    if (indexed)
+    {
+        coord_hash_init(&index, 16, 75);
+        set_index(&list, &index);
+    }
+
+    start = bench_now();
+    for (i = 0; i < size; i++)
+    {
+        insert_at_end(&list, NODE_X(i), NODE_Y(i));
+    }
+    if (indexed)
+    {
+        bench_report("coord_hash", "build", size, size, bench_now() - start);
+    }
+
+    start = bench_now();
+    for (i = 0; i < ops; i++)
+    {
+        hits += search_list(&list, NODE_X(order[i]), NODE_Y(order[i]));
+    }
+    snprintf(name, sizeof(name), "%shit", prefix);
+    bench_report("coord_hash", name, size, ops, bench_now() - start);
+
+    // -1 is never used as a y
+    start = bench_now();
+    for (i = 0; i < ops; i++)
+    {
+        hits += search_list(&list, NODE_X(order[i]), -1);
+    }
+    snprintf(name, sizeof(name), "%smiss", prefix);
+    bench_report("coord_hash", name, size, ops, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < ops; i++)
+    {
+        delete_node(&list, NODE_X(order[i]), NODE_Y(order[i]));
+        insert_at_end(&list, NODE_X(order[i]), NODE_Y(order[i]));
+    }
+    snprintf(name, sizeof(name), "%sdelete", prefix);
+    bench_report("coord_hash", name, size, ops, bench_now() - start);
+
+    if (list.count != size || (indexed && index.count != size))
+    {
+        printf("size %u: %u nodes in the list, %u in the index\n", size, list.count, indexed ? index.count : 0);
+    }
+    bench_sink += hits;
+    delete_list(&list);
+    if (indexed)
+    {
+        coord_hash_free(&index);
+    }
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint32_t sizes[] = {100000, 300000, 1000000};
+    uint16_t i;
+
+    srand(1);
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        bench_size(sizes[i], 1);
+        bench_size(sizes[i], 0);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,484 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: the profiled routines of the games, on generated state
+//
+//   gcc -O2 -Ihost/include host/bench/frame_bench.c host/src/*.c -lm -o frame_bench
+//
+// Calls what the PROFILE sections of the games time, without the drawing
+// around it and at fixed sizes, and prints the same JSON as common/profile.h
+// (one section per routine and size, "name/size", cycles and ns per call):
+//   snake_move/n               dequeue + enqueue of a snake of n parts, the
+//                              queue work of the move section (which also
+//                              has the GrRectFill of the tail and the head)
+//   check_rect_overlap_snake/n the head against the body, after a move
+//   check_rect_overlap_food/n  a random food rectangle against the body
+//   brick_scan/n               the brick_scan section of breakout with n
+//                              bricks left, without hiding the hit ones
+//   asteroid_update/24         the asteroid_update section of asteroids,
+//   asteroid_update_laser/24   without and with an active laser
+//   ball_direction             the direction chain of pong, copied from
+//                              lab2_4.1.1/main.c where it is inline
+//   hud_field_set/n            a new value of n digits in a field of 5, the
+//                              rows are built but go to a display that draws
+//                              nothing
+//   itoa/n                     the itoa that pong had before common/hud.h
+//                              (it had its own section), copied here
+// The snake runs around the same cycle as in snake_collision_bench.c, n = 1
+// to 109. The sections in the games stay, they give the numbers of a real
+// frame, with the drawing and on the board.
+//-----------------------------------------------------------------------------
+#define PROFILE
+#define PROFILE_MAX_SECTIONS 32
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "grlib/grlib.h"
+
+#include "utils/uartstdio.c"
+#include "bench.h"
+#include "../../common/profile.h"
+#include "../../common/rect_batch.h"
+#include "../../common/hud.h"
+#include "../../lab2_4.1/circular_queue.h"
+
+// Calls of every routine per size
+#define CALLS 100000
+#define PART_SIZE 9
+#define FOOD_SIZE 5
+#define CYCLE_CELLS 110
+
+// Time statement and add it to section name
+#define FRAME_BENCH(name, statement)                    \
+    do                                                  \
+    {                                                   \
+        uint32_t frame_bench_start = cycles_now();      \
+        statement;                                      \
+        profile_add(name, cycles_now() - frame_bench_start); \
+    } while (0)
+
+// Section names, profile.h keeps the pointers
+char section_names[PROFILE_MAX_SECTIONS][40];
+uint16_t section_name_count;
+
+// Upper left corners of the cells of the snake cycle, in the order it goes
+Coordinat cycle[CYCLE_CELLS];
+
+//-----------------------------------------------------------------------------
+// "routine/size" (or just routine if size is 0), one string per section
+const char* section_name(const char* routine, uint32_t size)
+{
+    char* name = section_names[section_name_count++];
+
+    if (size != 0)
+    {
+        snprintf(name, sizeof(section_names[0]), "%s/%u", routine, size);
+    }
+    else
+    {
+        snprintf(name, sizeof(section_names[0]), "%s", routine);
+    }
+    return name;
+}
+//-----------------------------------------------------------------------------
+// Row 0 left to right, then rows 1 to 9 as a serpentine over columns 10 to 1,
+// then column 0 back up to row 1, next to where it started
+void cycle_init(void)
+{
+    uint16_t count = 0;
+    int16_t column;
+    int16_t row;
+
+    for (column = 0; column < GRID_SIZE; column++)
+    {
+        cycle[count++] = cell_coordinat(column);
+    }
+    for (row = 1; row < 10; row++)
+    {
+        for (column = 1; column < GRID_SIZE; column++)
+        {
+            cycle[count++] = cell_coordinat(row * GRID_SIZE + ((row & 1) ? GRID_SIZE - column : column));
+        }
+    }
+    for (row = 9; row >= 1; row--)
+    {
+        cycle[count++] = cell_coordinat(row * GRID_SIZE);
+    }
+}
+//-----------------------------------------------------------------------------
+void bench_snake(uint16_t length)
+{
+    const char* move_name = section_name("snake_move", length);
+    const char* snake_name = section_name("check_rect_overlap_snake", length);
+    const char* food_name = section_name("check_rect_overlap_food", length);
+    CircularQueue queue;
+    tRectangle food;
+    uint32_t hits = 0;
+    uint32_t call;
+    uint16_t i;
+
+    empty_queue(&queue);
+    for (i = 0; i < length; i++)
+    {
+        enqueue(&queue, cycle[i].x, cycle[i].y);
+    }
+    for (call = 0; call < CALLS; call++)
+    {
+        i = (call + length) % CYCLE_CELLS;
+        FRAME_BENCH(move_name,
+                    dequeue(&queue);
+                    enqueue(&queue, cycle[i].x, cycle[i].y));
+        FRAME_BENCH(snake_name, hits += queue.overlap);
+
+        // Somewhere on the screen, like the food of main.c
+        food.i16XMin = 6 + rand() % 112;
+        food.i16YMin = 6 + rand() % 112;
+        food.i16XMax = food.i16XMin + FOOD_SIZE;
+        food.i16YMax = food.i16YMin + FOOD_SIZE;
+        FRAME_BENCH(food_name,
+                    hits += check_occupied_rect(&queue, PART_SIZE, food.i16XMin, food.i16YMin,
+                                                food.i16XMax, food.i16YMax, head_cell(&queue)));
+    }
+    bench_sink += hits;
+}
+//-----------------------------------------------------------------------------
+// Bricks of lab2_4.1.2/main.c, a random left of them are still there
+void bench_bricks(uint16_t left)
+{
+    const char* name = section_name("brick_scan", left);
+    RectBatch bricks;
+    tRectangle ball;
+    uint32_t bricks_left;
+    uint32_t bricks_hit;
+    int16_t ball_direction = 45;
+    int16_t num_bricks = 0;
+    uint32_t call;
+    uint16_t i;
+    uint16_t j;
+
+    // 3 rows of 8 bricks of 15x5, 1 pixel apart, from Y 15
+    rect_batch_init(&bricks, 15, 5);
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            rect_batch_add(&bricks, 1 + j * 16, 15 + i * 6);
+        }
+    }
+    for (call = 0; call < CALLS; call++)
+    {
+        bricks_left = 0;
+        while (__builtin_popcount(bricks_left) < left)
+        {
+            bricks_left |= (uint32_t)1 << (rand() % 24);
+        }
+        // Over the rows of bricks, so most calls hit one or two
+        ball.i16XMin = rand() % 123;
+        ball.i16YMin = 10 + rand() % 25;
+        ball.i16XMax = ball.i16XMin + 5;
+        ball.i16YMax = ball.i16YMin + 5;
+
+        FRAME_BENCH(name,
+                    bricks_hit = rect_batch_overlap(&bricks, &ball) & bricks_left;
+                    for (i = 0; bricks_hit != 0; i++, bricks_hit >>= 1)
+                    {
+                        if (bricks_hit & 1)
+                        {
+                            bricks_left &= ~((uint32_t)1 << i);
+                            num_bricks--;
+                            if (ball_direction == 45)
+                                ball_direction = 315;
+                            else if (ball_direction == 135)
+                                ball_direction = 225;
+                            else if (ball_direction == 225)
+                                ball_direction = 135;
+                            else if (ball_direction == 315)
+                                ball_direction = 45;
+                        }
+                    });
+    }
+    bench_sink += num_bricks + ball_direction;
+}
+//-----------------------------------------------------------------------------
+// 24 asteroids of lab2_4.1.3/main.c falling past the ship
+void bench_asteroids(int16_t laser_active)
+{
+    const char* name = section_name(laser_active ? "asteroid_update_laser" : "asteroid_update", 24);
+    RectBatch asteroids;
+    tRectangle ship_rectangle = {60, 113, 69, 122};
+    tRectangle laser_rectangle;
+    uint32_t ship_hit;
+    uint32_t asteroids_hit;
+    uint32_t hits = 0;
+    uint32_t call;
+    uint16_t i;
+
+    rect_batch_init(&asteroids, 9, 9);
+    for (i = 0; i < 24; i++)
+    {
+        rect_batch_add(&asteroids, rand() % 119, -10 - rand() % 128);
+    }
+    for (call = 0; call < CALLS; call++)
+    {
+        laser_rectangle.i16XMin = 60 + rand() % 8;
+        laser_rectangle.i16YMin = rand() % 113;
+        laser_rectangle.i16XMax = laser_rectangle.i16XMin + 3;
+        laser_rectangle.i16YMax = laser_rectangle.i16YMin + 9;
+
+        FRAME_BENCH(name,
+                    for (i = 0; i < 24; i++)
+                    {
+                        asteroids.y[i] = asteroids.y[i] + 5;
+                    }
+                    ship_hit = rect_batch_overlap(&asteroids, &ship_rectangle);
+                    asteroids_hit = (laser_active == 1) ? rect_batch_overlap(&asteroids, &laser_rectangle) : 0);
+
+        hits += ship_hit + asteroids_hit;
+        // Back to the top at a new x when below the screen, like main.c
+        for (i = 0; i < 24; i++)
+        {
+            if (asteroids.y[i] > 128)
+            {
+                asteroids.x[i] = rand() % 119;
+                asteroids.y[i] = -10;
+            }
+        }
+    }
+    bench_sink += hits;
+}
+//-----------------------------------------------------------------------------
+// Ball movement of lab2_4.1.1/main.c
+void ball_direction_move(tRectangle* ball_rectangle, int16_t ball_direction, int16_t ball_speed)
+{
+    // Move straight right (east)
+    if(ball_direction == 0)
+    {
+        ball_rectangle->i16XMin = ball_rectangle->i16XMin + ball_speed;
+    }
+    // Move north east
+    else if (ball_direction == 45)
+    {
+        ball_rectangle->i16XMin = ball_rectangle->i16XMin + ball_speed;
+        ball_rectangle->i16YMin = ball_rectangle->i16YMin - ball_speed;
+    }
+    // Move north west
+    else if (ball_direction == 135)
+    {
+        ball_rectangle->i16XMin = ball_rectangle->i16XMin - ball_speed;
+        ball_rectangle->i16YMin = ball_rectangle->i16YMin - ball_speed;
+    }
+    // Move straight left (west)
+    else if (ball_direction == 180)
+    {
+        ball_rectangle->i16XMin = ball_rectangle->i16XMin - ball_speed;
+    }
+    // Move south west
+    else if (ball_direction == 225)
+    {
+        ball_rectangle->i16XMin = ball_rectangle->i16XMin - ball_speed;
+        ball_rectangle->i16YMin = ball_rectangle->i16YMin + ball_speed;
+    }
+    // Move south east
+    else if (ball_direction == 315)
+    {
+        ball_rectangle->i16XMin = ball_rectangle->i16XMin + ball_speed;
+        ball_rectangle->i16YMin = ball_rectangle->i16YMin + ball_speed;
+    }
+}
+//-----------------------------------------------------------------------------
+void bench_ball_direction(void)
+{
+    const int16_t directions[] = {0, 45, 135, 180, 225, 315};
+    const char* name = section_name("ball_direction", 0);
+    tRectangle ball = {60, 60, 65, 65};
+    int16_t direction;
+    uint32_t call;
+
+    for (call = 0; call < CALLS; call++)
+    {
+        direction = directions[rand() % 6];
+        FRAME_BENCH(name, ball_direction_move(&ball, direction, 3));
+    }
+    bench_sink += ball.i16XMin + ball.i16YMin;
+}
+//-----------------------------------------------------------------------------
+// itoa of pong from before common/hud.h, as it was (without its PROFILE lines)
+void reverse_string(char str[], int length)
+{
+    char temp;
+    int start = 0;
+    int end = length - 1;
+
+    while (start < end)
+    {
+        temp = str[start];
+        str[start] = str[end];
+        str[end] = temp;
+        end--;
+        start++;
+    }
+}
+
+char* itoa(int num, char* str, int base)
+{
+    int i = 0;
+    bool isNegative = false;
+
+    if (num == 0) {
+        str[i++] = '0';
+        str[i] = '\0';
+        return str;
+    }
+    if (num < 0 && base == 10) {
+        isNegative = true;
+        num = -num;
+    }
+    while (num != 0) {
+        int rem = num % base;
+        str[i++] = (rem > 9) ? (rem - 10) + 'a' : rem + '0';
+        num = num / base;
+    }
+    if (isNegative)
+        str[i++] = '-';
+    str[i] = '\0';
+    reverse_string(str, i);
+    return str;
+}
+//-----------------------------------------------------------------------------
+// Display that draws nothing, hud_field_draw still builds every row for it
+uint32_t null_pixels;
+
+void null_pixel_draw(void* display_data, int32_t x, int32_t y, uint32_t value)
+{
+    (void)display_data;
+    (void)x;
+    (void)y;
+    (void)value;
+}
+
+void null_pixel_draw_multiple(void* display_data, int32_t x, int32_t y, int32_t x0, int32_t count,
+                              int32_t bpp, const uint8_t* data, const uint8_t* palette)
+{
+    (void)display_data;
+    (void)x;
+    (void)y;
+    (void)x0;
+    (void)bpp;
+    (void)data;
+    (void)palette;
+    null_pixels += count;
+}
+
+void null_line_draw_h(void* display_data, int32_t x1, int32_t x2, int32_t y, uint32_t value)
+{
+    (void)display_data;
+    (void)x1;
+    (void)x2;
+    (void)y;
+    (void)value;
+}
+
+void null_line_draw_v(void* display_data, int32_t x, int32_t y1, int32_t y2, uint32_t value)
+{
+    (void)display_data;
+    (void)x;
+    (void)y1;
+    (void)y2;
+    (void)value;
+}
+
+void null_rect_fill(void* display_data, const tRectangle* rect, uint32_t value)
+{
+    (void)display_data;
+    (void)rect;
+    (void)value;
+}
+
+uint32_t null_color_translate(void* display_data, uint32_t value)
+{
+    (void)display_data;
+    return value;
+}
+
+void null_flush(void* display_data)
+{
+    (void)display_data;
+}
+
+const tDisplay null_display =
+{
+    sizeof(tDisplay),
+    0,
+    128,
+    128,
+    null_pixel_draw,
+    null_pixel_draw_multiple,
+    null_line_draw_h,
+    null_line_draw_v,
+    null_rect_fill,
+    null_color_translate,
+    null_flush
+};
+//-----------------------------------------------------------------------------
+// Random values of digits digits, a new one every call so the field always changes
+void bench_numbers(uint16_t digits)
+{
+    const char* hud_name = section_name("hud_field_set", digits);
+    const char* itoa_name = section_name("itoa", digits);
+    tContext context;
+    HudField field;
+    char itoa_buf[10];
+    int32_t low = 1;
+    int32_t value;
+    uint32_t call;
+    uint16_t i;
+
+    for (i = 1; i < digits; i++)
+    {
+        low *= 10;
+    }
+    GrContextInit(&context, &null_display);
+    GrContextForegroundSet(&context, ClrWhite);
+    GrContextBackgroundSet(&context, ClrBlack);
+    hud_field_init(&field, 40, 60, 5);
+    for (call = 0; call < CALLS; call++)
+    {
+        value = ((digits == 1) ? 0 : low) + rand() % (9 * low + (digits == 1));
+        FRAME_BENCH(hud_name, hud_field_set(&field, &context, value));
+        FRAME_BENCH(itoa_name, itoa(value, itoa_buf, 10));
+        bench_sink += itoa_buf[0];
+    }
+    bench_sink += null_pixels;
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint16_t lengths[] = {1, 16, 32, 64, 109};
+    const uint16_t bricks[] = {24, 12, 1};
+    const uint16_t digits[] = {1, 3, 5};
+    uint16_t i;
+
+    // The report is printed at exit
+    profile_init(0);
+    hud_init(&g_sFontFixed6x8);
+    cycle_init();
+    srand(1);
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        bench_snake(lengths[i]);
+    }
+    for (i = 0; i < sizeof(bricks) / sizeof(bricks[0]); i++)
+    {
+        bench_bricks(bricks[i]);
+    }
+    bench_asteroids(0);
+    bench_asteroids(1);
+    bench_ball_direction();
+    for (i = 0; i < sizeof(digits) / sizeof(digits[0]); i++)
+    {
+        bench_numbers(digits[i]);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
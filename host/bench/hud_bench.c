@@ -0,0 +1,163 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: LCD traffic of a number update, common/hud.h against grlib
+//
+//   gcc -O2 -Ihost/include host/bench/hud_bench.c host/src/*.c -lm -o hud_bench
+//   ./hud_bench
+//
+// Both draw straight to the ST7735S driver like the dashboard does, and the
+// host model of the driver counts what reaches the panel (the counters of
+// HOST_DISPLAY_STATS, so do not run it with HOST_HEADLESS or HOST_DISPLAY=0).
+// grlib_* is what the dashboard did before common/hud.h: GrStringDrawCentered
+// of "    " to blank the field, then of the itoa of the value. hud_* is
+// hud_field_set on a field of 4 cells at the same place. Cases:
+//   random     a new random value of size digits every time
+//   step       a counter going up by one from 1000, mostly the last digit
+//              changes
+// Per value: driver calls (each one sets a window, 11 bytes), pixels written,
+// pixels written with the color they already had and bytes on the SPI bus.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "grlib/grlib.h"
+#include "drivers/CF128x128x16_ST7735S.h"
+
+#include "host.h"
+#include "bench.h"
+#include "../../common/hud.h"
+
+#define VALUES 10000
+
+tContext context;
+HudField field;
+char itoa_buf[10];
+
+//-----------------------------------------------------------------------------
+// itoa of the dashboard from before common/hud.h, as it was (without its PROFILE lines)
+void reverse_string(char str[], int length)
+{
+    char temp;
+    int start = 0;
+    int end = length - 1;
+
+    while (start < end)
+    {
+        temp = str[start];
+        str[start] = str[end];
+        str[end] = temp;
+        end--;
+        start++;
+    }
+}
+
+char* itoa(int num, char* str, int base)
+{
+    int i = 0;
+    bool isNegative = false;
+
+    if (num == 0) {
+        str[i++] = '0';
+        str[i] = '\0';
+        return str;
+    }
+    if (num < 0 && base == 10) {
+        isNegative = true;
+        num = -num;
+    }
+    while (num != 0) {
+        int rem = num % base;
+        str[i++] = (rem > 9) ? (rem - 10) + 'a' : rem + '0';
+        num = num / base;
+    }
+    if (isNegative)
+        str[i++] = '-';
+    str[i] = '\0';
+    reverse_string(str, i);
+    return str;
+}
+//-----------------------------------------------------------------------------
+// Show value with the old or the new code
+void show(int16_t hud, int32_t value)
+{
+    if (hud)
+    {
+        hud_field_set(&field, &context, value);
+    }
+    else
+    {
+        GrStringDrawCentered(&context, "    ", -1, 110, 8, 1);
+        GrStringDrawCentered(&context, itoa(value, itoa_buf, 10), -1, 110, 8, 1);
+    }
+}
+//-----------------------------------------------------------------------------
+// Draw values[0..VALUES-1] and print what it cost per value
+void bench_values(const char* name, uint32_t size, int16_t hud, const int32_t* values)
+{
+    tHostDisplayStats before;
+    tHostDisplayStats after;
+    char case_name[32];
+    uint32_t i;
+
+    // Start from a cleared field showing the first value
+    CF128x128x16_ST7735SClear(ClrBlack);
+    hud_field_invalidate(&field);
+    show(hud, values[0]);
+
+    HostDisplayStatsGet(NULL, &before);
+    for (i = 1; i <= VALUES; i++)
+    {
+        show(hud, values[i]);
+    }
+    HostDisplayStatsGet(NULL, &after);
+    if (after.ui32DrawCalls == before.ui32DrawCalls)
+    {
+        printf("nothing was drawn, run without HOST_HEADLESS and HOST_DISPLAY=0\n");
+        exit(1);
+    }
+    snprintf(case_name, sizeof(case_name), "%s_%s", hud ? "hud" : "grlib", name);
+    printf("{\"bench\":\"hud\",\"case\":\"%s\",\"size\":%u,\"values\":%u,\"calls\":%.2f,\"pixels\":%.2f,"
+           "\"same\":%.2f,\"bus_bytes\":%.2f}\n",
+           case_name, size, VALUES,
+           (double)(after.ui32DrawCalls - before.ui32DrawCalls) / VALUES,
+           (double)(after.ui32PixelsWritten - before.ui32PixelsWritten) / VALUES,
+           (double)(after.ui32PixelsSame - before.ui32PixelsSame) / VALUES,
+           (double)(after.ui32BusBytes - before.ui32BusBytes) / VALUES);
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    static int32_t values[VALUES + 1];
+    int32_t low = 1;
+    uint32_t digits;
+    uint32_t i;
+
+    CF128x128x16_ST7735SInit(120000000);
+    GrContextInit(&context, &g_sCF128x128x16_ST7735S);
+    GrContextFontSet(&context, &g_sFontFixed6x8);
+    GrContextForegroundSet(&context, ClrWhite);
+    GrContextBackgroundSet(&context, ClrBlack);
+    hud_init(&g_sFontFixed6x8);
+    // Where the dashboard has its first field, the same cells as "    " centered at 110, 8
+    hud_field_init(&field, 98, 5, 4);
+
+    srand(1);
+    for (digits = 1; digits <= 4; digits++, low *= 10)
+    {
+        for (i = 0; i <= VALUES; i++)
+        {
+            values[i] = ((digits == 1) ? 0 : low) + rand() % (9 * low + (digits == 1));
+        }
+        bench_values("random", digits, 0, values);
+        bench_values("random", digits, 1, values);
+    }
+    for (i = 0; i <= VALUES; i++)
+    {
+        values[i] = 1000 + i % 9000;
+    }
+    bench_values("step", 4, 0, values);
+    bench_values("step", 4, 1, values);
+    return 0;
+}
+//-----------------------------------------------------------------------------
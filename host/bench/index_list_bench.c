@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: lab2_4.1/index_list.h against the pointer list of linked_list.h
+//
+//   gcc -O2 -Ihost/include host/bench/index_list_bench.c -o index_list_bench
+//
+// Both lists get the same size coordinates with insert_at_end (the pointer
+// list without a coord_hash index, nodes from its pool). Cases:
+//   hit        search_list of a random coordinat in the list, ns per search
+//   miss       search_list of a coordinat not in the list (walks all of it),
+//              ns per node walked
+//   insert     insert_at_end + delete_at_begin, the snake moving one step,
+//              ns per pair
+// index_* is IndexList (6 bytes per node), pointer_* is LinkedList (24 bytes
+// per node here, 16 on the M4).
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#define INDEX_LIST_SIZE 4096
+#define NODE_POOL_SIZE 4096
+#include "../../lab2_4.1/index_list.h"
+#include "../../lab2_4.1/linked_list.h"
+
+#define OPS 4000000
+// Nodes walked by the searches per size
+#define WALK 400000000
+
+// Coordinat of element i
+#define ELEMENT_X(i) ((int16_t)((i) % 127))
+#define ELEMENT_Y(i) ((int16_t)((i) / 127))
+
+IndexList index_list;
+LinkedList pointer_list;
+// Random element numbers, the same for both lists
+uint32_t order[OPS];
+
+//-----------------------------------------------------------------------------
+void bench_size(uint32_t size)
+{
+    uint32_t searches = WALK / size;
+    uint64_t start;
+    uint32_t hits = 0;
+    uint32_t i;
+
+    if (searches > OPS)
+    {
+        searches = OPS;
+    }
+    for (i = 0; i < searches; i++)
+    {
+        order[i] = rand() % size;
+    }
+    ilist_init(&index_list);
+    init_list(&pointer_list);
+    for (i = 0; i < size; i++)
+    {
+        ilist_insert_at_end(&index_list, ELEMENT_X(i), ELEMENT_Y(i));
+        insert_at_end(&pointer_list, ELEMENT_X(i), ELEMENT_Y(i));
+    }
+
+    start = bench_now();
+    for (i = 0; i < searches; i++)
+    {
+        hits += ilist_search_list(&index_list, ELEMENT_X(order[i]), ELEMENT_Y(order[i]));
+    }
+    bench_report("index_list", "index_hit", size, searches, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < searches; i++)
+    {
+        hits += search_list(&pointer_list, ELEMENT_X(order[i]), ELEMENT_Y(order[i]));
+    }
+    bench_report("index_list", "pointer_hit", size, searches, bench_now() - start);
+
+    // -1 is never used as a y
+    start = bench_now();
+    for (i = 0; i < searches; i++)
+    {
+        hits += ilist_search_list(&index_list, ELEMENT_X(i), -1);
+    }
+    bench_report("index_list", "index_miss", size, (uint64_t)searches * size, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < searches; i++)
+    {
+        hits += search_list(&pointer_list, ELEMENT_X(i), -1);
+    }
+    bench_report("index_list", "pointer_miss", size, (uint64_t)searches * size, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < OPS; i++)
+    {
+        ilist_insert_at_end(&index_list, ELEMENT_X(i), ELEMENT_Y(i));
+        ilist_delete_at_begin(&index_list);
+    }
+    bench_report("index_list", "index_insert", size, OPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < OPS; i++)
+    {
+        insert_at_end(&pointer_list, ELEMENT_X(i), ELEMENT_Y(i));
+        delete_at_begin(&pointer_list);
+    }
+    bench_report("index_list", "pointer_insert", size, OPS, bench_now() - start);
+
+    if (index_list.count != size || pointer_list.count != size || hits != 2 * searches)
+    {
+        printf("size %u: lists of %u and %u, %u hits\n", size, index_list.count, pointer_list.count, hits);
+    }
+    bench_sink += hits;
+    delete_list(&pointer_list);
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint32_t sizes[] = {16, 128, 1024, 4000};
+    uint16_t i;
+
+    srand(1);
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        bench_size(sizes[i]);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
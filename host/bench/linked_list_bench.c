@@ -0,0 +1,185 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: end operations of the LinkedList handle in lab2_4.1/linked_list.h
+//
+//   gcc -O2 -Ihost/include host/bench/linked_list_bench.c -o linked_list_bench
+//
+// A list of size elements is built with insert_at_end, then every case does
+// operations that leave it at size elements, so each one runs at that length:
+//   end        insert_at_end + delete_at_end
+//   begin      insert_at_begin + delete_at_begin
+//   get_last   get_last
+//   by_node    remove_node of a node in the middle + insert_after_node of the
+//              node before it (what the node returned by an insert is for)
+// old_* is the same with the functions from before the handle (head pointer
+// only, insert_at_end, delete_at_end and get_last walk the whole list), copied
+// here as they were. They get fewer operations at the long lengths. ns is per
+// operation, an insert and a delete count as two.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+
+#include "bench.h"
+// One list of up to 10^6 nodes at a time, plus the ones inserted by the cases
+#define NODE_POOL_SIZE 1000016
+#include "../../lab2_4.1/linked_list.h"
+
+#define OPS 4000000
+// Nodes walked by the old functions per size, keeps the long lengths short
+#define OLD_WALK 400000000
+
+//-----------------------------------------------------------------------------
+// Functions from before the handle (the insert/delete/get_last of one list given by its head)
+void old_insert_at_end(struct _node **head, int16_t x, int16_t y)
+{
+    struct _node *lk = node_alloc();
+    struct _node *linkedlist = *head;
+
+    lk->x = x;
+    lk->y = y;
+    if(*head == NULL)
+    {
+        *head = lk;
+        return;
+    }
+    while(linkedlist->next != NULL)
+        linkedlist = linkedlist->next;
+    linkedlist->next = lk;
+}
+
+// The old one fell through after freeing a single node, the lists here are never that short
+void old_delete_at_end(struct _node **head)
+{
+    struct _node *temp = *head;
+
+    while (temp->next->next != NULL)
+        temp = temp->next;
+    node_free(temp->next);
+    temp->next = NULL;
+}
+
+// The old one returned the node before the last one (and crashed on a list of one node)
+struct _node old_get_last(struct _node **head)
+{
+    struct _node *linkedlist = *head;
+    while (linkedlist->next->next != NULL)
+        linkedlist = linkedlist->next;
+    return *linkedlist;
+}
+//-----------------------------------------------------------------------------
+void bench_handle(uint32_t size)
+{
+    LinkedList list;
+    // get_last through this, so that the compiler does not take it out of the loop
+    LinkedList *volatile handle = &list;
+    struct _node *middle;
+    struct _node *before;
+    uint64_t start;
+    uint32_t sum = 0;
+    uint32_t i;
+
+    init_list(&list);
+    for (i = 0; i < size; i++)
+    {
+        insert_at_end(&list, i, i);
+    }
+
+    start = bench_now();
+    for (i = 0; i < OPS / 2; i++)
+    {
+        insert_at_end(&list, i, i);
+        delete_at_end(&list);
+    }
+    bench_report("linked_list", "end", size, OPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < OPS / 2; i++)
+    {
+        insert_at_begin(&list, i, i);
+        delete_at_begin(&list);
+    }
+    bench_report("linked_list", "begin", size, OPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < OPS; i++)
+    {
+        sum += get_last(handle)->x;
+    }
+    bench_report("linked_list", "get_last", size, OPS, bench_now() - start);
+
+    // Walk to the middle once, after that the node is always at hand
+    middle = list.head;
+    for (i = 0; i < size / 2; i++)
+    {
+        middle = middle->next;
+    }
+    start = bench_now();
+    for (i = 0; i < OPS / 2; i++)
+    {
+        before = node_before(&list, middle);
+        remove_node(&list, middle);
+        middle = insert_after_node(&list, before, i, i);
+    }
+    bench_report("linked_list", "by_node", size, OPS, bench_now() - start);
+
+    if (list.count != size)
+    {
+        printf("size %u: list has %u nodes\n", size, list.count);
+    }
+    bench_sink += sum;
+    delete_list(&list);
+}
+//-----------------------------------------------------------------------------
+void bench_old(uint32_t size)
+{
+    struct _node *head = NULL;
+    struct _node *lk;
+    uint32_t ops = OLD_WALK / size;
+    uint64_t start;
+    uint32_t sum = 0;
+    uint32_t i;
+
+    if (ops > OPS)
+    {
+        ops = OPS;
+    }
+    // Built from the front, with old_insert_at_end it would take O(size^2)
+    for (i = 0; i < size; i++)
+    {
+        lk = node_alloc();
+        lk->x = size - 1 - i;
+        lk->y = size - 1 - i;
+        lk->next = head;
+        head = lk;
+    }
+
+    start = bench_now();
+    for (i = 0; i < ops / 2; i++)
+    {
+        old_insert_at_end(&head, i, i);
+        old_delete_at_end(&head);
+    }
+    bench_report("linked_list", "old_end", size, ops / 2 * 2, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < ops; i++)
+    {
+        sum += old_get_last(&head).x;
+    }
+    bench_report("linked_list", "old_get_last", size, ops, bench_now() - start);
+    bench_sink += sum;
+    node_pool_release_all();
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint32_t sizes[] = {10, 100, 1000, 10000, 100000, 1000000};
+    uint16_t i;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        bench_handle(sizes[i]);
+        bench_old(sizes[i]);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,100 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: the static node pool of lab2_4.1/linked_list.h against calloc/free
+//
+//   gcc -O2 -Ihost/include host/bench/node_pool_bench.c -o node_pool_bench
+//   gcc -O2 -DLINKED_LIST_USE_MALLOC -Ihost/include host/bench/node_pool_bench.c -o node_pool_bench_malloc
+//
+// The same code built twice, the cases are called pool_* or malloc_* after
+// where the nodes come from. 10^6 cycles each, ns per cycle:
+//   alloc      node_alloc + node_free of one node
+//   cycle      insert_at_end + delete_at_begin on a list of size nodes, the
+//              snake moving one step
+//   build      insert_at_end of size nodes, then delete_list, ns per node
+// calloc is glibc's here, on the target the heap of the TI library is
+// smaller and slower, and can run out in the middle of a game.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+
+#include "bench.h"
+// The longest list plus the node of a cycle
+#define NODE_POOL_SIZE 100016
+#include "../../lab2_4.1/linked_list.h"
+
+#define CYCLES 1000000
+
+#ifdef LINKED_LIST_USE_MALLOC
+#define CASE(name) "malloc_" name
+#else
+#define CASE(name) "pool_" name
+#endif
+
+// Every node of the alloc case is stored here, otherwise the compiler drops calloc + free
+struct _node *volatile bench_node;
+
+//-----------------------------------------------------------------------------
+void bench_alloc(void)
+{
+    uint64_t start;
+    uint32_t i;
+
+    start = bench_now();
+    for (i = 0; i < CYCLES; i++)
+    {
+        bench_node = node_alloc();
+        node_free(bench_node);
+    }
+    bench_report("node_pool", CASE("alloc"), 1, CYCLES, bench_now() - start);
+}
+//-----------------------------------------------------------------------------
+void bench_size(uint32_t size)
+{
+    LinkedList list;
+    uint32_t builds = CYCLES / size;
+    uint64_t start;
+    uint32_t i;
+    uint32_t j;
+
+    init_list(&list);
+    for (i = 0; i < size; i++)
+    {
+        insert_at_end(&list, i, i);
+    }
+    start = bench_now();
+    for (i = 0; i < CYCLES; i++)
+    {
+        insert_at_end(&list, i, i);
+        delete_at_begin(&list);
+    }
+    bench_report("node_pool", CASE("cycle"), size, CYCLES, bench_now() - start);
+    if (list.count != size)
+    {
+        printf("size %u: list has %u nodes\n", size, list.count);
+    }
+    delete_list(&list);
+
+    start = bench_now();
+    for (i = 0; i < builds; i++)
+    {
+        for (j = 0; j < size; j++)
+        {
+            insert_at_end(&list, j, j);
+        }
+        delete_list(&list);
+    }
+    bench_report("node_pool", CASE("build"), size, (uint64_t)builds * size, bench_now() - start);
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint32_t sizes[] = {1, 1000, 100000};
+    uint16_t i;
+
+    bench_alloc();
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        bench_size(sizes[i]);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,242 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: common/rect_batch.h against the per-object overlap loops
+//
+//   gcc -O2 -Ihost/include host/bench/rect_batch_bench.c host/src/*.c -lm -o rect_batch_bench
+//
+// old is what breakout and asteroids did before the batch: build a tRectangle
+// for every brick (asteroid) from its corner and call GrRectOverlapCheck.
+// scalar and sse2 are rect_batch_overlap_scalar and rect_batch_overlap_sse2.
+// breakout is the ball against the 24 bricks (3 rows of 8, destroyed bricks
+// skipped), once per frame; asteroids is the ship and then the laser against
+// the 24 asteroids, once each per frame. ns is per frame.
+//
+// The Cortex-M4 version is built here with RECT_BATCH_EMULATE_DSP, ssub16 and
+// sel done in C. It is only checked, not timed, the time would say nothing
+// about the M4. Before timing, every version is compared with the old loop on
+// random batches and rectangles, the benchmark stops if one disagrees.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "grlib/grlib.h"
+
+#include "bench.h"
+#define RECT_BATCH_EMULATE_DSP
+#include "../../common/rect_batch.h"
+
+#define FRAMES 4000000
+#define CHECKS 200000
+// Ball (asteroid, ship, laser) positions, the same for every version
+#define POSITIONS 1024
+
+//-----------------------------------------------------------------------------
+// Original loop, corner of object i is x[i], y[i], only the objects in left are tested
+uint32_t old_overlap(const int16_t* x, const int16_t* y, uint16_t count, int16_t width, int16_t height,
+                     uint32_t left, tRectangle* rect)
+{
+    tRectangle object;
+    uint32_t hit = 0;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (left & ((uint32_t)1 << i))
+        {
+            object.i16XMin = x[i];
+            object.i16YMin = y[i];
+            object.i16XMax = object.i16XMin + width;
+            object.i16YMax = object.i16YMin + height;
+            if (GrRectOverlapCheck(rect, &object))
+            {
+                hit |= (uint32_t)1 << i;
+            }
+        }
+    }
+    return hit;
+}
+//-----------------------------------------------------------------------------
+// Rectangle of width x height with a random corner in -range/2 to range/2
+void random_rect(tRectangle* rect, int16_t range, int16_t width, int16_t height)
+{
+    rect->i16XMin = rand() % range - range / 2;
+    rect->i16YMin = rand() % range - range / 2;
+    rect->i16XMax = rect->i16XMin + width;
+    rect->i16YMax = rect->i16YMin + height;
+}
+//-----------------------------------------------------------------------------
+// Returns 1 if a version disagrees with the old loop
+int16_t check(void)
+{
+    RectBatch batch;
+    tRectangle rect;
+    uint32_t expected;
+    uint32_t got[3];
+    uint32_t n;
+    uint16_t count;
+    uint16_t i;
+
+    srand(1);
+    for (n = 0; n < CHECKS; n++)
+    {
+        // Small range, so that there are many hits and many values at the edges
+        count = 1 + rand() % RECT_BATCH_MAX;
+        rect_batch_init(&batch, rand() % 20, rand() % 20);
+        for (i = 0; i < count; i++)
+        {
+            rect_batch_add(&batch, rand() % 80 - 40, rand() % 80 - 40);
+        }
+        random_rect(&rect, 80, rand() % 20, rand() % 20);
+
+        expected = old_overlap(batch.x, batch.y, count, batch.width, batch.height, 0xFFFFFFFF, &rect);
+        got[0] = rect_batch_overlap_scalar(&batch, &rect);
+        got[1] = rect_batch_overlap_dsp(&batch, &rect);
+#if defined(__SSE2__)
+        got[2] = rect_batch_overlap_sse2(&batch, &rect);
+#else
+        got[2] = expected;
+#endif
+        if (got[0] != expected || got[1] != expected || got[2] != expected)
+        {
+            printf("check %u: old %08x scalar %08x dsp %08x sse2 %08x\n", n, expected, got[0], got[1], got[2]);
+            return 1;
+        }
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+void bench_breakout(void)
+{
+    RectBatch bricks;
+    tRectangle balls[POSITIONS];
+    uint32_t bricks_left = 0x00FFFFFF;
+    uint32_t hits = 0;
+    uint64_t start;
+    uint32_t frame;
+    uint16_t i;
+    uint16_t j;
+
+    rect_batch_init(&bricks, 15, 5);
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            rect_batch_add(&bricks, 1 + j * 16, 15 + i * 6);
+        }
+    }
+    // Half of the bricks gone, the ball anywhere on the screen
+    srand(2);
+    for (i = 0; i < 12; i++)
+    {
+        bricks_left &= ~((uint32_t)1 << (rand() % 24));
+    }
+    for (i = 0; i < POSITIONS; i++)
+    {
+        balls[i].i16XMin = rand() % 123;
+        balls[i].i16YMin = rand() % 60;
+        balls[i].i16XMax = balls[i].i16XMin + 5;
+        balls[i].i16YMax = balls[i].i16YMin + 5;
+    }
+
+    start = bench_now();
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        hits += old_overlap(bricks.x, bricks.y, 24, 15, 5, bricks_left, &balls[frame % POSITIONS]);
+    }
+    bench_report("rect_batch", "breakout_old", 24, FRAMES, bench_now() - start);
+
+    start = bench_now();
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        hits += rect_batch_overlap_scalar(&bricks, &balls[frame % POSITIONS]) & bricks_left;
+    }
+    bench_report("rect_batch", "breakout_scalar", 24, FRAMES, bench_now() - start);
+
+#if defined(__SSE2__)
+    start = bench_now();
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        hits += rect_batch_overlap_sse2(&bricks, &balls[frame % POSITIONS]) & bricks_left;
+    }
+    bench_report("rect_batch", "breakout_sse2", 24, FRAMES, bench_now() - start);
+#endif
+    bench_sink += hits;
+}
+//-----------------------------------------------------------------------------
+void bench_asteroids(void)
+{
+    RectBatch asteroids[POSITIONS / 64];
+    tRectangle ships[POSITIONS];
+    tRectangle lasers[POSITIONS];
+    RectBatch* batch;
+    uint32_t hits = 0;
+    uint64_t start;
+    uint32_t frame;
+    uint16_t i;
+    uint16_t j;
+
+    // A few sets of asteroids like in the game: above the screen or falling through it
+    srand(3);
+    for (i = 0; i < POSITIONS / 64; i++)
+    {
+        rect_batch_init(&asteroids[i], 9, 9);
+        for (j = 0; j < 24; j++)
+        {
+            rect_batch_add(&asteroids[i], rand() % 119, 128 - rand() % 1000);
+        }
+    }
+    // The ship at the bottom, the laser above it
+    for (i = 0; i < POSITIONS; i++)
+    {
+        ships[i].i16XMin = rand() % 119;
+        ships[i].i16YMin = 113;
+        ships[i].i16XMax = ships[i].i16XMin + 9;
+        ships[i].i16YMax = 122;
+        lasers[i].i16XMin = rand() % 125;
+        lasers[i].i16YMin = rand() % 103;
+        lasers[i].i16XMax = lasers[i].i16XMin + 3;
+        lasers[i].i16YMax = lasers[i].i16YMin + 9;
+    }
+
+    start = bench_now();
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        batch = &asteroids[(frame / POSITIONS) % (POSITIONS / 64)];
+        hits += old_overlap(batch->x, batch->y, 24, 9, 9, 0xFFFFFFFF, &ships[frame % POSITIONS]);
+        hits += old_overlap(batch->x, batch->y, 24, 9, 9, 0xFFFFFFFF, &lasers[frame % POSITIONS]);
+    }
+    bench_report("rect_batch", "asteroids_old", 24, FRAMES, bench_now() - start);
+
+    start = bench_now();
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        batch = &asteroids[(frame / POSITIONS) % (POSITIONS / 64)];
+        hits += rect_batch_overlap_scalar(batch, &ships[frame % POSITIONS]);
+        hits += rect_batch_overlap_scalar(batch, &lasers[frame % POSITIONS]);
+    }
+    bench_report("rect_batch", "asteroids_scalar", 24, FRAMES, bench_now() - start);
+
+#if defined(__SSE2__)
+    start = bench_now();
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        batch = &asteroids[(frame / POSITIONS) % (POSITIONS / 64)];
+        hits += rect_batch_overlap_sse2(batch, &ships[frame % POSITIONS]);
+        hits += rect_batch_overlap_sse2(batch, &lasers[frame % POSITIONS]);
+    }
+    bench_report("rect_batch", "asteroids_sse2", 24, FRAMES, bench_now() - start);
+#endif
+    bench_sink += hits;
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    if (check())
+    {
+        return 1;
+    }
+    bench_breakout();
+    bench_asteroids();
+    return 0;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,203 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: common/ring_buffer.h against the original CircularQueue
+//
+//   gcc -O2 -Ihost/include host/bench/ring_buffer_bench.c -o ring_buffer_bench
+//
+// old_queue is the CircularQueue of lab2_4.1 before the ring buffer (60
+// elements, -1 sentinels, % QUEUESIZE on every step), copied here as it was.
+// ring_buffer is RING_BUFFER with the same element type and 64 elements.
+// *_move is one dequeue and one enqueue on a queue of size elements (a snake
+// of that length moving one step), *_scan steps through all size elements
+// like the collision checks of the snake did.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+
+#include "bench.h"
+#include "../../common/ring_buffer.h"
+
+#define OPS 20000000
+
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+} Coordinat;
+
+//-----------------------------------------------------------------------------
+// Original CircularQueue
+#define OLD_QUEUESIZE 60
+
+typedef struct
+{
+    int16_t front;
+    int16_t rear;
+    Coordinat queue[OLD_QUEUESIZE];
+} OldQueue;
+
+int16_t old_check_full(OldQueue* q)
+{
+    if ((q->front == q->rear + 1) || (q->front == 0 && q->rear == OLD_QUEUESIZE - 1))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+int16_t old_check_empty(OldQueue* q)
+{
+    if (q->front == -1)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+int16_t old_enqueue(OldQueue* q, int16_t x, int16_t y)
+{
+    if (old_check_full(q))
+    {
+        return 0;
+    }
+    else
+    {
+        if (q->front == -1)
+            q->front = 0;
+
+        q->rear = (q->rear + 1) % OLD_QUEUESIZE;
+        q->queue[q->rear].x = x;
+        q->queue[q->rear].y = y;
+        return 1;
+    }
+}
+
+Coordinat old_dequeue(OldQueue* q)
+{
+    Coordinat temp;
+    if (old_check_empty(q))
+    {
+        temp.x = -1;
+        temp.y = -1;
+        return temp;
+    }
+    else
+    {
+        temp.x = q->queue[q->front].x;
+        temp.y = q->queue[q->front].y;
+        if (q->front == q->rear)
+        {
+            q->front = q->rear = -1;
+        }
+        else
+        {
+            q->front = (q->front + 1) % OLD_QUEUESIZE;
+        }
+        return temp;
+    }
+}
+//-----------------------------------------------------------------------------
+
+RING_BUFFER(CoordinatRing, Coordinat, 64)
+
+//-----------------------------------------------------------------------------
+void bench_old(uint16_t size)
+{
+    OldQueue q;
+    Coordinat part;
+    uint64_t start;
+    uint32_t sum = 0;
+    int16_t temp;
+    uint32_t i;
+
+    q.front = -1;
+    q.rear = -1;
+    for (i = 0; i < size; i++)
+    {
+        old_enqueue(&q, i, i);
+    }
+
+    start = bench_now();
+    for (i = 0; i < OPS; i++)
+    {
+        part = old_dequeue(&q);
+        old_enqueue(&q, part.x + 1, part.y);
+    }
+    bench_report("ring_buffer", "old_queue_move", size, OPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < OPS / size; i++)
+    {
+        // Up to and with rear, the way the checks stepped with % QUEUESIZE
+        temp = q.front;
+        while (1)
+        {
+            sum += q.queue[temp].x + q.queue[temp].y;
+            if (temp == q.rear)
+            {
+                break;
+            }
+            temp = (temp + 1) % OLD_QUEUESIZE;
+        }
+        // Moves front and rear so every scan starts somewhere else
+        part = old_dequeue(&q);
+        old_enqueue(&q, part.x, part.y);
+    }
+    bench_report("ring_buffer", "old_queue_scan", size, (uint64_t)(OPS / size) * size, bench_now() - start);
+    bench_sink += sum;
+}
+//-----------------------------------------------------------------------------
+void bench_ring(uint16_t size)
+{
+    CoordinatRing q;
+    Coordinat part = {0, 0};
+    Coordinat* element;
+    uint64_t start;
+    uint32_t sum = 0;
+    uint16_t temp;
+    uint32_t i;
+
+    CoordinatRing_clear(&q);
+    for (i = 0; i < size; i++)
+    {
+        part.x = i;
+        part.y = i;
+        CoordinatRing_enqueue(&q, part);
+    }
+
+    start = bench_now();
+    for (i = 0; i < OPS; i++)
+    {
+        CoordinatRing_dequeue(&q, &part);
+        part.x++;
+        CoordinatRing_enqueue(&q, part);
+    }
+    bench_report("ring_buffer", "ring_buffer_move", size, OPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < OPS / size; i++)
+    {
+        for (temp = q.head; temp != q.tail; temp++)
+        {
+            element = &q.buffer[RING_BUFFER_INDEX(64, temp)];
+            sum += element->x + element->y;
+        }
+        CoordinatRing_dequeue(&q, &part);
+        CoordinatRing_enqueue(&q, part);
+    }
+    bench_report("ring_buffer", "ring_buffer_scan", size, (uint64_t)(OPS / size) * size, bench_now() - start);
+    bench_sink += sum;
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint16_t sizes[] = {1, 8, 30, 59};
+    uint16_t i;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        bench_old(sizes[i]);
+        bench_ring(sizes[i]);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
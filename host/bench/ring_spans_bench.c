@@ -0,0 +1,195 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: span and bulk API of common/ring_buffer.h
+//
+//   gcc -O2 -Ihost/include host/bench/ring_spans_bench.c -o ring_spans_bench
+//
+// *_at is the snake collision scan (the head and a food rectangle against
+// every other segment, the two check_rect_overlap_* loops of lab2_4.1 before
+// the occupancy grid) stepping one element at a time through the mask, the
+// way they were ported to the ring buffer first. *_spans is the same scan as
+// plain linear loops over name_spans. The overlap test is the comparison
+// GrRectOverlapCheck does, written out so both loops can be inlined and
+// unrolled (the call into grlib would hide the difference). The queue content
+// is wrapped around the end of the buffer, so there are always two spans.
+// *_n is moving size elements from one ring buffer to another with
+// enqueue_n/dequeue_n against one enqueue/dequeue per element. ns is per
+// element.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+
+#include "bench.h"
+#include "../../common/ring_buffer.h"
+
+#define ELEMENTS 40000000
+#define PART_SIZE 9
+
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+} Coordinat;
+
+RING_BUFFER(CoordinatRing, Coordinat, 64)
+
+//-----------------------------------------------------------------------------
+// 1 if the part at x, y overlaps the rectangle, like GrRectOverlapCheck
+static inline int16_t part_overlap(int16_t x, int16_t y, int16_t x_min, int16_t y_min, int16_t x_max, int16_t y_max)
+{
+    return !((x + PART_SIZE < x_min) || (x_max < x) || (y + PART_SIZE < y_min) || (y_max < y));
+}
+//-----------------------------------------------------------------------------
+// Number of segments (all but the head) that overlap the head or the food
+uint32_t scan_at(CoordinatRing* q, const Coordinat* food)
+{
+    Coordinat* head = CoordinatRing_at(q, CoordinatRing_count(q) - 1);
+    Coordinat* part;
+    uint32_t hits = 0;
+    uint16_t temp;
+
+    for (temp = 0; temp < CoordinatRing_count(q) - 1; temp++)
+    {
+        part = CoordinatRing_at(q, temp);
+        hits += part_overlap(part->x, part->y, head->x, head->y, head->x + PART_SIZE, head->y + PART_SIZE);
+        hits += part_overlap(part->x, part->y, food->x, food->y, food->x + 5, food->y + 5);
+    }
+    return hits;
+}
+//-----------------------------------------------------------------------------
+uint32_t scan_spans(CoordinatRing* q, const Coordinat* food)
+{
+    Coordinat* head = CoordinatRing_at(q, CoordinatRing_count(q) - 1);
+    Coordinat* spans[2];
+    uint16_t counts[2];
+    uint32_t hits = 0;
+    int16_t span;
+    uint16_t temp;
+
+    CoordinatRing_spans(q, &spans[0], &counts[0], &spans[1], &counts[1]);
+    // Leave out the head, the last element of the last span
+    if (counts[1] != 0)
+    {
+        counts[1]--;
+    }
+    else
+    {
+        counts[0]--;
+    }
+    for (span = 0; span < 2; span++)
+    {
+        for (temp = 0; temp < counts[span]; temp++)
+        {
+            hits += part_overlap(spans[span][temp].x, spans[span][temp].y, head->x, head->y, head->x + PART_SIZE, head->y + PART_SIZE);
+            hits += part_overlap(spans[span][temp].x, spans[span][temp].y, food->x, food->y, food->x + 5, food->y + 5);
+        }
+    }
+    return hits;
+}
+//-----------------------------------------------------------------------------
+void bench_scan(uint16_t size)
+{
+    CoordinatRing q;
+    Coordinat part;
+    Coordinat food = {60, 60};
+    uint32_t rounds = ELEMENTS / size;
+    uint32_t hits_at = 0;
+    uint32_t hits_spans = 0;
+    uint64_t start;
+    uint32_t i;
+
+    // Start half way, so the content wraps around the end of the buffer
+    q.head = 32;
+    q.tail = 32;
+    for (i = 0; i < size; i++)
+    {
+        part.x = 5 + (i % 11) * 11;
+        part.y = 5 + (i / 11) * 11;
+        CoordinatRing_enqueue(&q, part);
+    }
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        food.x = i & 127;
+        hits_at += scan_at(&q, &food);
+    }
+    bench_report("ring_spans", "scan_at", size, (uint64_t)rounds * size, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        food.x = i & 127;
+        hits_spans += scan_spans(&q, &food);
+    }
+    bench_report("ring_spans", "scan_spans", size, (uint64_t)rounds * size, bench_now() - start);
+
+    if (hits_at != hits_spans)
+    {
+        printf("size %u: scan_at found %u overlaps, scan_spans %u\n", size, hits_at, hits_spans);
+    }
+    bench_sink += hits_at;
+}
+//-----------------------------------------------------------------------------
+void bench_bulk(uint16_t size)
+{
+    CoordinatRing from;
+    CoordinatRing to;
+    Coordinat parts[64];
+    Coordinat part = {0, 0};
+    uint32_t rounds = ELEMENTS / size;
+    uint64_t start;
+    uint32_t i;
+    uint16_t j;
+
+    from.head = from.tail = 40;
+    to.head = to.tail = 20;
+    for (j = 0; j < size; j++)
+    {
+        part.x = j;
+        CoordinatRing_enqueue(&from, part);
+    }
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        for (j = 0; j < size; j++)
+        {
+            CoordinatRing_dequeue(&from, &part);
+            CoordinatRing_enqueue(&to, part);
+        }
+        for (j = 0; j < size; j++)
+        {
+            CoordinatRing_dequeue(&to, &part);
+            CoordinatRing_enqueue(&from, part);
+        }
+    }
+    bench_report("ring_spans", "move_one", size, (uint64_t)rounds * size * 2, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < rounds; i++)
+    {
+        CoordinatRing_dequeue_n(&from, parts, size);
+        CoordinatRing_enqueue_n(&to, parts, size);
+        CoordinatRing_dequeue_n(&to, parts, size);
+        CoordinatRing_enqueue_n(&from, parts, size);
+    }
+    bench_report("ring_spans", "move_n", size, (uint64_t)rounds * size * 2, bench_now() - start);
+    bench_sink += CoordinatRing_at(&from, 0)->x;
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint16_t sizes[] = {8, 32, 63};
+    uint16_t i;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        bench_scan(sizes[i]);
+    }
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        bench_bulk(sizes[i]);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
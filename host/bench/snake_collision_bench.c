@@ -0,0 +1,250 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: snake collision checks, occupancy grid against the scans
+//
+//   gcc -O2 -Ihost/include host/bench/snake_collision_bench.c host/src/*.c -lm -o snake_collision_bench
+//
+// One frame is what the snake loop does every step: move (dequeue the tail,
+// enqueue the new head), check the head against the body and check a food
+// rectangle against the body. grid is lab2_4.1/circular_queue.h as used by
+// main.c; scan is the original CircularQueue and the two loops over every
+// segment with GrRectOverlapCheck that main.c had before the grid (with room
+// for 128 parts instead of 60, so it holds the same snakes).
+//
+// The snake runs around a fixed cycle through 110 of the 121 cells (all of
+// the 11x10 cells of the upper rows), so it never dies; 109 is the longest
+// snake that can still move on it. The food is put on random spots of the
+// screen. Both versions get the same moves and food and have to give the same
+// answers, the benchmark stops if they do not.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "grlib/grlib.h"
+
+#include "bench.h"
+#include "../../lab2_4.1/circular_queue.h"
+
+#define FRAMES 2000000
+#define PART_SIZE 9
+#define FOOD_SIZE 5
+#define CYCLE_CELLS 110
+
+//-----------------------------------------------------------------------------
+// Original CircularQueue and collision checks of lab2_4.1
+#define OLD_QUEUESIZE 128
+
+typedef struct
+{
+    int16_t front;
+    int16_t rear;
+    Coordinat queue[OLD_QUEUESIZE];
+} OldQueue;
+
+void old_enqueue(OldQueue* q, int16_t x, int16_t y)
+{
+    if (q->front == -1)
+        q->front = 0;
+    q->rear = (q->rear + 1) % OLD_QUEUESIZE;
+    q->queue[q->rear].x = x;
+    q->queue[q->rear].y = y;
+}
+
+void old_dequeue(OldQueue* q)
+{
+    if (q->front == q->rear)
+    {
+        q->front = q->rear = -1;
+    }
+    else
+    {
+        q->front = (q->front + 1) % OLD_QUEUESIZE;
+    }
+}
+
+int16_t old_check_rect_overlap_food(OldQueue* q, int16_t size, tRectangle food_rectangle)
+{
+    tRectangle snake_part;
+    int16_t temp = q->front;
+
+    while (temp != q->rear)
+    {
+        snake_part.i16XMin = q->queue[temp].x;
+        snake_part.i16YMin = q->queue[temp].y;
+        snake_part.i16XMax = snake_part.i16XMin + size;
+        snake_part.i16YMax = snake_part.i16YMin + size;
+        if(GrRectOverlapCheck(&food_rectangle, &snake_part))
+        {
+            return 1;
+        }
+        temp = (temp + 1) % OLD_QUEUESIZE;
+    }
+    return 0;
+}
+
+int16_t old_check_rect_overlap_snake(OldQueue* q, int16_t size)
+{
+    tRectangle snake_head;
+    tRectangle snake_part;
+    int16_t temp = q->front;
+
+    snake_head.i16XMin = q->queue[q->rear].x;
+    snake_head.i16YMin = q->queue[q->rear].y;
+    snake_head.i16XMax = snake_head.i16XMin + size;
+    snake_head.i16YMax = snake_head.i16YMin + size;
+
+    while (temp != q->rear)
+    {
+        snake_part.i16XMin = q->queue[temp].x;
+        snake_part.i16YMin = q->queue[temp].y;
+        snake_part.i16XMax = snake_part.i16XMin + size;
+        snake_part.i16YMax = snake_part.i16YMin + size;
+        if(GrRectOverlapCheck(&snake_head, &snake_part))
+        {
+            return 1;
+        }
+        temp = (temp + 1) % OLD_QUEUESIZE;
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+
+// Upper left corners of the cells of the cycle, in the order the snake goes
+Coordinat cycle[CYCLE_CELLS];
+// Food rectangles, the same for both versions
+#define FOOD_COUNT 1024
+tRectangle foods[FOOD_COUNT];
+
+//-----------------------------------------------------------------------------
+// Row 0 left to right, then rows 1 to 9 as a serpentine over columns 10 to 1,
+// then column 0 back up to row 1, next to where it started
+void cycle_init(void)
+{
+    uint16_t count = 0;
+    int16_t column;
+    int16_t row;
+
+    for (column = 0; column < GRID_SIZE; column++)
+    {
+        cycle[count++] = cell_coordinat(column);
+    }
+    for (row = 1; row < 10; row++)
+    {
+        for (column = 1; column < GRID_SIZE; column++)
+        {
+            cycle[count++] = cell_coordinat(row * GRID_SIZE + ((row & 1) ? GRID_SIZE - column : column));
+        }
+    }
+    for (row = 9; row >= 1; row--)
+    {
+        cycle[count++] = cell_coordinat(row * GRID_SIZE);
+    }
+}
+//-----------------------------------------------------------------------------
+void foods_init(void)
+{
+    uint16_t i;
+
+    srand(1);
+    for (i = 0; i < FOOD_COUNT; i++)
+    {
+        foods[i].i16XMin = 6 + rand() % 112;
+        foods[i].i16YMin = 6 + rand() % 112;
+        foods[i].i16XMax = foods[i].i16XMin + FOOD_SIZE;
+        foods[i].i16YMax = foods[i].i16YMin + FOOD_SIZE;
+    }
+}
+//-----------------------------------------------------------------------------
+// Frames of a snake of length parts with both versions, returns 1 if they disagree
+int16_t bench_length(uint16_t length)
+{
+    CircularQueue grid;
+    OldQueue old;
+    uint64_t start;
+    uint32_t hits_grid = 0;
+    uint32_t hits_old = 0;
+    tRectangle* food;
+    uint32_t frame;
+    uint16_t i;
+
+    // Checked first, the timed loops below do not compare
+    empty_queue(&grid);
+    old.front = -1;
+    old.rear = -1;
+    for (i = 0; i < length; i++)
+    {
+        enqueue(&grid, cycle[i].x, cycle[i].y);
+        old_enqueue(&old, cycle[i].x, cycle[i].y);
+    }
+    for (frame = 0; frame < CYCLE_CELLS * FOOD_COUNT / 8; frame++)
+    {
+        dequeue(&grid);
+        old_dequeue(&old);
+        i = (frame + length) % CYCLE_CELLS;
+        enqueue(&grid, cycle[i].x, cycle[i].y);
+        old_enqueue(&old, cycle[i].x, cycle[i].y);
+        food = &foods[frame % FOOD_COUNT];
+        if ((check_occupied_rect(&grid, PART_SIZE, food->i16XMin, food->i16YMin, food->i16XMax, food->i16YMax, head_cell(&grid)) !=
+                old_check_rect_overlap_food(&old, PART_SIZE, *food)) ||
+                (grid.overlap != old_check_rect_overlap_snake(&old, PART_SIZE)))
+        {
+            printf("length %u frame %u: grid and scan disagree\n", length, frame);
+            return 1;
+        }
+    }
+
+    empty_queue(&grid);
+    for (i = 0; i < length; i++)
+    {
+        enqueue(&grid, cycle[i].x, cycle[i].y);
+    }
+    start = bench_now();
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        dequeue(&grid);
+        i = (frame + length) % CYCLE_CELLS;
+        enqueue(&grid, cycle[i].x, cycle[i].y);
+        hits_grid += grid.overlap;
+        food = &foods[frame % FOOD_COUNT];
+        hits_grid += check_occupied_rect(&grid, PART_SIZE, food->i16XMin, food->i16YMin, food->i16XMax, food->i16YMax, head_cell(&grid));
+    }
+    bench_report("snake_collision", "grid", length, FRAMES, bench_now() - start);
+
+    old.front = -1;
+    old.rear = -1;
+    for (i = 0; i < length; i++)
+    {
+        old_enqueue(&old, cycle[i].x, cycle[i].y);
+    }
+    start = bench_now();
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        old_dequeue(&old);
+        i = (frame + length) % CYCLE_CELLS;
+        old_enqueue(&old, cycle[i].x, cycle[i].y);
+        hits_old += old_check_rect_overlap_snake(&old, PART_SIZE);
+        food = &foods[frame % FOOD_COUNT];
+        hits_old += old_check_rect_overlap_food(&old, PART_SIZE, *food);
+    }
+    bench_report("snake_collision", "scan", length, FRAMES, bench_now() - start);
+    bench_sink += hits_grid + hits_old;
+    return 0;
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint16_t lengths[] = {1, 2, 4, 8, 16, 32, 64, CYCLE_CELLS - 1};
+    uint16_t i;
+
+    cycle_init();
+    foods_init();
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        if (bench_length(lengths[i]))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,139 @@
+//-----------------------------------------------------------------------------
+// Host benchmark: lab2_4.1/unrolled_list.h against the _node list of linked_list.h
+//
+//   gcc -O2 -Ihost/include host/bench/unrolled_list_bench.c -o unrolled_list_bench
+//
+// Both lists get the same size coordinates with insert_at_end, then size
+// steps of the snake (insert_at_end + delete_at_begin), which leaves the
+// chunks as full as they get in a game. Cases:
+//   hit        search_list of a random coordinat in the list, ns per search
+//   walk       reading every coordinat from head to tail, ns per coordinat
+// unrolled_* is UnrolledList, node_* is LinkedList (without an index).
+// Memory is reported as bytes per coordinat: sizeof(struct _chunk) over
+// the coordinats in a chunk at the fill measured after the steps, against
+// sizeof(struct _node).
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#define ULIST_POOL_SIZE 4096
+#define NODE_POOL_SIZE 4096
+#include "../../lab2_4.1/unrolled_list.h"
+#include "../../lab2_4.1/linked_list.h"
+
+#define OPS 4000000
+// Coordinats walked by the searches and walks per size
+#define WALK 400000000
+
+// Coordinat of element i
+#define ELEMENT_X(i) ((int16_t)((i) % 127))
+#define ELEMENT_Y(i) ((int16_t)((i) / 127))
+
+UnrolledList unrolled_list;
+LinkedList node_list;
+// Random element numbers, the same for both lists
+uint32_t order[OPS];
+
+//-----------------------------------------------------------------------------
+void bench_size(uint32_t size)
+{
+    uint32_t searches = WALK / size;
+    uint32_t walks = 2 * WALK / size;
+    struct _chunk *chunk;
+    struct _node *node;
+    uint32_t chunks = 0;
+    uint64_t start;
+    uint32_t hits = 0;
+    uint32_t sum = 0;
+    uint32_t i;
+    uint16_t j;
+
+    if (searches > OPS)
+    {
+        searches = OPS;
+    }
+    for (i = 0; i < searches; i++)
+    {
+        order[i] = rand() % size;
+    }
+    ulist_init(&unrolled_list);
+    init_list(&node_list);
+    for (i = 0; i < 2 * size; i++)
+    {
+        ulist_insert_at_end(&unrolled_list, ELEMENT_X(i % size), ELEMENT_Y(i % size));
+        insert_at_end(&node_list, ELEMENT_X(i % size), ELEMENT_Y(i % size));
+        if (i >= size)
+        {
+            ulist_delete_at_begin(&unrolled_list);
+            delete_at_begin(&node_list);
+        }
+    }
+
+    start = bench_now();
+    for (i = 0; i < searches; i++)
+    {
+        hits += ulist_search_list(&unrolled_list, ELEMENT_X(order[i]), ELEMENT_Y(order[i]));
+    }
+    bench_report("unrolled_list", "unrolled_hit", size, searches, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < searches; i++)
+    {
+        hits += search_list(&node_list, ELEMENT_X(order[i]), ELEMENT_Y(order[i]));
+    }
+    bench_report("unrolled_list", "node_hit", size, searches, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < walks; i++)
+    {
+        for (chunk = unrolled_list.head; chunk != NULL; chunk = chunk->next)
+        {
+            for (j = 0; j < chunk->count; j++)
+            {
+                sum += chunk->x[j] + chunk->y[j];
+            }
+        }
+    }
+    bench_report("unrolled_list", "unrolled_walk", size, (uint64_t)walks * size, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < walks; i++)
+    {
+        for (node = node_list.head; node != NULL; node = node->next)
+        {
+            sum += node->x + node->y;
+        }
+    }
+    bench_report("unrolled_list", "node_walk", size, (uint64_t)walks * size, bench_now() - start);
+
+    for (chunk = unrolled_list.head; chunk != NULL; chunk = chunk->next)
+    {
+        chunks++;
+    }
+    bench_report_bytes("unrolled_list", "unrolled", size, (double)chunks * sizeof(struct _chunk) / size);
+    bench_report_bytes("unrolled_list", "node", size, sizeof(struct _node));
+
+    if (unrolled_list.count != size || node_list.count != size || hits != 2 * searches)
+    {
+        printf("size %u: lists of %u and %u, %u hits\n", size, unrolled_list.count, node_list.count, hits);
+    }
+    bench_sink += sum;
+    ulist_delete_list(&unrolled_list);
+    delete_list(&node_list);
+}
+//-----------------------------------------------------------------------------
+int main(void)
+{
+    const uint32_t sizes[] = {16, 128, 1024, 4000};
+    uint16_t i;
+
+    srand(1);
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        bench_size(sizes[i]);
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
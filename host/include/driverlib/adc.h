@@ -0,0 +1,75 @@
+#ifndef __DRIVERLIB_ADC_H__
+#define __DRIVERLIB_ADC_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/adc.h
+//-----------------------------------------------------------------------------
+#define ADC_TRIGGER_PROCESSOR   0x00000000
+#define ADC_TRIGGER_TIMER       0x00000005
+#define ADC_TRIGGER_PWM0        0x00000006
+#define ADC_TRIGGER_PWM1        0x00000007
+#define ADC_TRIGGER_PWM2        0x00000008
+#define ADC_TRIGGER_PWM3        0x00000009
+#define ADC_TRIGGER_ALWAYS      0x0000000F
+
+#define ADC_CTL_TS              0x00000080
+#define ADC_CTL_IE              0x00000040
+#define ADC_CTL_END             0x00000020
+#define ADC_CTL_D               0x00000010
+#define ADC_CTL_CH0             0x00000000
+#define ADC_CTL_CH1             0x00000001
+#define ADC_CTL_CH2             0x00000002
+#define ADC_CTL_CH3             0x00000003
+#define ADC_CTL_CH4             0x00000004
+#define ADC_CTL_CH5             0x00000005
+#define ADC_CTL_CH6             0x00000006
+#define ADC_CTL_CH7             0x00000007
+#define ADC_CTL_CH8             0x00000008
+#define ADC_CTL_CH9             0x00000009
+#define ADC_CTL_CH10            0x0000000A
+#define ADC_CTL_CH11            0x0000000B
+#define ADC_CTL_CH12            0x0000000C
+#define ADC_CTL_CH13            0x0000000D
+#define ADC_CTL_CH14            0x0000000E
+#define ADC_CTL_CH15            0x0000000F
+#define ADC_CTL_CH16            0x00000100
+#define ADC_CTL_CH17            0x00000101
+#define ADC_CTL_CH18            0x00000102
+#define ADC_CTL_CH19            0x00000103
+
+// ADCIntEnableEx flags: sequence done, uDMA transfer of the sequence done
+#define ADC_INT_SS0             0x00000001
+#define ADC_INT_SS1             0x00000002
+#define ADC_INT_SS2             0x00000004
+#define ADC_INT_SS3             0x00000008
+#define ADC_INT_DMA_SS0         0x00000100
+#define ADC_INT_DMA_SS1         0x00000200
+#define ADC_INT_DMA_SS2         0x00000400
+#define ADC_INT_DMA_SS3         0x00000800
+
+extern void ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                                 uint32_t ui32Trigger, uint32_t ui32Priority);
+extern void ADCSequenceStepConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                                     uint32_t ui32Step, uint32_t ui32Config);
+extern void ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCProcessorTrigger(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern uint32_t ADCIntStatus(uint32_t ui32Base, uint32_t ui32SequenceNum, bool bMasked);
+extern void ADCIntClear(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCIntEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCIntDisable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern int32_t ADCSequenceDataGet(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                                  uint32_t *pui32Buffer);
+extern void ADCIntRegister(uint32_t ui32Base, uint32_t ui32SequenceNum, void (*pfnHandler)(void));
+extern void ADCIntUnregister(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCIntEnableEx(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern void ADCIntDisableEx(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern uint32_t ADCIntStatusEx(uint32_t ui32Base, bool bMasked);
+extern void ADCIntClearEx(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern void ADCSequenceDMAEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void ADCSequenceDMADisable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+
+#endif
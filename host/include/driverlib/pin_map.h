@@ -0,0 +1,11 @@
+#ifndef __DRIVERLIB_PIN_MAP_H__
+#define __DRIVERLIB_PIN_MAP_H__
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/pin_map.h (TM4C1294NCPDT), only the pins in use
+//-----------------------------------------------------------------------------
+#define GPIO_PA0_U0RX           0x00000001
+#define GPIO_PA1_U0TX           0x00000401
+#define GPIO_PF2_M0PWM2         0x00050806
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef __DRIVERLIB_PWM_H__
+#define __DRIVERLIB_PWM_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/pwm.h
+//-----------------------------------------------------------------------------
+#define PWM_GEN_MODE_DOWN       0x00000000
+#define PWM_GEN_MODE_UP_DOWN    0x00000002
+#define PWM_GEN_MODE_SYNC       0x00000038
+#define PWM_GEN_MODE_NO_SYNC    0x00000000
+#define PWM_GEN_MODE_DBG_RUN    0x00000004
+#define PWM_GEN_MODE_DBG_STOP   0x00000000
+
+#define PWM_GEN_0               0x00000040
+#define PWM_GEN_1               0x00000080
+#define PWM_GEN_2               0x000000C0
+#define PWM_GEN_3               0x00000100
+
+#define PWM_OUT_0               0x00000040
+#define PWM_OUT_1               0x00000041
+#define PWM_OUT_2               0x00000082
+#define PWM_OUT_3               0x00000083
+#define PWM_OUT_4               0x000000C4
+#define PWM_OUT_5               0x000000C5
+#define PWM_OUT_6               0x00000106
+#define PWM_OUT_7               0x00000107
+
+// PWMGenIntTrigEnable: ADC trigger when the counter is 0 or at the load value
+#define PWM_TR_CNT_ZERO         0x00000100
+#define PWM_TR_CNT_LOAD         0x00000200
+
+// PWMClockSet: PWM clock is the system clock divided by 1 to 64
+#define PWM_SYSCLK_DIV_1        0x00000000
+#define PWM_SYSCLK_DIV_2        0x00000100
+#define PWM_SYSCLK_DIV_4        0x00000101
+#define PWM_SYSCLK_DIV_8        0x00000102
+#define PWM_SYSCLK_DIV_16       0x00000103
+#define PWM_SYSCLK_DIV_32       0x00000104
+#define PWM_SYSCLK_DIV_64       0x00000105
+
+#define PWM_OUT_0_BIT           0x00000001
+#define PWM_OUT_1_BIT           0x00000002
+#define PWM_OUT_2_BIT           0x00000004
+#define PWM_OUT_3_BIT           0x00000008
+#define PWM_OUT_4_BIT           0x00000010
+#define PWM_OUT_5_BIT           0x00000020
+#define PWM_OUT_6_BIT           0x00000040
+#define PWM_OUT_7_BIT           0x00000080
+
+extern void PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config);
+extern void PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period);
+extern uint32_t PWMGenPeriodGet(uint32_t ui32Base, uint32_t ui32Gen);
+extern void PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen);
+extern void PWMGenDisable(uint32_t ui32Base, uint32_t ui32Gen);
+extern void PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width);
+extern uint32_t PWMPulseWidthGet(uint32_t ui32Base, uint32_t ui32PWMOut);
+extern void PWMGenIntTrigEnable(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32IntTrig);
+extern void PWMGenIntTrigDisable(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32IntTrig);
+extern void PWMClockSet(uint32_t ui32Base, uint32_t ui32Config);
+extern uint32_t PWMClockGet(uint32_t ui32Base);
+extern void PWMOutputState(uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable);
+
+#endif
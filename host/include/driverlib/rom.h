@@ -0,0 +1,50 @@
+#ifndef __DRIVERLIB_ROM_H__
+#define __DRIVERLIB_ROM_H__
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/rom.h, there is no ROM so ROM_ calls go to the host driverlib
+//-----------------------------------------------------------------------------
+#define ROM_SysCtlClockFreqSet         SysCtlClockFreqSet
+#define ROM_SysCtlPeripheralEnable     SysCtlPeripheralEnable
+#define ROM_SysCtlPeripheralDisable    SysCtlPeripheralDisable
+#define ROM_SysCtlPeripheralReset      SysCtlPeripheralReset
+#define ROM_SysCtlPeripheralReady      SysCtlPeripheralReady
+#define ROM_SysCtlPWMClockSet          SysCtlPWMClockSet
+#define ROM_SysCtlDelay                SysCtlDelay
+#define ROM_GPIOPinConfigure           GPIOPinConfigure
+#define ROM_GPIOPinTypeADC             GPIOPinTypeADC
+#define ROM_GPIOPinTypeGPIOInput       GPIOPinTypeGPIOInput
+#define ROM_GPIOPinTypeGPIOOutput      GPIOPinTypeGPIOOutput
+#define ROM_GPIOPinTypePWM             GPIOPinTypePWM
+#define ROM_GPIOPinTypeSSI             GPIOPinTypeSSI
+#define ROM_GPIOPinTypeUART            GPIOPinTypeUART
+#define ROM_GPIOPinRead                GPIOPinRead
+#define ROM_GPIOPinWrite               GPIOPinWrite
+#define ROM_ADCSequenceConfigure       ADCSequenceConfigure
+#define ROM_ADCSequenceStepConfigure   ADCSequenceStepConfigure
+#define ROM_ADCSequenceEnable          ADCSequenceEnable
+#define ROM_ADCSequenceDisable         ADCSequenceDisable
+#define ROM_ADCProcessorTrigger        ADCProcessorTrigger
+#define ROM_ADCIntStatus               ADCIntStatus
+#define ROM_ADCIntClear                ADCIntClear
+#define ROM_ADCIntEnable               ADCIntEnable
+#define ROM_ADCIntDisable              ADCIntDisable
+#define ROM_ADCSequenceDataGet         ADCSequenceDataGet
+#define ROM_PWMGenConfigure            PWMGenConfigure
+#define ROM_PWMGenPeriodSet            PWMGenPeriodSet
+#define ROM_PWMGenPeriodGet            PWMGenPeriodGet
+#define ROM_PWMGenEnable               PWMGenEnable
+#define ROM_PWMGenDisable              PWMGenDisable
+#define ROM_PWMPulseWidthSet           PWMPulseWidthSet
+#define ROM_PWMPulseWidthGet           PWMPulseWidthGet
+#define ROM_PWMOutputState             PWMOutputState
+#define ROM_UARTClockSourceSet         UARTClockSourceSet
+#define ROM_UARTCharsAvail             UARTCharsAvail
+#define ROM_UARTCharGet                UARTCharGet
+#define ROM_UARTCharPut                UARTCharPut
+#define ROM_IntMasterEnable            IntMasterEnable
+#define ROM_IntMasterDisable           IntMasterDisable
+#define ROM_IntEnable                  IntEnable
+#define ROM_IntDisable                 IntDisable
+
+#endif
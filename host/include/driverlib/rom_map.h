@@ -0,0 +1,52 @@
+#ifndef __DRIVERLIB_ROM_MAP_H__
+#define __DRIVERLIB_ROM_MAP_H__
+
+#include "driverlib/rom.h"
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/rom_map.h, every MAP_ call goes to the host driverlib
+//-----------------------------------------------------------------------------
+#define MAP_SysCtlClockFreqSet         SysCtlClockFreqSet
+#define MAP_SysCtlPeripheralEnable     SysCtlPeripheralEnable
+#define MAP_SysCtlPeripheralDisable    SysCtlPeripheralDisable
+#define MAP_SysCtlPeripheralReset      SysCtlPeripheralReset
+#define MAP_SysCtlPeripheralReady      SysCtlPeripheralReady
+#define MAP_SysCtlPWMClockSet          SysCtlPWMClockSet
+#define MAP_SysCtlDelay                SysCtlDelay
+#define MAP_GPIOPinConfigure           GPIOPinConfigure
+#define MAP_GPIOPinTypeADC             GPIOPinTypeADC
+#define MAP_GPIOPinTypeGPIOInput       GPIOPinTypeGPIOInput
+#define MAP_GPIOPinTypeGPIOOutput      GPIOPinTypeGPIOOutput
+#define MAP_GPIOPinTypePWM             GPIOPinTypePWM
+#define MAP_GPIOPinTypeSSI             GPIOPinTypeSSI
+#define MAP_GPIOPinTypeUART            GPIOPinTypeUART
+#define MAP_GPIOPinRead                GPIOPinRead
+#define MAP_GPIOPinWrite               GPIOPinWrite
+#define MAP_ADCSequenceConfigure       ADCSequenceConfigure
+#define MAP_ADCSequenceStepConfigure   ADCSequenceStepConfigure
+#define MAP_ADCSequenceEnable          ADCSequenceEnable
+#define MAP_ADCSequenceDisable         ADCSequenceDisable
+#define MAP_ADCProcessorTrigger        ADCProcessorTrigger
+#define MAP_ADCIntStatus               ADCIntStatus
+#define MAP_ADCIntClear                ADCIntClear
+#define MAP_ADCIntEnable               ADCIntEnable
+#define MAP_ADCIntDisable              ADCIntDisable
+#define MAP_ADCSequenceDataGet         ADCSequenceDataGet
+#define MAP_PWMGenConfigure            PWMGenConfigure
+#define MAP_PWMGenPeriodSet            PWMGenPeriodSet
+#define MAP_PWMGenPeriodGet            PWMGenPeriodGet
+#define MAP_PWMGenEnable               PWMGenEnable
+#define MAP_PWMGenDisable              PWMGenDisable
+#define MAP_PWMPulseWidthSet           PWMPulseWidthSet
+#define MAP_PWMPulseWidthGet           PWMPulseWidthGet
+#define MAP_PWMOutputState             PWMOutputState
+#define MAP_UARTClockSourceSet         UARTClockSourceSet
+#define MAP_UARTCharsAvail             UARTCharsAvail
+#define MAP_UARTCharGet                UARTCharGet
+#define MAP_UARTCharPut                UARTCharPut
+#define MAP_IntMasterEnable            IntMasterEnable
+#define MAP_IntMasterDisable           IntMasterDisable
+#define MAP_IntEnable                  IntEnable
+#define MAP_IntDisable                 IntDisable
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef __DRIVERLIB_SYSCTL_H__
+#define __DRIVERLIB_SYSCTL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/sysctl.h
+//-----------------------------------------------------------------------------
+#define SYSCTL_PERIPH_ADC0      0xf0003800
+#define SYSCTL_PERIPH_ADC1      0xf0003801
+#define SYSCTL_PERIPH_GPIOA     0xf0000800
+#define SYSCTL_PERIPH_GPIOB     0xf0000801
+#define SYSCTL_PERIPH_GPIOC     0xf0000802
+#define SYSCTL_PERIPH_GPIOD     0xf0000803
+#define SYSCTL_PERIPH_GPIOE     0xf0000804
+#define SYSCTL_PERIPH_GPIOF     0xf0000805
+#define SYSCTL_PERIPH_GPIOG     0xf0000806
+#define SYSCTL_PERIPH_GPIOH     0xf0000807
+#define SYSCTL_PERIPH_GPIOJ     0xf0000808
+#define SYSCTL_PERIPH_GPIOK     0xf0000809
+#define SYSCTL_PERIPH_GPIOL     0xf000080a
+#define SYSCTL_PERIPH_GPIOM     0xf000080b
+#define SYSCTL_PERIPH_GPION     0xf000080c
+#define SYSCTL_PERIPH_GPIOP     0xf000080d
+#define SYSCTL_PERIPH_GPIOQ     0xf000080e
+#define SYSCTL_PERIPH_PWM0      0xf0004000
+#define SYSCTL_PERIPH_SSI2      0xf0001c02
+#define SYSCTL_PERIPH_TIMER0    0xf0000400
+#define SYSCTL_PERIPH_TIMER1    0xf0000401
+#define SYSCTL_PERIPH_UART0     0xf0001800
+#define SYSCTL_PERIPH_UDMA      0xf0000c00
+
+#define SYSCTL_XTAL_25MHZ       0x00000680
+#define SYSCTL_OSC_MAIN         0x00000000
+#define SYSCTL_OSC_INT          0x00000010
+#define SYSCTL_USE_PLL          0x00000000
+#define SYSCTL_USE_OSC          0x00003800
+#define SYSCTL_CFG_VCO_480      0xF1000000
+#define SYSCTL_CFG_VCO_320      0xF0000000
+
+#define SYSCTL_PWMDIV_1         0x00000000
+#define SYSCTL_PWMDIV_2         0x00000100
+#define SYSCTL_PWMDIV_4         0x00000101
+#define SYSCTL_PWMDIV_8         0x00000102
+#define SYSCTL_PWMDIV_16        0x00000103
+#define SYSCTL_PWMDIV_32        0x00000104
+#define SYSCTL_PWMDIV_64        0x00000105
+
+extern uint32_t SysCtlClockFreqSet(uint32_t ui32Config, uint32_t ui32SysClock);
+extern void SysCtlPeripheralEnable(uint32_t ui32Peripheral);
+extern void SysCtlPeripheralDisable(uint32_t ui32Peripheral);
+extern void SysCtlPeripheralReset(uint32_t ui32Peripheral);
+extern bool SysCtlPeripheralReady(uint32_t ui32Peripheral);
+extern void SysCtlPWMClockSet(uint32_t ui32Config);
+extern void SysCtlDelay(uint32_t ui32Count);
+extern void SysCtlSleep(void);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef __DRIVERLIB_TIMER_H__
+#define __DRIVERLIB_TIMER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/timer.h
+//-----------------------------------------------------------------------------
+#define TIMER_CFG_ONE_SHOT      0x00000021
+#define TIMER_CFG_PERIODIC      0x00000022
+
+#define TIMER_A                 0x000000FF
+#define TIMER_B                 0x0000FF00
+#define TIMER_BOTH              0x0000FFFF
+
+#define TIMER_TIMA_TIMEOUT      0x00000001
+
+#define TIMER_ADC_TIMEOUT_A     0x00000001
+
+extern void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config);
+extern void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+extern uint32_t TimerLoadGet(uint32_t ui32Base, uint32_t ui32Timer);
+extern void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer);
+extern void TimerDisable(uint32_t ui32Base, uint32_t ui32Timer);
+extern void TimerControlTrigger(uint32_t ui32Base, uint32_t ui32Timer, bool bEnable);
+extern void TimerADCEventSet(uint32_t ui32Base, uint32_t ui32ADCEvent);
+extern void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern void TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked);
+extern void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+extern void TimerIntRegister(uint32_t ui32Base, uint32_t ui32Timer, void (*pfnHandler)(void));
+extern void TimerIntUnregister(uint32_t ui32Base, uint32_t ui32Timer);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef __DRIVERLIB_UART_H__
+#define __DRIVERLIB_UART_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/uart.h, UART0 is stdin/stdout
+//-----------------------------------------------------------------------------
+#define UART_CLOCK_SYSTEM       0x00000000
+#define UART_CLOCK_PIOSC        0x00000005
+
+extern void UARTClockSourceSet(uint32_t ui32Base, uint32_t ui32Source);
+extern bool UARTCharsAvail(uint32_t ui32Base);
+extern int32_t UARTCharGet(uint32_t ui32Base);
+extern void UARTCharPut(uint32_t ui32Base, unsigned char ucData);
+
+#endif
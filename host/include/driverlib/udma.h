@@ -0,0 +1,77 @@
+#ifndef __DRIVERLIB_UDMA_H__
+#define __DRIVERLIB_UDMA_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Host stand-in for driverlib/udma.h
+//-----------------------------------------------------------------------------
+#define UDMA_ATTR_USEBURST      0x00000001
+#define UDMA_ATTR_ALTSELECT     0x00000002
+#define UDMA_ATTR_HIGH_PRIORITY 0x00000004
+#define UDMA_ATTR_REQMASK       0x00000008
+#define UDMA_ATTR_ALL           0x0000000F
+
+#define UDMA_MODE_STOP          0x00000000
+#define UDMA_MODE_BASIC         0x00000001
+#define UDMA_MODE_AUTO          0x00000002
+#define UDMA_MODE_PINGPONG      0x00000003
+#define UDMA_MODE_MEM_SCATTER_GATHER 0x00000004
+#define UDMA_MODE_PER_SCATTER_GATHER 0x00000006
+#define UDMA_MODE_ALT_SELECT    0x00000001
+
+#define UDMA_DST_INC_8          0x00000000
+#define UDMA_DST_INC_16         0x40000000
+#define UDMA_DST_INC_32         0x80000000
+#define UDMA_DST_INC_NONE       0xc0000000
+#define UDMA_SRC_INC_8          0x00000000
+#define UDMA_SRC_INC_16         0x04000000
+#define UDMA_SRC_INC_32         0x08000000
+#define UDMA_SRC_INC_NONE       0x0c000000
+#define UDMA_SIZE_8             0x00000000
+#define UDMA_SIZE_16            0x11000000
+#define UDMA_SIZE_32            0x22000000
+#define UDMA_ARB_1              0x00000000
+#define UDMA_ARB_2              0x00004000
+#define UDMA_ARB_4              0x00008000
+#define UDMA_ARB_8              0x0000c000
+#define UDMA_ARB_16             0x00010000
+#define UDMA_ARB_32             0x00014000
+#define UDMA_ARB_64             0x00018000
+#define UDMA_ARB_128            0x0001c000
+#define UDMA_ARB_256            0x00020000
+#define UDMA_ARB_512            0x00024000
+#define UDMA_ARB_1024           0x00028000
+
+// Channel structure select, or'ed with the channel number
+#define UDMA_PRI_SELECT         0x00000000
+#define UDMA_ALT_SELECT         0x00000020
+
+// Channel assignments, encoding << 16 | channel
+#define UDMA_CH13_SSI2TX        0x0002000D
+#define UDMA_CH14_ADC0_0        0x0000000E
+#define UDMA_CH15_ADC0_1        0x0000000F
+#define UDMA_CH16_ADC0_2        0x00000010
+#define UDMA_CH17_ADC0_3        0x00000011
+#define UDMA_CH24_ADC1_0        0x00000018
+#define UDMA_CH25_ADC1_1        0x00000019
+#define UDMA_CH26_ADC1_2        0x0000001A
+#define UDMA_CH27_ADC1_3        0x0000001B
+
+extern void uDMAEnable(void);
+extern void uDMADisable(void);
+extern void uDMAControlBaseSet(void *pControlTable);
+extern void uDMAChannelAssign(uint32_t ui32Mapping);
+extern void uDMAChannelAttributeEnable(uint32_t ui32ChannelNum, uint32_t ui32Attr);
+extern void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr);
+extern void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control);
+extern void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                                   void *pvSrcAddr, void *pvDstAddr, uint32_t ui32TransferSize);
+extern void uDMAChannelEnable(uint32_t ui32ChannelNum);
+extern void uDMAChannelDisable(uint32_t ui32ChannelNum);
+extern bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum);
+extern uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex);
+extern uint32_t uDMAChannelSizeGet(uint32_t ui32ChannelStructIndex);
+
+#endif
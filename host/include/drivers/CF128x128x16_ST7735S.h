@@ -0,0 +1,19 @@
+#ifndef __DRIVERS_CF128X128X16_ST7735S_H__
+#define __DRIVERS_CF128X128X16_ST7735S_H__
+
+#include <stdint.h>
+
+#include "grlib/grlib.h"
+
+//-----------------------------------------------------------------------------
+// Host stand-in for drivers/CF128x128x16_ST7735S.h (128x128 LCD on the BoosterPack)
+//-----------------------------------------------------------------------------
+#define LCD_HORIZONTAL_MAX      128
+#define LCD_VERTICAL_MAX        128
+
+extern const tDisplay g_sCF128x128x16_ST7735S;
+
+extern void CF128x128x16_ST7735SInit(uint32_t ui32SysClock);
+extern void CF128x128x16_ST7735SClear(uint32_t ui32Color);
+
+#endif
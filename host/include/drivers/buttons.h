@@ -0,0 +1,30 @@
+#ifndef __DRIVERS_BUTTONS_H__
+#define __DRIVERS_BUTTONS_H__
+
+#include <stdint.h>
+
+#include "inc/hw_memmap.h"
+#include "driverlib/sysctl.h"
+
+//-----------------------------------------------------------------------------
+// Host stand-in for drivers/buttons.h (EK-TM4C1294XL user switches on PJ0/PJ1)
+//-----------------------------------------------------------------------------
+#define BUTTONS_GPIO_PERIPH     SYSCTL_PERIPH_GPIOJ
+#define BUTTONS_GPIO_BASE       GPIO_PORTJ_BASE
+
+#define NUM_BUTTONS             2
+#define USR_SW1                 0x00000001
+#define USR_SW2                 0x00000002
+#define LEFT_BUTTON             USR_SW1
+#define RIGHT_BUTTON            USR_SW2
+#define ALL_BUTTONS             (LEFT_BUTTON | RIGHT_BUTTON)
+
+#define BUTTON_PRESSED(button, buttons, changed)                              \
+        (((button) & (changed)) && ((button) & (buttons)))
+#define BUTTON_RELEASED(button, buttons, changed)                             \
+        (((button) & (changed)) && !((button) & (buttons)))
+
+extern void ButtonsInit(void);
+extern uint8_t ButtonsPoll(uint8_t *pui8Delta, uint8_t *pui8Raw);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef __DRIVERS_PINOUT_H__
+#define __DRIVERS_PINOUT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Host stand-in for drivers/pinout.h (EK-TM4C1294XL)
+//-----------------------------------------------------------------------------
+extern void PinoutSet(bool bEthernet, bool bUSB);
+
+#endif
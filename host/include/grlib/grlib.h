@@ -0,0 +1,99 @@
+#ifndef __GRLIB_H__
+#define __GRLIB_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Host stand-in for the part of grlib/grlib.h that the labs use
+// Same structs and drawing rules as TivaWare grlib, drawing goes through the
+// tDisplay function pointers of the display driver.
+//-----------------------------------------------------------------------------
+typedef struct
+{
+    int16_t i16XMin;
+    int16_t i16YMin;
+    int16_t i16XMax;
+    int16_t i16YMax;
+} tRectangle;
+
+typedef struct
+{
+    int32_t i32Size;
+    void *pvDisplayData;
+    uint16_t ui16Width;
+    uint16_t ui16Height;
+    void (*pfnPixelDraw)(void *pvDisplayData, int32_t i32X, int32_t i32Y, uint32_t ui32Value);
+    void (*pfnPixelDrawMultiple)(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                                 int32_t i32X0, int32_t i32Count, int32_t i32BPP,
+                                 const uint8_t *pui8Data, const uint8_t *pui8Palette);
+    void (*pfnLineDrawH)(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y,
+                         uint32_t ui32Value);
+    void (*pfnLineDrawV)(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2,
+                         uint32_t ui32Value);
+    void (*pfnRectFill)(void *pvDisplayData, const tRectangle *psRect, uint32_t ui32Value);
+    uint32_t (*pfnColorTranslate)(void *pvDisplayData, uint32_t ui32Value);
+    void (*pfnFlush)(void *pvDisplayData);
+} tDisplay;
+
+// Fixed width font, one byte per glyph column (bit 0 is the top row), glyphs for ' ' to '~'
+typedef struct
+{
+    uint8_t ui8Format;
+    uint8_t ui8MaxWidth;
+    uint8_t ui8Height;
+    uint8_t ui8Baseline;
+    const uint8_t *pui8Data;
+} tFont;
+
+typedef struct
+{
+    int32_t i32Size;
+    const tDisplay *psDisplay;
+    tRectangle sClipRegion;
+    uint32_t ui32Foreground;
+    uint32_t ui32Background;
+    const tFont *psFont;
+} tContext;
+
+//-----------------------------------------------------------------------------
+// Colors, 24-bit RGB
+#define ClrBlack                0x00000000
+#define ClrBlue                 0x000000FF
+#define ClrBlueViolet           0x008A2BE2
+#define ClrCyan                 0x0000FFFF
+#define ClrDarkBlue             0x0000008B
+#define ClrDarkGreen            0x00006400
+#define ClrDimGray              0x00696969
+#define ClrGray                 0x00808080
+#define ClrGreen                0x00008000
+#define ClrLime                 0x0000FF00
+#define ClrMagenta              0x00FF00FF
+#define ClrOrange               0x00FFA500
+#define ClrRed                  0x00FF0000
+#define ClrSeashell             0x00FFF5EE
+#define ClrSilver               0x00C0C0C0
+#define ClrWhite                0x00FFFFFF
+#define ClrYellow               0x00FFFF00
+
+extern const tFont g_sFontFixed6x8;
+
+//-----------------------------------------------------------------------------
+extern void GrContextInit(tContext *pContext, const tDisplay *pDisplay);
+extern void GrContextForegroundSet(tContext *pContext, uint32_t ui32Value);
+extern void GrContextBackgroundSet(tContext *pContext, uint32_t ui32Value);
+extern void GrContextFontSet(tContext *pContext, const tFont *pFont);
+extern void GrContextClipRegionSet(tContext *pContext, tRectangle *pRect);
+extern void GrPixelDraw(const tContext *pContext, int32_t i32X, int32_t i32Y);
+extern void GrLineDrawH(const tContext *pContext, int32_t i32X1, int32_t i32X2, int32_t i32Y);
+extern void GrLineDrawV(const tContext *pContext, int32_t i32X, int32_t i32Y1, int32_t i32Y2);
+extern void GrRectFill(const tContext *pContext, const tRectangle *pRect);
+extern int32_t GrRectOverlapCheck(tRectangle *psRect1, tRectangle *psRect2);
+extern int32_t GrStringWidthGet(const tContext *pContext, const char *pcString, int32_t i32Length);
+extern void GrStringDraw(const tContext *pContext, const char *pcString, int32_t i32Length,
+                         int32_t i32X, int32_t i32Y, bool bOpaque);
+extern void GrStringDrawCentered(const tContext *pContext, const char *pcString, int32_t i32Length,
+                                 int32_t i32X, int32_t i32Y, bool bOpaque);
+extern void GrFlush(const tContext *pContext);
+
+#endif
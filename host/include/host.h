@@ -0,0 +1,129 @@
+#ifndef __HOST_H__
+#define __HOST_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Control side of the host HAL (host/src), not part of TivaWare
+//
+// The labs only see the driverlib/grlib API, this is for feeding them input
+// and looking at what they did. Input can also be given with environment
+// variables, read before main runs:
+//   HOST_ADC=ch:value,...    ADC input channel values (0-4095, default 2048)
+//   HOST_WAV=ch:file         ADC input channel from a WAV file, sampled on the virtual clock
+//   HOST_GPIO=port:value,... GPIO input levels, port is a letter (default 0xFF, all high)
+//   HOST_FRAMES=n            exit(0) after n frames, printing how long they took
+//   HOST_HEADLESS=1          SysCtlDelay and SysCtlSleep return at once, the games run as fast as the host can
+//   HOST_DISPLAY=0/1         draw on the LCD model or not, default on unless headless
+//   HOST_SCRIPT=file         input for each frame, see host/src/script.c
+//   HOST_SEED=n              srand(n) before main runs
+//   HOST_RECORD=file         record the input of every frame, see host/src/trace.c
+//   HOST_REPLAY=file         replay recorded input (instead of HOST_ADC, HOST_GPIO, HOST_SCRIPT)
+//   HOST_REPLAY_FROM=n       start the replay at frame n of the trace
+//   HOST_DISPLAY_STATS=1     print the display counters of every frame and the totals to stderr
+//
+// A frame is one pass of the main loop. It ends at SysCtlDelay or SysCtlSleep
+// (the programs wait once per frame), or if the program never waits, at
+// ButtonsPoll or ADCProcessorTrigger. Only calls from the same place in the
+// program as the first such call count, so a game over delay or the other ADC
+// reads in the same loop do not end a frame.
+//-----------------------------------------------------------------------------
+// Input value of ADC channel (AIN0-AIN19)
+extern void HostADCChannelSet(uint32_t ui32Channel, uint32_t ui32Value);
+extern uint32_t HostADCChannelGet(uint32_t ui32Channel);
+// Play the first channel of a PCM WAV file on an ADC channel (in a loop), returns 0 if it can not be read
+extern int32_t HostADCWavLoad(uint32_t ui32Channel, const char *pcPath);
+// External level of pins on a GPIO port (what GPIOPinRead returns for input pins)
+extern void HostGPIOInputSet(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val);
+// Same as HOST_ADC and HOST_GPIO, return where parsing stopped
+extern const char *HostADCListSet(const char *pcList);
+extern const char *HostGPIOListSet(const char *pcList);
+extern uint8_t HostGPIOInputGet(uint32_t ui32Port);
+// GPIO port base address from its letter ('A' to 'Q'), 0 if there is no such port
+extern uint32_t HostGPIOPortBase(char cPort);
+// Output latch of a GPIO port (what GPIOPinWrite wrote)
+extern uint8_t HostGPIOOutputGet(uint32_t ui32Port);
+extern uint32_t HostPWMPulseWidthGet(uint32_t ui32Base, uint32_t ui32PWMOut);
+extern uint32_t HostPWMOutputStateGet(uint32_t ui32Base);
+// Clock set with SysCtlClockFreqSet
+extern uint32_t HostSysClockGet(void);
+// Virtual clock, system clock cycles the program has waited since start (SysCtlDelay, SysCtlSleep)
+extern uint64_t HostCycleCount(void);
+// Move the virtual clock forward, running the timer timeouts and ADC conversions on the way
+extern void HostCycleAdvance(uint64_t ui64Cycles);
+// Used by the virtual clock: cycle count of the next event (UINT64_MAX if none) and running the due ones
+extern uint64_t HostTimerNextEvent(void);
+extern void HostTimerEvents(uint64_t ui64Now);
+extern uint64_t HostADCNextEvent(void);
+extern void HostADCEvents(uint64_t ui64Now);
+extern uint64_t HostPWMNextEvent(void);
+extern void HostPWMEvents(uint64_t ui64Now);
+// Used by the timer and PWM models: a timer with TimerControlTrigger timed out, a generator's ADC trigger
+extern void HostADCTimerTrigger(uint64_t ui64Now);
+extern void HostADCPWMTrigger(uint32_t ui32Gen, uint64_t ui64Now);
+// 1 if HOST_HEADLESS is set
+extern uint32_t HostHeadlessGet(void);
+// Load an input script, returns 0 if the file can not be read
+extern int32_t HostScriptLoad(const char *pcPath);
+// Input traces, return 0 if the file can not be written or is not a trace
+extern int32_t HostRecordStart(const char *pcPath);
+extern int32_t HostReplayStart(const char *pcPath, uint32_t ui32From);
+// State of rand(), what srand set plus every rand() call since
+extern uint32_t HostRandStateGet(void);
+extern void HostRandStateSet(uint32_t ui32State);
+// Number of rand() calls so far, and stepping the state on by a number of calls
+extern uint32_t HostRandCallsGet(void);
+extern void HostRandAdvance(uint32_t ui32Calls);
+
+// What the LCD driver did
+typedef struct
+{
+    // Driver calls (pixel, line, rectangle, pixel row), each one sets a window on the panel
+    uint32_t ui32DrawCalls;
+    uint32_t ui32PixelsWritten;
+    // Pixels written with the value they already had
+    uint32_t ui32PixelsSame;
+    // Bytes the SPI bus would carry, window setup plus 2 per pixel
+    uint32_t ui32BusBytes;
+} tHostDisplayStats;
+// Counters of the last frame that ended and of the whole run so far (either may be NULL)
+extern void HostDisplayStatsGet(tHostDisplayStats *psLastFrame, tHostDisplayStats *psTotal);
+// Panel memory, LCD_HORIZONTAL_MAX x LCD_VERTICAL_MAX RGB565 pixels, row by row
+extern const uint16_t *HostDisplayFramebufferGet(void);
+// Byte sent to the panel on SSI2 (command or data depending on the DC pin, PL3)
+extern void HostDisplaySSIWrite(uint8_t ui8Byte);
+extern void HostDisplaySSIWriteBuffer(const uint8_t *pui8Data, uint32_t ui32Count);
+
+// Interrupt ui32Interrupt (INT_...) happened, see host/src/interrupt.c
+extern void HostIntTrigger(uint32_t ui32Interrupt);
+// Interrupt handlers run since start, SysCtlSleep returns when this changes
+extern uint32_t HostIntCount(void);
+// Used by the uDMA model: does the SSI want DMA (SSI_DMA_TX/RX), a DMA transfer is done (SSI_DMATX/RX)
+extern bool HostSSIDMARequest(uint32_t ui32Base, uint32_t ui32DMAFlag);
+extern void HostSSIIntSet(uint32_t ui32Base, uint32_t ui32IntFlags);
+// Used by the uDMA model: bytes for the data register, like SSIDataPut for each
+extern void HostSSIDataPutBuffer(uint32_t ui32Base, const uint8_t *pui8Data, uint32_t ui32Count);
+// Used by the uDMA model: the ADC FIFO wants DMA, reading its data register, a DMA transfer is done
+extern bool HostADCDMARequest(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern uint32_t HostADCFifoRead(uint32_t ui32Base, uint32_t ui32SequenceNum);
+extern void HostADCDMADone(uint32_t ui32Base, uint32_t ui32SequenceNum);
+// Used by peripheral models: uDMA channel ui32Channel has a request, move what it can
+extern void HostUDMARequest(uint32_t ui32Channel);
+
+// Called at the end of every frame with the number of the frame that ended (first is 0)
+typedef void (*tHostFrameHook)(uint32_t ui32Frame);
+extern void HostFrameHookSet(tHostFrameHook pfnHook);
+extern uint32_t HostFrameCount(void);
+// Used by the host driverlib to mark a possible end of frame, site is the caller's return address
+#define HOST_FRAME_DELAY        0
+#define HOST_FRAME_POLL         1
+extern void HostFrameMark(uint32_t ui32Kind, void *pvSite);
+// Called by HostFrameMark at the end of every frame, before the frame hook
+extern void HostDisplayFrameEnd(uint32_t ui32Frame);
+// Called by HostFrameMark before every frame runs
+extern void HostScriptFrame(uint32_t ui32Frame);
+// Called by HostFrameMark after HostScriptFrame, returns 0 when a replay has ended
+extern uint32_t HostTraceFrame(uint32_t ui32Frame);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef __HW_ADC_H__
+#define __HW_ADC_H__
+
+//-----------------------------------------------------------------------------
+// Host stand-in for the TivaWare ADC register offsets
+// Only used as DMA addresses on the host (base + offset), see host/src/udma.c.
+//-----------------------------------------------------------------------------
+#define ADC_O_SSFIFO0           0x00000048
+#define ADC_O_SSFIFO1           0x00000068
+#define ADC_O_SSFIFO2           0x00000088
+#define ADC_O_SSFIFO3           0x000000A8
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef __HW_INTS_H__
+#define __HW_INTS_H__
+
+//-----------------------------------------------------------------------------
+// Host stand-in for the TivaWare interrupt numbers (TM4C129 vector numbers)
+//-----------------------------------------------------------------------------
+#define INT_ADC0SS0             30
+#define INT_ADC0SS1             31
+#define INT_ADC0SS2             32
+#define INT_ADC0SS3             33
+#define INT_TIMER0A             35
+#define INT_TIMER1A             37
+#define INT_ADC1SS0             64
+#define INT_ADC1SS1             65
+#define INT_ADC1SS2             66
+#define INT_ADC1SS3             67
+#define INT_SSI2                73
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+//-----------------------------------------------------------------------------
+// Host stand-in for the TivaWare memory map (TM4C129)
+// Only the addresses matter as identifiers on the host, nothing is mapped there.
+//-----------------------------------------------------------------------------
+#define UART0_BASE              0x4000C000
+#define SSI2_BASE               0x4000A000
+#define PWM0_BASE               0x40028000
+#define TIMER0_BASE             0x40030000
+#define TIMER1_BASE             0x40031000
+#define ADC0_BASE               0x40038000
+#define ADC1_BASE               0x40039000
+#define GPIO_PORTA_AHB_BASE     0x40058000
+#define GPIO_PORTB_AHB_BASE     0x40059000
+#define GPIO_PORTC_AHB_BASE     0x4005A000
+#define GPIO_PORTD_AHB_BASE     0x4005B000
+#define GPIO_PORTE_AHB_BASE     0x4005C000
+#define GPIO_PORTF_AHB_BASE     0x4005D000
+#define GPIO_PORTG_AHB_BASE     0x4005E000
+#define GPIO_PORTH_AHB_BASE     0x4005F000
+#define GPIO_PORTJ_AHB_BASE     0x40060000
+#define GPIO_PORTK_BASE         0x40061000
+#define GPIO_PORTL_BASE         0x40062000
+#define GPIO_PORTM_BASE         0x40063000
+#define GPIO_PORTN_BASE         0x40064000
+#define GPIO_PORTP_BASE         0x40065000
+#define GPIO_PORTQ_BASE         0x40066000
+#define UDMA_BASE               0x400FF000
+
+// The TM4C129 only has the AHB aperture, the plain names point to it
+#define GPIO_PORTA_BASE         GPIO_PORTA_AHB_BASE
+#define GPIO_PORTB_BASE         GPIO_PORTB_AHB_BASE
+#define GPIO_PORTC_BASE         GPIO_PORTC_AHB_BASE
+#define GPIO_PORTD_BASE         GPIO_PORTD_AHB_BASE
+#define GPIO_PORTE_BASE         GPIO_PORTE_AHB_BASE
+#define GPIO_PORTF_BASE         GPIO_PORTF_AHB_BASE
+#define GPIO_PORTG_BASE         GPIO_PORTG_AHB_BASE
+#define GPIO_PORTH_BASE         GPIO_PORTH_AHB_BASE
+#define GPIO_PORTJ_BASE         GPIO_PORTJ_AHB_BASE
+
+#endif
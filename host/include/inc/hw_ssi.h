@@ -0,0 +1,10 @@
+#ifndef __HW_SSI_H__
+#define __HW_SSI_H__
+
+//-----------------------------------------------------------------------------
+// Host stand-in for the TivaWare SSI register offsets
+// Only used as DMA addresses on the host (base + offset), see host/src/udma.c.
+//-----------------------------------------------------------------------------
+#define SSI_O_DR                0x00000008
+
+#endif
@@ -0,0 +1,70 @@
+//-----------------------------------------------------------------------------
+// Host stand-in for utils/uartstdio.c
+//
+// The labs include this file directly (#include "utils/uartstdio.c") like with
+// TivaWare, so it is compiled as part of main.c and not listed in host/src.
+// UART0 is stdout/stdin. Also pulls in the same driverlib headers as the
+// TivaWare version, which some of the labs rely on.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/rom.h"
+#include "driverlib/rom_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "utils/uartstdio.h"
+
+//-----------------------------------------------------------------------------
+void UARTStdioConfig(uint32_t ui32Port, uint32_t ui32Baud, uint32_t ui32SrcClock)
+{
+    (void)ui32Port;
+    (void)ui32Baud;
+    (void)ui32SrcClock;
+}
+//-----------------------------------------------------------------------------
+int UARTwrite(const char *pcBuf, uint32_t ui32Len)
+{
+    return (int)fwrite(pcBuf, 1, ui32Len, stdout);
+}
+//-----------------------------------------------------------------------------
+// Reads a line (without the newline), returns the number of characters
+int UARTgets(char *pcBuf, uint32_t ui32Len)
+{
+    int c;
+    uint32_t i = 0;
+
+    while(i + 1 < ui32Len && (c = getchar()) != EOF && c != '\n' && c != '\r')
+    {
+        pcBuf[i++] = (char)c;
+    }
+    pcBuf[i] = 0;
+    return (int)i;
+}
+//-----------------------------------------------------------------------------
+unsigned char UARTgetc(void)
+{
+    int c = getchar();
+    return (c == EOF) ? 0 : (unsigned char)c;
+}
+//-----------------------------------------------------------------------------
+// Same format codes as the TivaWare version (%c %d %i %p %s %u %x %X %%), which are a subset of printf's
+void UARTvprintf(const char *pcString, va_list vaArgP)
+{
+    vprintf(pcString, vaArgP);
+}
+//-----------------------------------------------------------------------------
+void UARTprintf(const char *pcString, ...)
+{
+    va_list vaArgP;
+
+    va_start(vaArgP, pcString);
+    UARTvprintf(pcString, vaArgP);
+    va_end(vaArgP);
+}
+//-----------------------------------------------------------------------------
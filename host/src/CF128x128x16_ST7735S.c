@@ -0,0 +1,370 @@
+//-----------------------------------------------------------------------------
+// Host display driver for the 128x128 ST7735S LCD
+//
+// Renders into an RGB565 framebuffer (what the panel's memory would hold) and
+// counts, per frame, the driver calls, the pixels written, the pixels written
+// with the value they already had (wasted erase/redraw traffic) and the bytes
+// the SPI bus would carry. Every driver call on the target sets a window
+// (CASET, RASET and RAMWR, 11 bytes) and then sends 2 bytes per pixel.
+// HOST_DISPLAY_STATS=1 prints the counters of every frame and the totals to stderr.
+// Code that drives the panel itself over SSI2 (common/framebuffer.h) ends up in
+// HostDisplaySSIWrite, which decodes the bytes like the ST7735S and counts the
+// real bytes and windows instead.
+// With HOST_DISPLAY=0 (the default when headless) drawing is dropped without
+// being rendered or counted.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "grlib/grlib.h"
+#include "drivers/CF128x128x16_ST7735S.h"
+#include "host.h"
+
+// Window setup: CASET + 4 data bytes, RASET + 4 data bytes, RAMWR
+#define ST7735S_WINDOW_BYTES    11
+#define ST7735S_CASET           0x2A
+#define ST7735S_RASET           0x2B
+#define ST7735S_RAMWR           0x2C
+// Data/command pin of the BoosterPack LCD (LCD RS, J4.31), low for commands
+#define LCD_DC_BASE             GPIO_PORTL_BASE
+#define LCD_DC_PIN              GPIO_PIN_3
+// Controller RAM column and row of the upper left pixel of the glass
+#define LCD_X_OFFSET            2
+#define LCD_Y_OFFSET            3
+
+static uint16_t g_pui16Frame[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX];
+// Current frame, and everything before it
+static tHostDisplayStats g_sStatsFrame;
+static tHostDisplayStats g_sStatsLast;
+static tHostDisplayStats g_sStatsTotal;
+static uint32_t g_ui32StatsPrint;
+static uint32_t g_ui32Draw = 1;
+// Controller state for bytes sent over SSI2: last command, data bytes after it,
+// the window (CASET/RASET) and where the next pixel of RAMWR goes
+static uint8_t g_ui8Command;
+static uint32_t g_ui32DataCount;
+static int32_t g_pi32Window[4] = {LCD_X_OFFSET, LCD_Y_OFFSET,
+                                  LCD_X_OFFSET + LCD_HORIZONTAL_MAX - 1, LCD_Y_OFFSET + LCD_VERTICAL_MAX - 1};
+static int32_t g_i32WriteX;
+static int32_t g_i32WriteY;
+static uint16_t g_ui16Pixel;
+
+//-----------------------------------------------------------------------------
+// Start of a driver call that draws i32Count pixels
+static void DisplayCall(int32_t i32Count)
+{
+    g_sStatsFrame.ui32DrawCalls++;
+    g_sStatsFrame.ui32BusBytes += ST7735S_WINDOW_BYTES + i32Count * 2;
+}
+//-----------------------------------------------------------------------------
+static void DisplayPixelSet(int32_t i32X, int32_t i32Y, uint16_t ui16Value)
+{
+    if(i32X < 0 || i32X >= LCD_HORIZONTAL_MAX || i32Y < 0 || i32Y >= LCD_VERTICAL_MAX)
+    {
+        return;
+    }
+    g_sStatsFrame.ui32PixelsWritten++;
+    if(g_pui16Frame[i32Y][i32X] == ui16Value)
+    {
+        g_sStatsFrame.ui32PixelsSame++;
+    }
+    g_pui16Frame[i32Y][i32X] = ui16Value;
+}
+//-----------------------------------------------------------------------------
+static void DisplayStatsAdd(tHostDisplayStats *psTo, const tHostDisplayStats *psFrom)
+{
+    psTo->ui32DrawCalls += psFrom->ui32DrawCalls;
+    psTo->ui32PixelsWritten += psFrom->ui32PixelsWritten;
+    psTo->ui32PixelsSame += psFrom->ui32PixelsSame;
+    psTo->ui32BusBytes += psFrom->ui32BusBytes;
+}
+//-----------------------------------------------------------------------------
+static void DisplayStatsPrint(const char *pcName, const tHostDisplayStats *psStats)
+{
+    fprintf(stderr, "%s: %u calls, %u pixels, %u same (%u%%), %u bus bytes\n", pcName,
+            psStats->ui32DrawCalls, psStats->ui32PixelsWritten, psStats->ui32PixelsSame,
+            psStats->ui32PixelsWritten ? (psStats->ui32PixelsSame * 100 / psStats->ui32PixelsWritten) : 0,
+            psStats->ui32BusBytes);
+}
+//-----------------------------------------------------------------------------
+static void DisplayStatsExit(void)
+{
+    tHostDisplayStats sTotal;
+
+    HostDisplayStatsGet(NULL, &sTotal);
+    DisplayStatsPrint("display total", &sTotal);
+}
+//-----------------------------------------------------------------------------
+__attribute__((constructor))
+static void DisplayEnvRead(void)
+{
+    const char *pcEnv = getenv("HOST_DISPLAY_STATS");
+
+    if(pcEnv != NULL && atoi(pcEnv) != 0)
+    {
+        g_ui32StatsPrint = 1;
+        atexit(DisplayStatsExit);
+    }
+    // Read here and not with HostHeadlessGet, the order of constructors in different files is not defined
+    pcEnv = getenv("HOST_HEADLESS");
+    if(pcEnv != NULL && atoi(pcEnv) != 0)
+    {
+        g_ui32Draw = 0;
+    }
+    pcEnv = getenv("HOST_DISPLAY");
+    if(pcEnv != NULL)
+    {
+        g_ui32Draw = atoi(pcEnv) != 0;
+    }
+}
+//-----------------------------------------------------------------------------
+void HostDisplayFrameEnd(uint32_t ui32Frame)
+{
+    char pcName[32];
+
+    if(g_ui32StatsPrint)
+    {
+        snprintf(pcName, sizeof(pcName), "frame %u", ui32Frame);
+        DisplayStatsPrint(pcName, &g_sStatsFrame);
+    }
+    DisplayStatsAdd(&g_sStatsTotal, &g_sStatsFrame);
+    g_sStatsLast = g_sStatsFrame;
+    g_sStatsFrame = (tHostDisplayStats){0};
+}
+//-----------------------------------------------------------------------------
+void HostDisplayStatsGet(tHostDisplayStats *psLastFrame, tHostDisplayStats *psTotal)
+{
+    if(psLastFrame != NULL)
+    {
+        *psLastFrame = g_sStatsLast;
+    }
+    if(psTotal != NULL)
+    {
+        *psTotal = g_sStatsTotal;
+        DisplayStatsAdd(psTotal, &g_sStatsFrame);
+    }
+}
+//-----------------------------------------------------------------------------
+const uint16_t *HostDisplayFramebufferGet(void)
+{
+    return &g_pui16Frame[0][0];
+}
+//-----------------------------------------------------------------------------
+// Pixels are 2 bytes, high first, the write position wraps inside the window
+static void DisplayRAMWrite(uint8_t ui8Byte)
+{
+    if((g_ui32DataCount & 1) == 0)
+    {
+        g_ui16Pixel = ui8Byte << 8;
+        return;
+    }
+    // Window is in controller RAM addresses, outside of the glass is dropped
+    DisplayPixelSet(g_i32WriteX - LCD_X_OFFSET, g_i32WriteY - LCD_Y_OFFSET, g_ui16Pixel | ui8Byte);
+    if(++g_i32WriteX > g_pi32Window[2])
+    {
+        g_i32WriteX = g_pi32Window[0];
+        if(++g_i32WriteY > g_pi32Window[3])
+        {
+            g_i32WriteY = g_pi32Window[1];
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void HostDisplaySSIWrite(uint8_t ui8Byte)
+{
+    uint32_t ui32Index;
+
+    if(!g_ui32Draw)
+    {
+        return;
+    }
+    g_sStatsFrame.ui32BusBytes++;
+    if(!(HostGPIOOutputGet(LCD_DC_BASE) & LCD_DC_PIN))
+    {
+        g_ui8Command = ui8Byte;
+        g_ui32DataCount = 0;
+        if(ui8Byte == ST7735S_RAMWR)
+        {
+            g_sStatsFrame.ui32DrawCalls++;
+            g_i32WriteX = g_pi32Window[0];
+            g_i32WriteY = g_pi32Window[1];
+        }
+        return;
+    }
+    // CASET and RASET: start and end, 16 bits each, high byte first
+    if((g_ui8Command == ST7735S_CASET || g_ui8Command == ST7735S_RASET) && g_ui32DataCount < 4)
+    {
+        ui32Index = (g_ui32DataCount / 2) * 2 + (g_ui8Command == ST7735S_RASET);
+        if(g_ui32DataCount & 1)
+        {
+            g_pi32Window[ui32Index] |= ui8Byte;
+        }
+        else
+        {
+            g_pi32Window[ui32Index] = ui8Byte << 8;
+        }
+    }
+    else if(g_ui8Command == ST7735S_RAMWR)
+    {
+        DisplayRAMWrite(ui8Byte);
+    }
+    g_ui32DataCount++;
+}
+//-----------------------------------------------------------------------------
+// Bytes written to SSI2 by the uDMA, same as HostDisplaySSIWrite for each
+void HostDisplaySSIWriteBuffer(const uint8_t *pui8Data, uint32_t ui32Count)
+{
+    if(!g_ui32Draw)
+    {
+        return;
+    }
+    while(ui32Count--)
+    {
+        HostDisplaySSIWrite(*pui8Data++);
+    }
+}
+//-----------------------------------------------------------------------------
+static void CF128x128x16_ST7735SPixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y, uint32_t ui32Value)
+{
+    (void)pvDisplayData;
+    if(!g_ui32Draw)
+    {
+        return;
+    }
+    DisplayCall(1);
+    DisplayPixelSet(i32X, i32Y, ui32Value);
+}
+//-----------------------------------------------------------------------------
+// 24-bit RGB to RGB565
+static uint32_t CF128x128x16_ST7735SColorTranslate(void *pvDisplayData, uint32_t ui32Value)
+{
+    (void)pvDisplayData;
+    return ((ui32Value >> 8) & 0xF800) | ((ui32Value >> 5) & 0x07E0) | ((ui32Value >> 3) & 0x001F);
+}
+//-----------------------------------------------------------------------------
+// Row of i32Count pixels from i32X, i32Y, same formats as grlib:
+// 1 bpp: bits MSB first starting at bit i32X0 of the first byte, palette is 2 translated colors (uint32_t)
+// 4 bpp: nibbles high first starting at nibble i32X0, palette is 24-bit RGB (3 bytes per entry)
+// 8 bpp: one byte per pixel, palette is 24-bit RGB
+static void CF128x128x16_ST7735SPixelDrawMultiple(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                                                  int32_t i32X0, int32_t i32Count, int32_t i32BPP,
+                                                  const uint8_t *pui8Data, const uint8_t *pui8Palette)
+{
+    const uint32_t *pui32Palette = (const uint32_t *)pui8Palette;
+    const uint8_t *pui8Entry;
+    uint32_t ui32Index;
+    int32_t i32I;
+
+    if(!g_ui32Draw)
+    {
+        return;
+    }
+    DisplayCall(i32Count);
+    for(i32I = 0; i32I < i32Count; i32I++)
+    {
+        if(i32BPP == 1)
+        {
+            ui32Index = (pui8Data[(i32X0 + i32I) / 8] >> (7 - (i32X0 + i32I) % 8)) & 1;
+            DisplayPixelSet(i32X + i32I, i32Y, pui32Palette[ui32Index]);
+            continue;
+        }
+        if(i32BPP == 4)
+        {
+            ui32Index = (pui8Data[(i32X0 + i32I) / 2] >> (((i32X0 + i32I) & 1) ? 0 : 4)) & 0xF;
+        }
+        else
+        {
+            ui32Index = pui8Data[i32I];
+        }
+        pui8Entry = &pui8Palette[ui32Index * 3];
+        DisplayPixelSet(i32X + i32I, i32Y,
+                        CF128x128x16_ST7735SColorTranslate(pvDisplayData,
+                                                           ((uint32_t)pui8Entry[2] << 16) |
+                                                           ((uint32_t)pui8Entry[1] << 8) | pui8Entry[0]));
+    }
+}
+//-----------------------------------------------------------------------------
+static void CF128x128x16_ST7735SLineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y, uint32_t ui32Value)
+{
+    (void)pvDisplayData;
+    if(!g_ui32Draw)
+    {
+        return;
+    }
+    DisplayCall(i32X2 - i32X1 + 1);
+    for(; i32X1 <= i32X2; i32X1++)
+    {
+        DisplayPixelSet(i32X1, i32Y, ui32Value);
+    }
+}
+//-----------------------------------------------------------------------------
+static void CF128x128x16_ST7735SLineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2, uint32_t ui32Value)
+{
+    (void)pvDisplayData;
+    if(!g_ui32Draw)
+    {
+        return;
+    }
+    DisplayCall(i32Y2 - i32Y1 + 1);
+    for(; i32Y1 <= i32Y2; i32Y1++)
+    {
+        DisplayPixelSet(i32X, i32Y1, ui32Value);
+    }
+}
+//-----------------------------------------------------------------------------
+static void CF128x128x16_ST7735SRectFill(void *pvDisplayData, const tRectangle *psRect, uint32_t ui32Value)
+{
+    int32_t i32X;
+    int32_t i32Y;
+
+    (void)pvDisplayData;
+    if(!g_ui32Draw)
+    {
+        return;
+    }
+    DisplayCall((psRect->i16XMax - psRect->i16XMin + 1) * (psRect->i16YMax - psRect->i16YMin + 1));
+    for(i32Y = psRect->i16YMin; i32Y <= psRect->i16YMax; i32Y++)
+    {
+        for(i32X = psRect->i16XMin; i32X <= psRect->i16XMax; i32X++)
+        {
+            DisplayPixelSet(i32X, i32Y, ui32Value);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+// Nothing is buffered, every call goes straight to the panel like on the target
+static void CF128x128x16_ST7735SFlush(void *pvDisplayData)
+{
+    (void)pvDisplayData;
+}
+//-----------------------------------------------------------------------------
+const tDisplay g_sCF128x128x16_ST7735S =
+{
+    sizeof(tDisplay),
+    0,
+    LCD_HORIZONTAL_MAX,
+    LCD_VERTICAL_MAX,
+    CF128x128x16_ST7735SPixelDraw,
+    CF128x128x16_ST7735SPixelDrawMultiple,
+    CF128x128x16_ST7735SLineDrawH,
+    CF128x128x16_ST7735SLineDrawV,
+    CF128x128x16_ST7735SRectFill,
+    CF128x128x16_ST7735SColorTranslate,
+    CF128x128x16_ST7735SFlush
+};
+//-----------------------------------------------------------------------------
+void CF128x128x16_ST7735SInit(uint32_t ui32SysClock)
+{
+    (void)ui32SysClock;
+}
+//-----------------------------------------------------------------------------
+void CF128x128x16_ST7735SClear(uint32_t ui32Color)
+{
+    tRectangle sRect = {0, 0, LCD_HORIZONTAL_MAX - 1, LCD_VERTICAL_MAX - 1};
+
+    CF128x128x16_ST7735SRectFill(0, &sRect, CF128x128x16_ST7735SColorTranslate(0, ui32Color));
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,608 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: ADC
+//
+// Two ADC modules with four sample sequencers each. A sequencer has its
+// trigger, the configuration of its steps, a result FIFO and a raw interrupt
+// flag. A processor trigger runs the sequence right away: every step samples
+// the value of its input channel (set with HostADCChannelSet) into the FIFO
+// until the step marked ADC_CTL_END, steps with ADC_CTL_IE set the interrupt
+// flag. Like on the target the flag stays set until ADCIntClear.
+//
+// A timer (host/src/timer.c, TimerControlTrigger) starts the enabled
+// sequences with ADC_TRIGGER_TIMER on both modules, a PWM generator
+// (host/src/pwm.c, PWMGenIntTrigEnable) the ones with its ADC_TRIGGER_PWMn.
+// These take time on the virtual clock: one conversion per step at
+// ADC_SAMPLE_RATE, the channels are sampled and the interrupt is raised when
+// the last one is done. A trigger while the sequence is still converting waits
+// for it to finish, more than one is lost, so a trigger faster than the
+// conversions gives fewer samples than it asks for. The interrupt
+// (INT_ADCnSSm) runs the handler set with ADCIntRegister when the flag is set
+// and ADCIntEnable was called.
+//
+// With ADCSequenceDMAEnable the FIFO asks its uDMA channel (14-17 for ADC0,
+// 24-27 for ADC1) for a transfer whenever it has samples; the end of that
+// transfer sets the ADC_INT_DMA_SSn flag, which raises the same interrupt if
+// it is enabled with ADCIntEnableEx.
+//
+// HostADCWavLoad (HOST_WAV) plays the first channel of a PCM WAV file on an
+// input channel, at the rate of the file on the virtual clock and over again
+// at the end, instead of the value set with HostADCChannelSet.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/adc.h"
+#include "host.h"
+
+#define NUM_CHANNELS 20
+#define FIFO_SIZE 8
+// Conversions per second of each module (2 Msps on the TM4C129)
+#define ADC_SAMPLE_RATE 2000000
+
+typedef struct
+{
+    uint32_t ui32Trigger;
+    bool bEnabled;
+    bool bIntEnabled;
+    bool bRawInt;
+    bool bDMAEnabled;
+    bool bDMAIntEnabled;
+    bool bDMARawInt;
+    uint32_t pui32Step[FIFO_SIZE];
+    uint32_t pui32Fifo[FIFO_SIZE];
+    uint32_t ui32FifoCount;
+    // Started by a timer or PWM, done at cycle count ui64Done; one more trigger waiting
+    bool bBusy;
+    bool bTriggerPending;
+    uint64_t ui64Done;
+} tADCSequence;
+
+static tADCSequence g_psSequences[2][4];
+// Input channel values, set with HostADCChannelSet
+static uint32_t g_pui32Channel[NUM_CHANNELS];
+static bool g_pbChannelSet[NUM_CHANNELS];
+// Samples (12 bit) of the WAV file played on g_ui32WavChannel
+static uint16_t *g_pui16Wav;
+static uint32_t g_ui32WavCount;
+static uint32_t g_ui32WavRate;
+static uint32_t g_ui32WavChannel;
+
+// Number of steps in each sequencer
+static const uint32_t g_pui32Steps[4] = {8, 4, 4, 1};
+static const uint32_t g_pui32Interrupts[2][4] =
+{
+    {INT_ADC0SS0, INT_ADC0SS1, INT_ADC0SS2, INT_ADC0SS3},
+    {INT_ADC1SS0, INT_ADC1SS1, INT_ADC1SS2, INT_ADC1SS3}
+};
+
+//-----------------------------------------------------------------------------
+static tADCSequence *ADCSequenceGet(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    if((ui32Base != ADC0_BASE && ui32Base != ADC1_BASE) || ui32SequenceNum > 3)
+    {
+        return NULL;
+    }
+    return &g_psSequences[ui32Base == ADC1_BASE][ui32SequenceNum];
+}
+//-----------------------------------------------------------------------------
+void HostADCChannelSet(uint32_t ui32Channel, uint32_t ui32Value)
+{
+    if(ui32Channel < NUM_CHANNELS)
+    {
+        g_pui32Channel[ui32Channel] = ui32Value & 0xFFF;
+        g_pbChannelSet[ui32Channel] = true;
+    }
+}
+//-----------------------------------------------------------------------------
+// Unset channels read as mid scale (a joystick at rest)
+uint32_t HostADCChannelGet(uint32_t ui32Channel)
+{
+    if(g_pui16Wav != NULL && ui32Channel == g_ui32WavChannel)
+    {
+        return g_pui16Wav[HostCycleCount() * g_ui32WavRate / HostSysClockGet() % g_ui32WavCount];
+    }
+    if(ui32Channel >= NUM_CHANNELS || !g_pbChannelSet[ui32Channel])
+    {
+        return 2048;
+    }
+    return g_pui32Channel[ui32Channel];
+}
+//-----------------------------------------------------------------------------
+// Little endian fields of the WAV header
+static uint32_t WavGet(const uint8_t *pui8Data, uint32_t ui32Bytes)
+{
+    return (ui32Bytes == 2) ? (uint32_t)(pui8Data[0] | pui8Data[1] << 8) :
+           (uint32_t)(pui8Data[0] | pui8Data[1] << 8 | pui8Data[2] << 16) | (uint32_t)pui8Data[3] << 24;
+}
+//-----------------------------------------------------------------------------
+// 8 or 16 bit PCM, any number of channels (the first is used) and rate
+int32_t HostADCWavLoad(uint32_t ui32Channel, const char *pcPath)
+{
+    FILE *psFile = fopen(pcPath, "rb");
+    uint8_t *pui8File;
+    uint8_t *pui8Chunk;
+    uint8_t *pui8Fmt = NULL;
+    uint8_t *pui8Data = NULL;
+    uint32_t ui32DataSize = 0;
+    uint32_t ui32Size;
+    uint32_t ui32Frame;
+    uint32_t i;
+    long lSize;
+
+    if(psFile == NULL || ui32Channel >= NUM_CHANNELS)
+    {
+        if(psFile != NULL)
+        {
+            fclose(psFile);
+        }
+        return 0;
+    }
+    fseek(psFile, 0, SEEK_END);
+    lSize = ftell(psFile);
+    fseek(psFile, 0, SEEK_SET);
+    pui8File = malloc(lSize > 0 ? lSize : 1);
+    if(lSize < 12 || fread(pui8File, 1, lSize, psFile) != (size_t)lSize ||
+       memcmp(pui8File, "RIFF", 4) != 0 || memcmp(pui8File + 8, "WAVE", 4) != 0)
+    {
+        fclose(psFile);
+        free(pui8File);
+        return 0;
+    }
+    fclose(psFile);
+    // Chunks are id, size, data padded to an even size
+    for(pui8Chunk = pui8File + 12; pui8Chunk + 8 <= pui8File + lSize; pui8Chunk += 8 + ((ui32Size + 1) & ~1u))
+    {
+        ui32Size = WavGet(pui8Chunk + 4, 4);
+        if(ui32Size > (uint32_t)(pui8File + lSize - pui8Chunk - 8))
+        {
+            ui32Size = (uint32_t)(pui8File + lSize - pui8Chunk - 8);
+        }
+        if(memcmp(pui8Chunk, "fmt ", 4) == 0 && ui32Size >= 16)
+        {
+            pui8Fmt = pui8Chunk + 8;
+        }
+        else if(memcmp(pui8Chunk, "data", 4) == 0)
+        {
+            pui8Data = pui8Chunk + 8;
+            ui32DataSize = ui32Size;
+        }
+    }
+    // PCM, 8 or 16 bits
+    if(pui8Fmt == NULL || pui8Data == NULL || WavGet(pui8Fmt, 2) != 1 ||
+       (WavGet(pui8Fmt + 14, 2) != 8 && WavGet(pui8Fmt + 14, 2) != 16) ||
+       WavGet(pui8Fmt + 2, 2) == 0 || WavGet(pui8Fmt + 4, 4) == 0)
+    {
+        free(pui8File);
+        return 0;
+    }
+    ui32Frame = WavGet(pui8Fmt + 2, 2) * WavGet(pui8Fmt + 14, 2) / 8;
+    if(ui32DataSize / ui32Frame == 0)
+    {
+        free(pui8File);
+        return 0;
+    }
+    free(g_pui16Wav);
+    g_ui32WavCount = ui32DataSize / ui32Frame;
+    g_ui32WavRate = WavGet(pui8Fmt + 4, 4);
+    g_ui32WavChannel = ui32Channel;
+    g_pui16Wav = malloc(g_ui32WavCount * sizeof(uint16_t));
+    for(i = 0; i < g_ui32WavCount; i++)
+    {
+        // 8 bit samples are unsigned, 16 bit signed; both to 0-4095
+        if(ui32Frame / WavGet(pui8Fmt + 2, 2) == 1)
+        {
+            g_pui16Wav[i] = pui8Data[i * ui32Frame] << 4;
+        }
+        else
+        {
+            g_pui16Wav[i] = (uint16_t)((int16_t)WavGet(pui8Data + i * ui32Frame, 2) + 32768) >> 4;
+        }
+    }
+    free(pui8File);
+    return 1;
+}
+//-----------------------------------------------------------------------------
+void ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                          uint32_t ui32Trigger, uint32_t ui32Priority)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    (void)ui32Priority;
+    if(psSeq != NULL)
+    {
+        psSeq->ui32Trigger = ui32Trigger;
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCSequenceStepConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                              uint32_t ui32Step, uint32_t ui32Config)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL && ui32Step < g_pui32Steps[ui32SequenceNum])
+    {
+        psSeq->pui32Step[ui32Step] = ui32Config;
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL)
+    {
+        psSeq->bEnabled = true;
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL)
+    {
+        psSeq->bEnabled = false;
+    }
+}
+//-----------------------------------------------------------------------------
+// Raise the interrupt of the sequence if one of its flags is set and enabled
+static void ADCSequenceInterrupt(tADCSequence *psSeq)
+{
+    uint32_t ui32Index = (uint32_t)(psSeq - &g_psSequences[0][0]);
+
+    if((psSeq->bRawInt && psSeq->bIntEnabled) || (psSeq->bDMARawInt && psSeq->bDMAIntEnabled))
+    {
+        HostIntTrigger(g_pui32Interrupts[ui32Index / 4][ui32Index % 4]);
+    }
+}
+//-----------------------------------------------------------------------------
+// uDMA channel of the sequence
+static uint32_t ADCSequenceDMAChannel(tADCSequence *psSeq)
+{
+    uint32_t ui32Index = (uint32_t)(psSeq - &g_psSequences[0][0]);
+
+    return ((ui32Index / 4) ? 24 : 14) + ui32Index % 4;
+}
+//-----------------------------------------------------------------------------
+// Number of steps up to and with the one marked ADC_CTL_END
+static uint32_t ADCSequenceLength(tADCSequence *psSeq, uint32_t ui32Steps)
+{
+    uint32_t ui32Step;
+
+    for(ui32Step = 0; ui32Step < ui32Steps - 1; ui32Step++)
+    {
+        if(psSeq->pui32Step[ui32Step] & ADC_CTL_END)
+        {
+            break;
+        }
+    }
+    return ui32Step + 1;
+}
+//-----------------------------------------------------------------------------
+// Run the steps of the sequence once, raise its interrupt if a step set the flag
+static void ADCSequenceRun(tADCSequence *psSeq, uint32_t ui32Steps)
+{
+    uint32_t ui32Step;
+    uint32_t ui32Config;
+    uint32_t ui32Channel;
+
+    for(ui32Step = 0; ui32Step < ui32Steps; ui32Step++)
+    {
+        ui32Config = psSeq->pui32Step[ui32Step];
+        ui32Channel = (ui32Config & 0x0F) | ((ui32Config & 0x100) ? 0x10 : 0);
+        // The FIFO drops new samples when it is full (overflow)
+        if(psSeq->ui32FifoCount < FIFO_SIZE)
+        {
+            psSeq->pui32Fifo[psSeq->ui32FifoCount++] = HostADCChannelGet(ui32Channel);
+        }
+        if(ui32Config & ADC_CTL_IE)
+        {
+            psSeq->bRawInt = true;
+        }
+        if(ui32Config & ADC_CTL_END)
+        {
+            break;
+        }
+    }
+    if(psSeq->bDMAEnabled)
+    {
+        HostUDMARequest(ADCSequenceDMAChannel(psSeq));
+    }
+    ADCSequenceInterrupt(psSeq);
+}
+//-----------------------------------------------------------------------------
+// Start a timer triggered sequence at cycle count ui64Now
+static void ADCSequenceStart(tADCSequence *psSeq, uint32_t ui32SequenceNum, uint64_t ui64Now)
+{
+    uint32_t ui32Steps = ADCSequenceLength(psSeq, g_pui32Steps[ui32SequenceNum]);
+
+    psSeq->bBusy = true;
+    psSeq->ui64Done = ui64Now + (uint64_t)ui32Steps * HostSysClockGet() / ADC_SAMPLE_RATE;
+}
+//-----------------------------------------------------------------------------
+// Start the sequences with trigger ui32Trigger at cycle count ui64Now
+static void ADCTrigger(uint32_t ui32Trigger, uint64_t ui64Now)
+{
+    tADCSequence *psSeq;
+    uint32_t i;
+
+    for(i = 0; i < 8; i++)
+    {
+        psSeq = &g_psSequences[i / 4][i % 4];
+        if(!psSeq->bEnabled || psSeq->ui32Trigger != ui32Trigger)
+        {
+            continue;
+        }
+        if(psSeq->bBusy)
+        {
+            psSeq->bTriggerPending = true;
+        }
+        else
+        {
+            ADCSequenceStart(psSeq, i % 4, ui64Now);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void HostADCTimerTrigger(uint64_t ui64Now)
+{
+    ADCTrigger(ADC_TRIGGER_TIMER, ui64Now);
+}
+//-----------------------------------------------------------------------------
+void HostADCPWMTrigger(uint32_t ui32Gen, uint64_t ui64Now)
+{
+    ADCTrigger(ADC_TRIGGER_PWM0 + ui32Gen, ui64Now);
+}
+//-----------------------------------------------------------------------------
+// Cycle count of the next sequence to finish, UINT64_MAX if none is converting
+uint64_t HostADCNextEvent(void)
+{
+    uint64_t ui64Next = UINT64_MAX;
+    uint32_t i;
+
+    for(i = 0; i < 8; i++)
+    {
+        if(g_psSequences[i / 4][i % 4].bBusy && g_psSequences[i / 4][i % 4].ui64Done < ui64Next)
+        {
+            ui64Next = g_psSequences[i / 4][i % 4].ui64Done;
+        }
+    }
+    return ui64Next;
+}
+//-----------------------------------------------------------------------------
+// The virtual clock is at ui64Now, finish the sequences that are done
+void HostADCEvents(uint64_t ui64Now)
+{
+    tADCSequence *psSeq;
+    uint32_t i;
+
+    for(i = 0; i < 8; i++)
+    {
+        psSeq = &g_psSequences[i / 4][i % 4];
+        if(!psSeq->bBusy || psSeq->ui64Done > ui64Now)
+        {
+            continue;
+        }
+        psSeq->bBusy = false;
+        if(psSeq->bTriggerPending)
+        {
+            psSeq->bTriggerPending = false;
+            ADCSequenceStart(psSeq, i % 4, ui64Now);
+        }
+        ADCSequenceRun(psSeq, g_pui32Steps[i % 4]);
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCProcessorTrigger(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    HostFrameMark(HOST_FRAME_POLL, __builtin_return_address(0));
+    if(psSeq != NULL && psSeq->bEnabled && psSeq->ui32Trigger == ADC_TRIGGER_PROCESSOR)
+    {
+        ADCSequenceRun(psSeq, g_pui32Steps[ui32SequenceNum]);
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t ADCIntStatus(uint32_t ui32Base, uint32_t ui32SequenceNum, bool bMasked)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq == NULL || !psSeq->bRawInt || (bMasked && !psSeq->bIntEnabled))
+    {
+        return 0;
+    }
+    return 1u << ui32SequenceNum;
+}
+//-----------------------------------------------------------------------------
+void ADCIntClear(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL)
+    {
+        psSeq->bRawInt = false;
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCIntEnable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL)
+    {
+        psSeq->bIntEnabled = true;
+        ADCSequenceInterrupt(psSeq);
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCIntDisable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL)
+    {
+        psSeq->bIntEnabled = false;
+    }
+}
+//-----------------------------------------------------------------------------
+// Empties the FIFO into pui32Buffer, returns the number of samples
+int32_t ADCSequenceDataGet(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t *pui32Buffer)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+    uint32_t i;
+    int32_t i32Count;
+
+    if(psSeq == NULL)
+    {
+        return 0;
+    }
+    for(i = 0; i < psSeq->ui32FifoCount; i++)
+    {
+        pui32Buffer[i] = psSeq->pui32Fifo[i];
+    }
+    i32Count = (int32_t)psSeq->ui32FifoCount;
+    psSeq->ui32FifoCount = 0;
+    return i32Count;
+}
+//-----------------------------------------------------------------------------
+// Sets the handler and enables the interrupt in the interrupt controller
+void ADCIntRegister(uint32_t ui32Base, uint32_t ui32SequenceNum, void (*pfnHandler)(void))
+{
+    if(ADCSequenceGet(ui32Base, ui32SequenceNum) != NULL)
+    {
+        IntRegister(g_pui32Interrupts[ui32Base == ADC1_BASE][ui32SequenceNum], pfnHandler);
+        IntEnable(g_pui32Interrupts[ui32Base == ADC1_BASE][ui32SequenceNum]);
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCIntUnregister(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    if(ADCSequenceGet(ui32Base, ui32SequenceNum) != NULL)
+    {
+        IntDisable(g_pui32Interrupts[ui32Base == ADC1_BASE][ui32SequenceNum]);
+        IntUnregister(g_pui32Interrupts[ui32Base == ADC1_BASE][ui32SequenceNum]);
+    }
+}
+//-----------------------------------------------------------------------------
+// Bit n of ui32IntFlags is sequence n (ADC_INT_SSn), bit 8 + n its DMA flag (ADC_INT_DMA_SSn)
+void ADCIntEnableEx(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tADCSequence *psSeq;
+    uint32_t i;
+
+    for(i = 0; i < 4 && (psSeq = ADCSequenceGet(ui32Base, i)) != NULL; i++)
+    {
+        psSeq->bIntEnabled |= (ui32IntFlags & (ADC_INT_SS0 << i)) != 0;
+        psSeq->bDMAIntEnabled |= (ui32IntFlags & (ADC_INT_DMA_SS0 << i)) != 0;
+        ADCSequenceInterrupt(psSeq);
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCIntDisableEx(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tADCSequence *psSeq;
+    uint32_t i;
+
+    for(i = 0; i < 4 && (psSeq = ADCSequenceGet(ui32Base, i)) != NULL; i++)
+    {
+        psSeq->bIntEnabled &= (ui32IntFlags & (ADC_INT_SS0 << i)) == 0;
+        psSeq->bDMAIntEnabled &= (ui32IntFlags & (ADC_INT_DMA_SS0 << i)) == 0;
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t ADCIntStatusEx(uint32_t ui32Base, bool bMasked)
+{
+    tADCSequence *psSeq;
+    uint32_t ui32Status = 0;
+    uint32_t i;
+
+    for(i = 0; i < 4 && (psSeq = ADCSequenceGet(ui32Base, i)) != NULL; i++)
+    {
+        if(psSeq->bRawInt && (!bMasked || psSeq->bIntEnabled))
+        {
+            ui32Status |= ADC_INT_SS0 << i;
+        }
+        if(psSeq->bDMARawInt && (!bMasked || psSeq->bDMAIntEnabled))
+        {
+            ui32Status |= ADC_INT_DMA_SS0 << i;
+        }
+    }
+    return ui32Status;
+}
+//-----------------------------------------------------------------------------
+void ADCIntClearEx(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tADCSequence *psSeq;
+    uint32_t i;
+
+    for(i = 0; i < 4 && (psSeq = ADCSequenceGet(ui32Base, i)) != NULL; i++)
+    {
+        psSeq->bRawInt &= (ui32IntFlags & (ADC_INT_SS0 << i)) == 0;
+        psSeq->bDMARawInt &= (ui32IntFlags & (ADC_INT_DMA_SS0 << i)) == 0;
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCSequenceDMAEnable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL)
+    {
+        psSeq->bDMAEnabled = true;
+    }
+}
+//-----------------------------------------------------------------------------
+void ADCSequenceDMADisable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL)
+    {
+        psSeq->bDMAEnabled = false;
+    }
+}
+//-----------------------------------------------------------------------------
+// Used by the uDMA model: the FIFO of the sequence has samples for its DMA channel
+bool HostADCDMARequest(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    return psSeq != NULL && psSeq->bDMAEnabled && psSeq->ui32FifoCount > 0;
+}
+//-----------------------------------------------------------------------------
+// Used by the uDMA model: oldest sample in the FIFO, like reading ADCSSFIFOn
+uint32_t HostADCFifoRead(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+    uint32_t ui32Value;
+
+    if(psSeq == NULL || psSeq->ui32FifoCount == 0)
+    {
+        return 0;
+    }
+    ui32Value = psSeq->pui32Fifo[0];
+    psSeq->ui32FifoCount--;
+    memmove(psSeq->pui32Fifo, psSeq->pui32Fifo + 1, psSeq->ui32FifoCount * sizeof(uint32_t));
+    return ui32Value;
+}
+//-----------------------------------------------------------------------------
+// Used by the uDMA model: a transfer of the sequence's channel is done
+void HostADCDMADone(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    tADCSequence *psSeq = ADCSequenceGet(ui32Base, ui32SequenceNum);
+
+    if(psSeq != NULL)
+    {
+        psSeq->bDMARawInt = true;
+        ADCSequenceInterrupt(psSeq);
+    }
+}
+//-----------------------------------------------------------------------------
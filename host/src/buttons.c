@@ -0,0 +1,50 @@
+//-----------------------------------------------------------------------------
+// Host drivers: buttons and pinout (EK-TM4C1294XL)
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "drivers/buttons.h"
+#include "drivers/pinout.h"
+#include "host.h"
+
+// Buttons that were pressed at the last poll
+static uint8_t g_ui8ButtonStates;
+
+//-----------------------------------------------------------------------------
+void PinoutSet(bool bEthernet, bool bUSB)
+{
+    (void)bEthernet;
+    (void)bUSB;
+}
+//-----------------------------------------------------------------------------
+void ButtonsInit(void)
+{
+    SysCtlPeripheralEnable(BUTTONS_GPIO_PERIPH);
+    GPIOPinTypeGPIOInput(BUTTONS_GPIO_BASE, ALL_BUTTONS);
+    g_ui8ButtonStates = 0;
+}
+//-----------------------------------------------------------------------------
+// The buttons are active low, a returned bit is 1 if the button is pressed
+// No debouncing needed, the input levels on the host do not bounce
+uint8_t ButtonsPoll(uint8_t *pui8Delta, uint8_t *pui8Raw)
+{
+    uint8_t ui8Pressed = ~GPIOPinRead(BUTTONS_GPIO_BASE, ALL_BUTTONS) & ALL_BUTTONS;
+
+    HostFrameMark(HOST_FRAME_POLL, __builtin_return_address(0));
+    if(pui8Raw != NULL)
+    {
+        *pui8Raw = ui8Pressed;
+    }
+    if(pui8Delta != NULL)
+    {
+        *pui8Delta = ui8Pressed ^ g_ui8ButtonStates;
+    }
+    g_ui8ButtonStates = ui8Pressed;
+    return ui8Pressed;
+}
+//-----------------------------------------------------------------------------
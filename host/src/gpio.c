@@ -0,0 +1,142 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: GPIO
+//
+// Every port is a direction register, an output latch and the level of the
+// pins outside the chip (input), GPIOPinRead returns the latch for output
+// pins and the input level for the others like the real data register.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "host.h"
+
+// Ports A to Q (no I and O), 0x1000 apart
+#define NUM_PORTS 15
+
+typedef struct
+{
+    // 1 is output
+    uint8_t ui8Dir;
+    // 1 is controlled by a peripheral (ADC, PWM, UART, SSI)
+    uint8_t ui8AltFunc;
+    uint8_t ui8Data;
+    uint8_t ui8Input;
+    // Input levels start high, like pins with pull-ups (the buttons are active low)
+    bool bInputSet;
+} tGPIOPort;
+
+static tGPIOPort g_psPorts[NUM_PORTS];
+
+//-----------------------------------------------------------------------------
+static tGPIOPort *GPIOPortGet(uint32_t ui32Port)
+{
+    uint32_t ui32Index = (ui32Port - GPIO_PORTA_AHB_BASE) >> 12;
+    tGPIOPort *psPort;
+
+    if(ui32Port < GPIO_PORTA_AHB_BASE || ui32Index >= NUM_PORTS)
+    {
+        return NULL;
+    }
+    psPort = &g_psPorts[ui32Index];
+    if(!psPort->bInputSet)
+    {
+        psPort->ui8Input = 0xFF;
+        psPort->bInputSet = true;
+    }
+    return psPort;
+}
+//-----------------------------------------------------------------------------
+void HostGPIOInputSet(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    tGPIOPort *psPort = GPIOPortGet(ui32Port);
+
+    if(psPort != NULL)
+    {
+        psPort->ui8Input = (psPort->ui8Input & ~ui8Pins) | (ui8Val & ui8Pins);
+    }
+}
+//-----------------------------------------------------------------------------
+uint8_t HostGPIOInputGet(uint32_t ui32Port)
+{
+    tGPIOPort *psPort = GPIOPortGet(ui32Port);
+
+    return (psPort != NULL) ? psPort->ui8Input : 0xFF;
+}
+//-----------------------------------------------------------------------------
+uint8_t HostGPIOOutputGet(uint32_t ui32Port)
+{
+    tGPIOPort *psPort = GPIOPortGet(ui32Port);
+    return (psPort != NULL) ? psPort->ui8Data : 0;
+}
+//-----------------------------------------------------------------------------
+static void GPIOPinType(uint32_t ui32Port, uint8_t ui8Pins, bool bOutput, bool bAltFunc)
+{
+    tGPIOPort *psPort = GPIOPortGet(ui32Port);
+
+    if(psPort == NULL)
+    {
+        return;
+    }
+    psPort->ui8Dir = bOutput ? (psPort->ui8Dir | ui8Pins) : (psPort->ui8Dir & ~ui8Pins);
+    psPort->ui8AltFunc = bAltFunc ? (psPort->ui8AltFunc | ui8Pins) : (psPort->ui8AltFunc & ~ui8Pins);
+}
+//-----------------------------------------------------------------------------
+void GPIOPinConfigure(uint32_t ui32PinConfig)
+{
+    (void)ui32PinConfig;
+}
+//-----------------------------------------------------------------------------
+void GPIOPinTypeADC(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIOPinType(ui32Port, ui8Pins, false, true);
+}
+//-----------------------------------------------------------------------------
+void GPIOPinTypeGPIOInput(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIOPinType(ui32Port, ui8Pins, false, false);
+}
+//-----------------------------------------------------------------------------
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIOPinType(ui32Port, ui8Pins, true, false);
+}
+//-----------------------------------------------------------------------------
+void GPIOPinTypePWM(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIOPinType(ui32Port, ui8Pins, true, true);
+}
+//-----------------------------------------------------------------------------
+void GPIOPinTypeSSI(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIOPinType(ui32Port, ui8Pins, true, true);
+}
+//-----------------------------------------------------------------------------
+void GPIOPinTypeUART(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIOPinType(ui32Port, ui8Pins, true, true);
+}
+//-----------------------------------------------------------------------------
+int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    tGPIOPort *psPort = GPIOPortGet(ui32Port);
+
+    if(psPort == NULL)
+    {
+        return 0;
+    }
+    return ((psPort->ui8Data & psPort->ui8Dir) | (psPort->ui8Input & ~psPort->ui8Dir)) & ui8Pins;
+}
+//-----------------------------------------------------------------------------
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    tGPIOPort *psPort = GPIOPortGet(ui32Port);
+
+    if(psPort != NULL)
+    {
+        psPort->ui8Data = (psPort->ui8Data & ~ui8Pins) | (ui8Val & ui8Pins);
+    }
+}
+//-----------------------------------------------------------------------------
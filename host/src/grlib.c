@@ -0,0 +1,328 @@
+//-----------------------------------------------------------------------------
+// Host grlib: the subset of TivaWare grlib used by the labs
+//
+// Same clipping and drawing rules as grlib, everything ends up in the
+// function pointers of the tDisplay the context was set up with.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "grlib/grlib.h"
+
+// Fixed 6x8 font: 5x7 glyphs and an empty column, one byte per column with bit 0 at the top
+static const uint8_t g_pui8FontFixed6x8Data[] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,   // space
+    0x00, 0x00, 0x5F, 0x00, 0x00, 0x00,   // !
+    0x00, 0x07, 0x00, 0x07, 0x00, 0x00,   // "
+    0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00,   // #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00,   // $
+    0x23, 0x13, 0x08, 0x64, 0x62, 0x00,   // %
+    0x36, 0x49, 0x55, 0x22, 0x50, 0x00,   // &
+    0x00, 0x05, 0x03, 0x00, 0x00, 0x00,   // '
+    0x00, 0x1C, 0x22, 0x41, 0x00, 0x00,   // (
+    0x00, 0x41, 0x22, 0x1C, 0x00, 0x00,   // )
+    0x14, 0x08, 0x3E, 0x08, 0x14, 0x00,   // *
+    0x08, 0x08, 0x3E, 0x08, 0x08, 0x00,   // +
+    0x00, 0x50, 0x30, 0x00, 0x00, 0x00,   // ,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00,   // -
+    0x00, 0x60, 0x60, 0x00, 0x00, 0x00,   // .
+    0x20, 0x10, 0x08, 0x04, 0x02, 0x00,   // /
+    0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00,   // 0
+    0x00, 0x42, 0x7F, 0x40, 0x00, 0x00,   // 1
+    0x42, 0x61, 0x51, 0x49, 0x46, 0x00,   // 2
+    0x21, 0x41, 0x45, 0x4B, 0x31, 0x00,   // 3
+    0x18, 0x14, 0x12, 0x7F, 0x10, 0x00,   // 4
+    0x27, 0x45, 0x45, 0x45, 0x39, 0x00,   // 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30, 0x00,   // 6
+    0x01, 0x71, 0x09, 0x05, 0x03, 0x00,   // 7
+    0x36, 0x49, 0x49, 0x49, 0x36, 0x00,   // 8
+    0x06, 0x49, 0x49, 0x29, 0x1E, 0x00,   // 9
+    0x00, 0x36, 0x36, 0x00, 0x00, 0x00,   // :
+    0x00, 0x56, 0x36, 0x00, 0x00, 0x00,   // ;
+    0x08, 0x14, 0x22, 0x41, 0x00, 0x00,   // <
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x00,   // =
+    0x00, 0x41, 0x22, 0x14, 0x08, 0x00,   // >
+    0x02, 0x01, 0x51, 0x09, 0x06, 0x00,   // ?
+    0x32, 0x49, 0x79, 0x41, 0x3E, 0x00,   // @
+    0x7E, 0x11, 0x11, 0x11, 0x7E, 0x00,   // A
+    0x7F, 0x49, 0x49, 0x49, 0x36, 0x00,   // B
+    0x3E, 0x41, 0x41, 0x41, 0x22, 0x00,   // C
+    0x7F, 0x41, 0x41, 0x22, 0x1C, 0x00,   // D
+    0x7F, 0x49, 0x49, 0x49, 0x41, 0x00,   // E
+    0x7F, 0x09, 0x09, 0x09, 0x01, 0x00,   // F
+    0x3E, 0x41, 0x49, 0x49, 0x7A, 0x00,   // G
+    0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00,   // H
+    0x00, 0x41, 0x7F, 0x41, 0x00, 0x00,   // I
+    0x20, 0x40, 0x41, 0x3F, 0x01, 0x00,   // J
+    0x7F, 0x08, 0x14, 0x22, 0x41, 0x00,   // K
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x00,   // L
+    0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x00,   // M
+    0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00,   // N
+    0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00,   // O
+    0x7F, 0x09, 0x09, 0x09, 0x06, 0x00,   // P
+    0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00,   // Q
+    0x7F, 0x09, 0x19, 0x29, 0x46, 0x00,   // R
+    0x46, 0x49, 0x49, 0x49, 0x31, 0x00,   // S
+    0x01, 0x01, 0x7F, 0x01, 0x01, 0x00,   // T
+    0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00,   // U
+    0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00,   // V
+    0x3F, 0x40, 0x38, 0x40, 0x3F, 0x00,   // W
+    0x63, 0x14, 0x08, 0x14, 0x63, 0x00,   // X
+    0x07, 0x08, 0x70, 0x08, 0x07, 0x00,   // Y
+    0x61, 0x51, 0x49, 0x45, 0x43, 0x00,   // Z
+    0x00, 0x7F, 0x41, 0x41, 0x00, 0x00,   // [
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x00,   // backslash
+    0x00, 0x41, 0x41, 0x7F, 0x00, 0x00,   // ]
+    0x04, 0x02, 0x01, 0x02, 0x04, 0x00,   // ^
+    0x40, 0x40, 0x40, 0x40, 0x40, 0x00,   // _
+    0x00, 0x01, 0x02, 0x04, 0x00, 0x00,   // `
+    0x20, 0x54, 0x54, 0x54, 0x78, 0x00,   // a
+    0x7F, 0x48, 0x44, 0x44, 0x38, 0x00,   // b
+    0x38, 0x44, 0x44, 0x44, 0x20, 0x00,   // c
+    0x38, 0x44, 0x44, 0x48, 0x7F, 0x00,   // d
+    0x38, 0x54, 0x54, 0x54, 0x18, 0x00,   // e
+    0x08, 0x7E, 0x09, 0x01, 0x02, 0x00,   // f
+    0x0C, 0x52, 0x52, 0x52, 0x3E, 0x00,   // g
+    0x7F, 0x08, 0x04, 0x04, 0x78, 0x00,   // h
+    0x00, 0x44, 0x7D, 0x40, 0x00, 0x00,   // i
+    0x20, 0x40, 0x44, 0x3D, 0x00, 0x00,   // j
+    0x7F, 0x10, 0x28, 0x44, 0x00, 0x00,   // k
+    0x00, 0x41, 0x7F, 0x40, 0x00, 0x00,   // l
+    0x7C, 0x04, 0x18, 0x04, 0x78, 0x00,   // m
+    0x7C, 0x08, 0x04, 0x04, 0x78, 0x00,   // n
+    0x38, 0x44, 0x44, 0x44, 0x38, 0x00,   // o
+    0x7C, 0x14, 0x14, 0x14, 0x08, 0x00,   // p
+    0x08, 0x14, 0x14, 0x18, 0x7C, 0x00,   // q
+    0x7C, 0x08, 0x04, 0x04, 0x08, 0x00,   // r
+    0x48, 0x54, 0x54, 0x54, 0x20, 0x00,   // s
+    0x04, 0x3F, 0x44, 0x40, 0x20, 0x00,   // t
+    0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00,   // u
+    0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00,   // v
+    0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00,   // w
+    0x44, 0x28, 0x10, 0x28, 0x44, 0x00,   // x
+    0x0C, 0x50, 0x50, 0x50, 0x3C, 0x00,   // y
+    0x44, 0x64, 0x54, 0x4C, 0x44, 0x00,   // z
+    0x00, 0x08, 0x36, 0x41, 0x00, 0x00,   // {
+    0x00, 0x00, 0x7F, 0x00, 0x00, 0x00,   // |
+    0x00, 0x41, 0x36, 0x08, 0x00, 0x00,   // }
+    0x08, 0x04, 0x08, 0x10, 0x08, 0x00,   // ~
+};
+const tFont g_sFontFixed6x8 = {0, 6, 8, 7, g_pui8FontFixed6x8Data};
+
+//-----------------------------------------------------------------------------
+void GrContextInit(tContext *pContext, const tDisplay *pDisplay)
+{
+    memset(pContext, 0, sizeof(tContext));
+    pContext->i32Size = sizeof(tContext);
+    pContext->psDisplay = pDisplay;
+    pContext->sClipRegion.i16XMin = 0;
+    pContext->sClipRegion.i16YMin = 0;
+    pContext->sClipRegion.i16XMax = pDisplay->ui16Width - 1;
+    pContext->sClipRegion.i16YMax = pDisplay->ui16Height - 1;
+}
+//-----------------------------------------------------------------------------
+void GrContextForegroundSet(tContext *pContext, uint32_t ui32Value)
+{
+    pContext->ui32Foreground = pContext->psDisplay->pfnColorTranslate(pContext->psDisplay->pvDisplayData, ui32Value);
+}
+//-----------------------------------------------------------------------------
+void GrContextBackgroundSet(tContext *pContext, uint32_t ui32Value)
+{
+    pContext->ui32Background = pContext->psDisplay->pfnColorTranslate(pContext->psDisplay->pvDisplayData, ui32Value);
+}
+//-----------------------------------------------------------------------------
+void GrContextFontSet(tContext *pContext, const tFont *pFont)
+{
+    pContext->psFont = pFont;
+}
+//-----------------------------------------------------------------------------
+// Clip region is clamped to the display
+void GrContextClipRegionSet(tContext *pContext, tRectangle *pRect)
+{
+    int32_t i32W = pContext->psDisplay->ui16Width;
+    int32_t i32H = pContext->psDisplay->ui16Height;
+
+    pContext->sClipRegion.i16XMin = (pRect->i16XMin < 0) ? 0 : pRect->i16XMin;
+    pContext->sClipRegion.i16YMin = (pRect->i16YMin < 0) ? 0 : pRect->i16YMin;
+    pContext->sClipRegion.i16XMax = (pRect->i16XMax >= i32W) ? (i32W - 1) : pRect->i16XMax;
+    pContext->sClipRegion.i16YMax = (pRect->i16YMax >= i32H) ? (i32H - 1) : pRect->i16YMax;
+}
+//-----------------------------------------------------------------------------
+void GrPixelDraw(const tContext *pContext, int32_t i32X, int32_t i32Y)
+{
+    const tRectangle *psClip = &pContext->sClipRegion;
+
+    if(i32X < psClip->i16XMin || i32X > psClip->i16XMax || i32Y < psClip->i16YMin || i32Y > psClip->i16YMax)
+    {
+        return;
+    }
+    pContext->psDisplay->pfnPixelDraw(pContext->psDisplay->pvDisplayData, i32X, i32Y, pContext->ui32Foreground);
+}
+//-----------------------------------------------------------------------------
+void GrLineDrawH(const tContext *pContext, int32_t i32X1, int32_t i32X2, int32_t i32Y)
+{
+    const tRectangle *psClip = &pContext->sClipRegion;
+    int32_t i32Temp;
+
+    if(i32X1 > i32X2)
+    {
+        i32Temp = i32X1;
+        i32X1 = i32X2;
+        i32X2 = i32Temp;
+    }
+    if(i32Y < psClip->i16YMin || i32Y > psClip->i16YMax || i32X2 < psClip->i16XMin || i32X1 > psClip->i16XMax)
+    {
+        return;
+    }
+    i32X1 = (i32X1 < psClip->i16XMin) ? psClip->i16XMin : i32X1;
+    i32X2 = (i32X2 > psClip->i16XMax) ? psClip->i16XMax : i32X2;
+    pContext->psDisplay->pfnLineDrawH(pContext->psDisplay->pvDisplayData, i32X1, i32X2, i32Y, pContext->ui32Foreground);
+}
+//-----------------------------------------------------------------------------
+void GrLineDrawV(const tContext *pContext, int32_t i32X, int32_t i32Y1, int32_t i32Y2)
+{
+    const tRectangle *psClip = &pContext->sClipRegion;
+    int32_t i32Temp;
+
+    if(i32Y1 > i32Y2)
+    {
+        i32Temp = i32Y1;
+        i32Y1 = i32Y2;
+        i32Y2 = i32Temp;
+    }
+    if(i32X < psClip->i16XMin || i32X > psClip->i16XMax || i32Y2 < psClip->i16YMin || i32Y1 > psClip->i16YMax)
+    {
+        return;
+    }
+    i32Y1 = (i32Y1 < psClip->i16YMin) ? psClip->i16YMin : i32Y1;
+    i32Y2 = (i32Y2 > psClip->i16YMax) ? psClip->i16YMax : i32Y2;
+    pContext->psDisplay->pfnLineDrawV(pContext->psDisplay->pvDisplayData, i32X, i32Y1, i32Y2, pContext->ui32Foreground);
+}
+//-----------------------------------------------------------------------------
+// Fill pRect (inclusive), clipped to the clip region
+void GrRectFill(const tContext *pContext, const tRectangle *pRect)
+{
+    const tRectangle *psClip = &pContext->sClipRegion;
+    tRectangle sTemp = *pRect;
+
+    sTemp.i16XMin = (sTemp.i16XMin < psClip->i16XMin) ? psClip->i16XMin : sTemp.i16XMin;
+    sTemp.i16YMin = (sTemp.i16YMin < psClip->i16YMin) ? psClip->i16YMin : sTemp.i16YMin;
+    sTemp.i16XMax = (sTemp.i16XMax > psClip->i16XMax) ? psClip->i16XMax : sTemp.i16XMax;
+    sTemp.i16YMax = (sTemp.i16YMax > psClip->i16YMax) ? psClip->i16YMax : sTemp.i16YMax;
+    if(sTemp.i16XMin > sTemp.i16XMax || sTemp.i16YMin > sTemp.i16YMax)
+    {
+        return;
+    }
+    pContext->psDisplay->pfnRectFill(pContext->psDisplay->pvDisplayData, &sTemp, pContext->ui32Foreground);
+}
+//-----------------------------------------------------------------------------
+// Returns 1 if the rectangles overlap (edges included)
+int32_t GrRectOverlapCheck(tRectangle *psRect1, tRectangle *psRect2)
+{
+    if((psRect1->i16XMax < psRect2->i16XMin) || (psRect2->i16XMax < psRect1->i16XMin) ||
+       (psRect1->i16YMax < psRect2->i16YMin) || (psRect2->i16YMax < psRect1->i16YMin))
+    {
+        return 0;
+    }
+    return 1;
+}
+//-----------------------------------------------------------------------------
+// i32Length -1 means the whole (zero terminated) string
+int32_t GrStringWidthGet(const tContext *pContext, const char *pcString, int32_t i32Length)
+{
+    int32_t i32Count = 0;
+
+    while(pcString[i32Count] != 0 && (i32Length < 0 || i32Count < i32Length))
+    {
+        i32Count++;
+    }
+    return i32Count * pContext->psFont->ui8MaxWidth;
+}
+//-----------------------------------------------------------------------------
+// Upper left corner of the text at i32X, i32Y, pixels not in a glyph are only drawn if bOpaque
+// Like grlib every row of a glyph is one driver call: a 1 bpp pixel row if opaque,
+// otherwise a horizontal line per run of set pixels
+void GrStringDraw(const tContext *pContext, const char *pcString, int32_t i32Length,
+                  int32_t i32X, int32_t i32Y, bool bOpaque)
+{
+    const tFont *psFont = pContext->psFont;
+    const tRectangle *psClip = &pContext->sClipRegion;
+    const tDisplay *psDisplay = pContext->psDisplay;
+    const uint8_t *pui8Glyph;
+    uint32_t pui32Palette[2];
+    uint8_t pui8Row[4];
+    int32_t i32Width = psFont->ui8MaxWidth;
+    int32_t i32Col;
+    int32_t i32Row;
+    int32_t i32X1;
+    int32_t i32X2;
+    int32_t i32Run;
+
+    pui32Palette[0] = pContext->ui32Background;
+    pui32Palette[1] = pContext->ui32Foreground;
+    for(; *pcString != 0 && i32Length != 0; pcString++, i32Length--, i32X += i32Width)
+    {
+        // Visible columns of this glyph
+        i32X1 = (i32X < psClip->i16XMin) ? psClip->i16XMin : i32X;
+        i32X2 = (i32X + i32Width - 1 > psClip->i16XMax) ? psClip->i16XMax : (i32X + i32Width - 1);
+        if(i32X1 > i32X2)
+        {
+            continue;
+        }
+        pui8Glyph = NULL;
+        if(psFont->pui8Data != NULL && *pcString >= ' ' && *pcString <= '~')
+        {
+            pui8Glyph = &psFont->pui8Data[(*pcString - ' ') * i32Width];
+        }
+        for(i32Row = 0; i32Row < psFont->ui8Height; i32Row++)
+        {
+            if(i32Y + i32Row < psClip->i16YMin || i32Y + i32Row > psClip->i16YMax)
+            {
+                continue;
+            }
+            // Row of the glyph as bits, MSB first
+            memset(pui8Row, 0, sizeof(pui8Row));
+            for(i32Col = 0; pui8Glyph != NULL && i32Col < i32Width; i32Col++)
+            {
+                if((pui8Glyph[i32Col] >> i32Row) & 1)
+                {
+                    pui8Row[i32Col / 8] |= 0x80 >> (i32Col % 8);
+                }
+            }
+            if(bOpaque)
+            {
+                psDisplay->pfnPixelDrawMultiple(psDisplay->pvDisplayData, i32X1, i32Y + i32Row, i32X1 - i32X,
+                                                i32X2 - i32X1 + 1, 1, pui8Row, (const uint8_t *)pui32Palette);
+                continue;
+            }
+            for(i32Col = i32X1 - i32X; i32Col <= i32X2 - i32X; i32Col++)
+            {
+                for(i32Run = i32Col; i32Run <= i32X2 - i32X && (pui8Row[i32Run / 8] & (0x80 >> (i32Run % 8))); i32Run++)
+                    ;
+                if(i32Run > i32Col)
+                {
+                    psDisplay->pfnLineDrawH(psDisplay->pvDisplayData, i32X + i32Col, i32X + i32Run - 1,
+                                            i32Y + i32Row, pContext->ui32Foreground);
+                    i32Col = i32Run;
+                }
+            }
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+// Text centered around i32X, i32Y (same rounding as the grlib macro)
+void GrStringDrawCentered(const tContext *pContext, const char *pcString, int32_t i32Length,
+                          int32_t i32X, int32_t i32Y, bool bOpaque)
+{
+    GrStringDraw(pContext, pcString, i32Length,
+                 i32X - (GrStringWidthGet(pContext, pcString, i32Length) / 2),
+                 i32Y - (pContext->psFont->ui8Baseline / 2), bOpaque);
+}
+//-----------------------------------------------------------------------------
+void GrFlush(const tContext *pContext)
+{
+    pContext->psDisplay->pfnFlush(pContext->psDisplay->pvDisplayData);
+}
+//-----------------------------------------------------------------------------
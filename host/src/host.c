@@ -0,0 +1,218 @@
+//-----------------------------------------------------------------------------
+// Host HAL control: environment input, frame counting
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "inc/hw_memmap.h"
+#include "host.h"
+
+static tHostFrameHook g_pfnFrameHook;
+static uint32_t g_ui32Frame;
+static uint32_t g_ui32FrameLimit;
+// Place in the program that ends a frame, per kind of call (HOST_FRAME_DELAY, HOST_FRAME_POLL)
+static void *g_pvFrameSite[2];
+static uint32_t g_ui32Headless;
+static struct timespec g_sStart;
+
+//-----------------------------------------------------------------------------
+// GPIO port base from its letter, 0 if there is no such port
+uint32_t HostGPIOPortBase(char cPort)
+{
+    static const char pcPorts[] = "ABCDEFGHJKLMNPQ";
+    const char *pcFound = strchr(pcPorts, cPort);
+
+    if(cPort == 0 || pcFound == NULL)
+    {
+        return 0;
+    }
+    return GPIO_PORTA_AHB_BASE + (uint32_t)(pcFound - pcPorts) * 0x1000;
+}
+//-----------------------------------------------------------------------------
+void HostFrameHookSet(tHostFrameHook pfnHook)
+{
+    g_pfnFrameHook = pfnHook;
+}
+//-----------------------------------------------------------------------------
+uint32_t HostFrameCount(void)
+{
+    return g_ui32Frame;
+}
+//-----------------------------------------------------------------------------
+// End of the run (HOST_FRAMES reached or end of the replay)
+static void HostExit(void)
+{
+    struct timespec sNow;
+    double dSeconds;
+
+    fflush(stdout);
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    dSeconds = (sNow.tv_sec - g_sStart.tv_sec) + (sNow.tv_nsec - g_sStart.tv_nsec) / 1e9;
+    fprintf(stderr, "host: %u frames in %.3f s (%.0f ns/frame)\n", g_ui32Frame, dSeconds,
+            dSeconds * 1e9 / g_ui32Frame);
+    exit(0);
+}
+//-----------------------------------------------------------------------------
+void HostFrameMark(uint32_t ui32Kind, void *pvSite)
+{
+    if(g_pvFrameSite[ui32Kind] == NULL)
+    {
+        g_pvFrameSite[ui32Kind] = pvSite;
+        // A poll is at the top of the loop, the first one starts frame 0 instead of ending it
+        if(ui32Kind == HOST_FRAME_POLL)
+        {
+            return;
+        }
+    }
+    if(pvSite != g_pvFrameSite[ui32Kind])
+    {
+        return;
+    }
+    // Programs that wait once per frame only count the waits
+    if(ui32Kind == HOST_FRAME_POLL && g_pvFrameSite[HOST_FRAME_DELAY] != NULL)
+    {
+        return;
+    }
+
+    HostDisplayFrameEnd(g_ui32Frame);
+    if(g_pfnFrameHook != NULL)
+    {
+        g_pfnFrameHook(g_ui32Frame);
+    }
+    g_ui32Frame++;
+    if(g_ui32FrameLimit != 0 && g_ui32Frame >= g_ui32FrameLimit)
+    {
+        HostExit();
+    }
+    HostScriptFrame(g_ui32Frame);
+    if(!HostTraceFrame(g_ui32Frame))
+    {
+        HostExit();
+    }
+}
+//-----------------------------------------------------------------------------
+// Set ADC channels from "ch:value,...", returns where parsing stopped
+const char *HostADCListSet(const char *pcList)
+{
+    char *pcEnd;
+    uint32_t ui32Channel;
+    uint32_t ui32Value;
+
+    while(*pcList != 0)
+    {
+        ui32Channel = strtoul(pcList, &pcEnd, 0);
+        if(*pcEnd != ':')
+        {
+            break;
+        }
+        ui32Value = strtoul(pcEnd + 1, &pcEnd, 0);
+        HostADCChannelSet(ui32Channel, ui32Value);
+        pcList = pcEnd;
+        if(*pcList != ',')
+        {
+            break;
+        }
+        pcList++;
+    }
+    return pcList;
+}
+//-----------------------------------------------------------------------------
+// Set GPIO input levels from "port:value,...", returns where parsing stopped
+const char *HostGPIOListSet(const char *pcList)
+{
+    char *pcEnd;
+    uint32_t ui32Port;
+    uint32_t ui32Value;
+
+    while(*pcList != 0)
+    {
+        ui32Port = HostGPIOPortBase(pcList[0]);
+        if(ui32Port == 0 || pcList[1] != ':')
+        {
+            break;
+        }
+        ui32Value = strtoul(pcList + 2, &pcEnd, 0);
+        HostGPIOInputSet(ui32Port, 0xFF, (uint8_t)ui32Value);
+        pcList = pcEnd;
+        if(*pcList != ',')
+        {
+            break;
+        }
+        pcList++;
+    }
+    return pcList;
+}
+//-----------------------------------------------------------------------------
+uint32_t HostHeadlessGet(void)
+{
+    return g_ui32Headless;
+}
+//-----------------------------------------------------------------------------
+// Read the HOST_ environment variables before main runs
+__attribute__((constructor))
+static void HostEnvRead(void)
+{
+    const char *pcEnv;
+    const char *pcFrom;
+
+    pcEnv = getenv("HOST_ADC");
+    if(pcEnv != NULL)
+    {
+        HostADCListSet(pcEnv);
+    }
+    pcEnv = getenv("HOST_WAV");
+    if(pcEnv != NULL && (strchr(pcEnv, ':') == NULL ||
+                         !HostADCWavLoad(strtoul(pcEnv, NULL, 0), strchr(pcEnv, ':') + 1)))
+    {
+        fprintf(stderr, "host: can not read WAV file %s\n", pcEnv);
+        exit(1);
+    }
+    pcEnv = getenv("HOST_GPIO");
+    if(pcEnv != NULL)
+    {
+        HostGPIOListSet(pcEnv);
+    }
+    pcEnv = getenv("HOST_FRAMES");
+    if(pcEnv != NULL)
+    {
+        g_ui32FrameLimit = strtoul(pcEnv, NULL, 0);
+    }
+    pcEnv = getenv("HOST_HEADLESS");
+    if(pcEnv != NULL)
+    {
+        g_ui32Headless = strtoul(pcEnv, NULL, 0) != 0;
+    }
+    pcEnv = getenv("HOST_SCRIPT");
+    if(pcEnv != NULL && !HostScriptLoad(pcEnv))
+    {
+        fprintf(stderr, "host: can not read script %s\n", pcEnv);
+        exit(1);
+    }
+    pcEnv = getenv("HOST_SEED");
+    if(pcEnv != NULL)
+    {
+        srand(strtoul(pcEnv, NULL, 0));
+    }
+    pcEnv = getenv("HOST_REPLAY");
+    if(pcEnv != NULL)
+    {
+        pcFrom = getenv("HOST_REPLAY_FROM");
+        if(!HostReplayStart(pcEnv, (pcFrom != NULL) ? strtoul(pcFrom, NULL, 0) : 0))
+        {
+            fprintf(stderr, "host: can not replay trace %s\n", pcEnv);
+            exit(1);
+        }
+    }
+    // After the replay has set the input, so a replay can be recorded again (for example to cut it at HOST_REPLAY_FROM)
+    pcEnv = getenv("HOST_RECORD");
+    if(pcEnv != NULL && !HostRecordStart(pcEnv))
+    {
+        fprintf(stderr, "host: can not write trace %s\n", pcEnv);
+        exit(1);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &g_sStart);
+}
+//-----------------------------------------------------------------------------
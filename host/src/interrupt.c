@@ -0,0 +1,114 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: interrupt controller
+//
+// Peripheral models raise interrupts with HostIntTrigger. The handler (set
+// with IntRegister or a peripheral's ...IntRegister) runs right away, on the
+// stack of whatever code caused the interrupt, if the interrupt is enabled and
+// interrupts are not masked. Otherwise the interrupt stays pending and runs
+// when it is enabled. There are no priorities: an interrupt raised by a
+// handler runs after that handler returns, like one of the same priority.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "driverlib/interrupt.h"
+#include "host.h"
+
+// Interrupt numbers are vector numbers, the TM4C129 has fewer than this
+#define NUM_INTERRUPTS 256
+
+static void (*g_ppfnHandlers[NUM_INTERRUPTS])(void);
+static bool g_pbEnabled[NUM_INTERRUPTS];
+static bool g_pbPending[NUM_INTERRUPTS];
+static bool g_bIntMasterDisabled;
+// In a handler, pending interrupts run when it returns
+static bool g_bInHandler;
+// Handlers run since start
+static uint32_t g_ui32Handled;
+
+//-----------------------------------------------------------------------------
+// Run the pending interrupts that can run, lowest number first
+static void IntDispatch(void)
+{
+    uint32_t ui32Int;
+
+    if(g_bInHandler)
+    {
+        return;
+    }
+    g_bInHandler = true;
+    for(ui32Int = 0; ui32Int < NUM_INTERRUPTS && !g_bIntMasterDisabled; ui32Int++)
+    {
+        if(g_pbPending[ui32Int] && g_pbEnabled[ui32Int] && g_ppfnHandlers[ui32Int] != NULL)
+        {
+            g_pbPending[ui32Int] = false;
+            g_ui32Handled++;
+            g_ppfnHandlers[ui32Int]();
+            // A handler may have raised a lower numbered one
+            ui32Int = (uint32_t)-1;
+        }
+    }
+    g_bInHandler = false;
+}
+//-----------------------------------------------------------------------------
+void HostIntTrigger(uint32_t ui32Interrupt)
+{
+    if(ui32Interrupt < NUM_INTERRUPTS)
+    {
+        g_pbPending[ui32Interrupt] = true;
+        IntDispatch();
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t HostIntCount(void)
+{
+    return g_ui32Handled;
+}
+//-----------------------------------------------------------------------------
+// Return the previous state like the target version (true if interrupts were disabled)
+bool IntMasterEnable(void)
+{
+    bool bOld = g_bIntMasterDisabled;
+    g_bIntMasterDisabled = false;
+    IntDispatch();
+    return bOld;
+}
+//-----------------------------------------------------------------------------
+bool IntMasterDisable(void)
+{
+    bool bOld = g_bIntMasterDisabled;
+    g_bIntMasterDisabled = true;
+    return bOld;
+}
+//-----------------------------------------------------------------------------
+void IntEnable(uint32_t ui32Interrupt)
+{
+    if(ui32Interrupt < NUM_INTERRUPTS)
+    {
+        g_pbEnabled[ui32Interrupt] = true;
+        IntDispatch();
+    }
+}
+//-----------------------------------------------------------------------------
+void IntDisable(uint32_t ui32Interrupt)
+{
+    if(ui32Interrupt < NUM_INTERRUPTS)
+    {
+        g_pbEnabled[ui32Interrupt] = false;
+    }
+}
+//-----------------------------------------------------------------------------
+void IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void))
+{
+    if(ui32Interrupt < NUM_INTERRUPTS)
+    {
+        g_ppfnHandlers[ui32Interrupt] = pfnHandler;
+    }
+}
+//-----------------------------------------------------------------------------
+void IntUnregister(uint32_t ui32Interrupt)
+{
+    IntRegister(ui32Interrupt, NULL);
+}
+//-----------------------------------------------------------------------------
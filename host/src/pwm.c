@@ -0,0 +1,227 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: PWM
+// Keeps the settings, HostPWMPulseWidthGet/HostPWMOutputStateGet read them
+// back. The outputs are not modelled, only the ADC trigger of a generator
+// (PWMGenIntTrigEnable with PWM_TR_CNT_ZERO or PWM_TR_CNT_LOAD): once per
+// period of the generator on the virtual clock (host/src/sysctl.c), it starts
+// the ADC sequences that have ADC_TRIGGER_PWMn. The PWM clock is the system
+// clock divided as set with PWMClockSet. The load register of a generator is
+// 16 bits like on the target, a longer period wraps.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "inc/hw_memmap.h"
+#include "driverlib/pwm.h"
+#include "host.h"
+
+typedef struct
+{
+    uint32_t ui32Config;
+    uint32_t ui32Period;
+    bool bEnabled;
+    uint32_t ui32IntTrig;
+    // Cycle count of the next end of a period
+    uint64_t ui64Next;
+} tPWMGen;
+
+static tPWMGen g_psGens[4];
+static uint32_t g_ui32ClockConfig = PWM_SYSCLK_DIV_1;
+static uint32_t g_pui32Width[8];
+static uint32_t g_ui32OutputState;
+
+//-----------------------------------------------------------------------------
+// PWM_GEN_n is (n+1) << 6, PWM_OUT_n is its generator | n
+static tPWMGen *PWMGenGet(uint32_t ui32Base, uint32_t ui32Gen)
+{
+    uint32_t ui32Index = (ui32Gen >> 6) - 1;
+
+    if(ui32Base != PWM0_BASE || ui32Index > 3)
+    {
+        return NULL;
+    }
+    return &g_psGens[ui32Index];
+}
+//-----------------------------------------------------------------------------
+// PWM_SYSCLK_DIV_2 to _64 are 0x100 | log2(divider) - 1
+static uint32_t PWMClockDiv(void)
+{
+    return (g_ui32ClockConfig & 0x100) ? 2u << (g_ui32ClockConfig & 7) : 1;
+}
+//-----------------------------------------------------------------------------
+// System clock cycles per period of the generator, 0 if it has no period
+static uint64_t PWMGenCycles(const tPWMGen *psGen)
+{
+    return (uint64_t)psGen->ui32Period * PWMClockDiv();
+}
+//-----------------------------------------------------------------------------
+// Cycle count of the next ADC trigger of any generator, UINT64_MAX if none triggers
+uint64_t HostPWMNextEvent(void)
+{
+    uint64_t ui64Next = UINT64_MAX;
+    int i;
+
+    for(i = 0; i < 4; i++)
+    {
+        if(g_psGens[i].bEnabled && (g_psGens[i].ui32IntTrig & (PWM_TR_CNT_ZERO | PWM_TR_CNT_LOAD)) &&
+           PWMGenCycles(&g_psGens[i]) != 0 && g_psGens[i].ui64Next < ui64Next)
+        {
+            ui64Next = g_psGens[i].ui64Next;
+        }
+    }
+    return ui64Next;
+}
+//-----------------------------------------------------------------------------
+// The virtual clock is at ui64Now, run the ADC triggers that are due
+void HostPWMEvents(uint64_t ui64Now)
+{
+    tPWMGen *psGen;
+    uint64_t ui64Cycles;
+    int i;
+
+    for(i = 0; i < 4; i++)
+    {
+        psGen = &g_psGens[i];
+        ui64Cycles = PWMGenCycles(psGen);
+        if(!psGen->bEnabled || ui64Cycles == 0 || psGen->ui64Next > ui64Now)
+        {
+            continue;
+        }
+        psGen->ui64Next += ui64Cycles;
+        if(psGen->ui32IntTrig & (PWM_TR_CNT_ZERO | PWM_TR_CNT_LOAD))
+        {
+            HostADCPWMTrigger(i, ui64Now);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config)
+{
+    tPWMGen *psGen = PWMGenGet(ui32Base, ui32Gen);
+
+    if(psGen != NULL)
+    {
+        psGen->ui32Config = ui32Config;
+    }
+}
+//-----------------------------------------------------------------------------
+void PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period)
+{
+    tPWMGen *psGen = PWMGenGet(ui32Base, ui32Gen);
+
+    if(psGen == NULL)
+    {
+        return;
+    }
+    // What the 16 bit load register gives back: period / 2 counting up and down, period - 1 counting down
+    if(psGen->ui32Config & PWM_GEN_MODE_UP_DOWN)
+    {
+        psGen->ui32Period = ((ui32Period / 2) & 0xFFFF) * 2;
+    }
+    else
+    {
+        psGen->ui32Period = ((ui32Period - 1) & 0xFFFF) + 1;
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t PWMGenPeriodGet(uint32_t ui32Base, uint32_t ui32Gen)
+{
+    tPWMGen *psGen = PWMGenGet(ui32Base, ui32Gen);
+    return (psGen != NULL) ? psGen->ui32Period : 0;
+}
+//-----------------------------------------------------------------------------
+void PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen)
+{
+    tPWMGen *psGen = PWMGenGet(ui32Base, ui32Gen);
+
+    if(psGen != NULL && !psGen->bEnabled)
+    {
+        psGen->bEnabled = true;
+        psGen->ui64Next = HostCycleCount() + PWMGenCycles(psGen);
+    }
+}
+//-----------------------------------------------------------------------------
+void PWMGenDisable(uint32_t ui32Base, uint32_t ui32Gen)
+{
+    tPWMGen *psGen = PWMGenGet(ui32Base, ui32Gen);
+
+    if(psGen != NULL)
+    {
+        psGen->bEnabled = false;
+    }
+}
+//-----------------------------------------------------------------------------
+void PWMGenIntTrigEnable(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32IntTrig)
+{
+    tPWMGen *psGen = PWMGenGet(ui32Base, ui32Gen);
+    uint64_t ui64Cycles;
+    uint64_t ui64Now = HostCycleCount();
+
+    if(psGen == NULL)
+    {
+        return;
+    }
+    psGen->ui32IntTrig |= ui32IntTrig;
+    // Periods that ended while it had no trigger are not events, go on from the current one
+    ui64Cycles = PWMGenCycles(psGen);
+    if(psGen->bEnabled && ui64Cycles != 0 && psGen->ui64Next < ui64Now)
+    {
+        psGen->ui64Next += (ui64Now - psGen->ui64Next + ui64Cycles - 1) / ui64Cycles * ui64Cycles;
+    }
+}
+//-----------------------------------------------------------------------------
+void PWMGenIntTrigDisable(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32IntTrig)
+{
+    tPWMGen *psGen = PWMGenGet(ui32Base, ui32Gen);
+
+    if(psGen != NULL)
+    {
+        psGen->ui32IntTrig &= ~ui32IntTrig;
+    }
+}
+//-----------------------------------------------------------------------------
+void PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width)
+{
+    if(ui32Base == PWM0_BASE)
+    {
+        g_pui32Width[ui32PWMOut & 7] = ui32Width;
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t PWMPulseWidthGet(uint32_t ui32Base, uint32_t ui32PWMOut)
+{
+    return (ui32Base == PWM0_BASE) ? g_pui32Width[ui32PWMOut & 7] : 0;
+}
+//-----------------------------------------------------------------------------
+uint32_t HostPWMPulseWidthGet(uint32_t ui32Base, uint32_t ui32PWMOut)
+{
+    return PWMPulseWidthGet(ui32Base, ui32PWMOut);
+}
+//-----------------------------------------------------------------------------
+void PWMClockSet(uint32_t ui32Base, uint32_t ui32Config)
+{
+    if(ui32Base == PWM0_BASE)
+    {
+        g_ui32ClockConfig = ui32Config;
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t PWMClockGet(uint32_t ui32Base)
+{
+    return (ui32Base == PWM0_BASE) ? g_ui32ClockConfig : 0;
+}
+//-----------------------------------------------------------------------------
+void PWMOutputState(uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable)
+{
+    if(ui32Base == PWM0_BASE)
+    {
+        g_ui32OutputState = bEnable ? (g_ui32OutputState | ui32PWMOutBits) : (g_ui32OutputState & ~ui32PWMOutBits);
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t HostPWMOutputStateGet(uint32_t ui32Base)
+{
+    return (ui32Base == PWM0_BASE) ? g_ui32OutputState : 0;
+}
+//-----------------------------------------------------------------------------
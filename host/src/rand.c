@@ -0,0 +1,54 @@
+//-----------------------------------------------------------------------------
+// rand()/srand() of the TI ARM C library
+//
+// The games scale rand() with RAND_MAX of the target (32767), glibc's rand
+// goes up to 2^31-1 which would put food, balls and asteroids off screen.
+// This also gives the same sequence as on the target for the same seed.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "host.h"
+
+static unsigned long g_ulNext = 1;
+// rand() calls since the start, traces store how many there were in each frame
+static uint32_t g_ui32Calls;
+
+//-----------------------------------------------------------------------------
+int rand(void)
+{
+    g_ui32Calls++;
+    g_ulNext = g_ulNext * 1103515245 + 12345;
+    return (int)((unsigned int)(g_ulNext / 65536) % 32768);
+}
+//-----------------------------------------------------------------------------
+void srand(unsigned int uiSeed)
+{
+    g_ulNext = uiSeed;
+}
+//-----------------------------------------------------------------------------
+// For traces, the whole state is the seed of the rest of the sequence
+uint32_t HostRandStateGet(void)
+{
+    return (uint32_t)g_ulNext;
+}
+//-----------------------------------------------------------------------------
+void HostRandStateSet(uint32_t ui32State)
+{
+    g_ulNext = ui32State;
+}
+//-----------------------------------------------------------------------------
+uint32_t HostRandCallsGet(void)
+{
+    return g_ui32Calls;
+}
+//-----------------------------------------------------------------------------
+// Step the state on as ui32Calls calls of rand() would
+void HostRandAdvance(uint32_t ui32Calls)
+{
+    while(ui32Calls-- != 0)
+    {
+        g_ulNext = g_ulNext * 1103515245 + 12345;
+    }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,127 @@
+//-----------------------------------------------------------------------------
+// Host HAL control: scripted input
+//
+// A script is a text file with one event per line, the frame it happens at
+// (before that frame runs) and what to do, lines must be in frame order:
+//   # comment
+//   0    adc 9:4095,0:2048    set ADC channels (same as HOST_ADC)
+//   120  gpio L:0xFB          set GPIO input levels (same as HOST_GPIO)
+//   300  random 9,0           give these ADC channels a new random value every frame
+//   900  random               stop the random input
+// The random input has its own generator, so it does not change what rand()
+// returns to the game.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host.h"
+
+#define SCRIPT_LINE_MAX         256
+#define SCRIPT_RANDOM_MAX       8
+
+typedef struct
+{
+    uint32_t ui32Frame;
+    // Text after the frame number
+    char *pcAction;
+} tScriptEvent;
+
+static tScriptEvent *g_psEvents;
+static uint32_t g_ui32EventCount;
+static uint32_t g_ui32EventNext;
+// ADC channels with random input
+static uint32_t g_pui32Random[SCRIPT_RANDOM_MAX];
+static uint32_t g_ui32RandomCount;
+static uint32_t g_ui32RandomState = 1;
+
+//-----------------------------------------------------------------------------
+static void ScriptRandomSet(const char *pcList)
+{
+    char *pcEnd;
+
+    g_ui32RandomCount = 0;
+    while(*pcList != 0 && g_ui32RandomCount < SCRIPT_RANDOM_MAX)
+    {
+        g_pui32Random[g_ui32RandomCount] = strtoul(pcList, &pcEnd, 0);
+        if(pcEnd == pcList)
+        {
+            break;
+        }
+        g_ui32RandomCount++;
+        pcList = (*pcEnd == ',') ? pcEnd + 1 : pcEnd;
+    }
+}
+//-----------------------------------------------------------------------------
+static void ScriptRun(const char *pcAction)
+{
+    pcAction += strspn(pcAction, " \t");
+    if(strncmp(pcAction, "adc", 3) == 0)
+    {
+        HostADCListSet(pcAction + 3 + strspn(pcAction + 3, " \t"));
+    }
+    else if(strncmp(pcAction, "gpio", 4) == 0)
+    {
+        HostGPIOListSet(pcAction + 4 + strspn(pcAction + 4, " \t"));
+    }
+    else if(strncmp(pcAction, "random", 6) == 0)
+    {
+        ScriptRandomSet(pcAction + 6 + strspn(pcAction + 6, " \t"));
+    }
+}
+//-----------------------------------------------------------------------------
+// Load the script in file pcPath and run its frame 0 events, returns 0 if the file can not be read
+int32_t HostScriptLoad(const char *pcPath)
+{
+    FILE *pFile = fopen(pcPath, "r");
+    char pcLine[SCRIPT_LINE_MAX];
+    char *pcEnd;
+    tScriptEvent *psEvents;
+    uint32_t ui32Frame;
+
+    if(pFile == NULL)
+    {
+        return 0;
+    }
+    while(fgets(pcLine, sizeof(pcLine), pFile) != NULL)
+    {
+        pcLine[strcspn(pcLine, "\r\n#")] = 0;
+        ui32Frame = strtoul(pcLine, &pcEnd, 0);
+        if(pcEnd == pcLine)
+        {
+            continue;
+        }
+        psEvents = realloc(g_psEvents, (g_ui32EventCount + 1) * sizeof(tScriptEvent));
+        if(psEvents == NULL)
+        {
+            break;
+        }
+        g_psEvents = psEvents;
+        g_psEvents[g_ui32EventCount].ui32Frame = ui32Frame;
+        g_psEvents[g_ui32EventCount].pcAction = strdup(pcEnd);
+        g_ui32EventCount++;
+    }
+    fclose(pFile);
+    HostScriptFrame(0);
+    return 1;
+}
+//-----------------------------------------------------------------------------
+// Run the events of frame ui32Frame and the random input, called before the frame runs
+void HostScriptFrame(uint32_t ui32Frame)
+{
+    uint32_t i;
+
+    while(g_ui32EventNext < g_ui32EventCount && g_psEvents[g_ui32EventNext].ui32Frame <= ui32Frame)
+    {
+        ScriptRun(g_psEvents[g_ui32EventNext].pcAction);
+        g_ui32EventNext++;
+    }
+    for(i = 0; i < g_ui32RandomCount; i++)
+    {
+        // Numerical Recipes LCG, top 12 bits
+        g_ui32RandomState = g_ui32RandomState * 1664525 + 1013904223;
+        HostADCChannelSet(g_pui32Random[i], g_ui32RandomState >> 20);
+    }
+}
+//-----------------------------------------------------------------------------
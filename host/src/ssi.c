@@ -0,0 +1,188 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: SSI
+//
+// Only SSI2 is connected to something: every byte sent on it goes to the LCD
+// model (HostDisplaySSIWrite), which reads the DC pin to tell commands from
+// data like the ST7735S does. Sending takes no time, so the SSI is never busy.
+// DMA requests are only a flag that the uDMA model asks for (HostSSIDMARequest),
+// it signals the end of a DMA transfer with HostSSIIntSet.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/ssi.h"
+#include "host.h"
+
+typedef struct
+{
+    uint32_t ui32DMAFlags;
+    uint32_t ui32IntMask;
+    uint32_t ui32RawInt;
+} tSSI;
+
+static tSSI g_sSSI2;
+
+//-----------------------------------------------------------------------------
+static tSSI *SSIGet(uint32_t ui32Base)
+{
+    return (ui32Base == SSI2_BASE) ? &g_sSSI2 : NULL;
+}
+//-----------------------------------------------------------------------------
+bool HostSSIDMARequest(uint32_t ui32Base, uint32_t ui32DMAFlag)
+{
+    tSSI *psSSI = SSIGet(ui32Base);
+
+    return (psSSI != NULL) && (psSSI->ui32DMAFlags & ui32DMAFlag);
+}
+//-----------------------------------------------------------------------------
+void HostSSIIntSet(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tSSI *psSSI = SSIGet(ui32Base);
+
+    if(psSSI == NULL)
+    {
+        return;
+    }
+    psSSI->ui32RawInt |= ui32IntFlags;
+    if(psSSI->ui32RawInt & psSSI->ui32IntMask)
+    {
+        HostIntTrigger(INT_SSI2);
+    }
+}
+//-----------------------------------------------------------------------------
+void SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol,
+                        uint32_t ui32Mode, uint32_t ui32BitRate, uint32_t ui32DataWidth)
+{
+    (void)ui32Base;
+    (void)ui32SSIClk;
+    (void)ui32Protocol;
+    (void)ui32Mode;
+    (void)ui32BitRate;
+    (void)ui32DataWidth;
+}
+//-----------------------------------------------------------------------------
+void SSIEnable(uint32_t ui32Base)
+{
+    (void)ui32Base;
+}
+//-----------------------------------------------------------------------------
+void SSIDisable(uint32_t ui32Base)
+{
+    (void)ui32Base;
+}
+//-----------------------------------------------------------------------------
+void SSIDataPut(uint32_t ui32Base, uint32_t ui32Data)
+{
+    if(ui32Base == SSI2_BASE)
+    {
+        HostDisplaySSIWrite(ui32Data);
+    }
+}
+//-----------------------------------------------------------------------------
+void HostSSIDataPutBuffer(uint32_t ui32Base, const uint8_t *pui8Data, uint32_t ui32Count)
+{
+    if(ui32Base == SSI2_BASE)
+    {
+        HostDisplaySSIWriteBuffer(pui8Data, ui32Count);
+    }
+}
+//-----------------------------------------------------------------------------
+int32_t SSIDataPutNonBlocking(uint32_t ui32Base, uint32_t ui32Data)
+{
+    SSIDataPut(ui32Base, ui32Data);
+    return 1;
+}
+//-----------------------------------------------------------------------------
+bool SSIBusy(uint32_t ui32Base)
+{
+    (void)ui32Base;
+    return false;
+}
+//-----------------------------------------------------------------------------
+void SSIDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+    tSSI *psSSI = SSIGet(ui32Base);
+
+    if(psSSI != NULL)
+    {
+        psSSI->ui32DMAFlags |= ui32DMAFlags;
+    }
+}
+//-----------------------------------------------------------------------------
+void SSIDMADisable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+    tSSI *psSSI = SSIGet(ui32Base);
+
+    if(psSSI != NULL)
+    {
+        psSSI->ui32DMAFlags &= ~ui32DMAFlags;
+    }
+}
+//-----------------------------------------------------------------------------
+void SSIIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tSSI *psSSI = SSIGet(ui32Base);
+
+    if(psSSI != NULL)
+    {
+        psSSI->ui32IntMask |= ui32IntFlags;
+        if(psSSI->ui32RawInt & psSSI->ui32IntMask)
+        {
+            HostIntTrigger(INT_SSI2);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void SSIIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tSSI *psSSI = SSIGet(ui32Base);
+
+    if(psSSI != NULL)
+    {
+        psSSI->ui32IntMask &= ~ui32IntFlags;
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t SSIIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    tSSI *psSSI = SSIGet(ui32Base);
+
+    if(psSSI == NULL)
+    {
+        return 0;
+    }
+    return bMasked ? (psSSI->ui32RawInt & psSSI->ui32IntMask) : psSSI->ui32RawInt;
+}
+//-----------------------------------------------------------------------------
+void SSIIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tSSI *psSSI = SSIGet(ui32Base);
+
+    if(psSSI != NULL)
+    {
+        psSSI->ui32RawInt &= ~ui32IntFlags;
+    }
+}
+//-----------------------------------------------------------------------------
+void SSIIntRegister(uint32_t ui32Base, void (*pfnHandler)(void))
+{
+    if(ui32Base == SSI2_BASE)
+    {
+        IntRegister(INT_SSI2, pfnHandler);
+        IntEnable(INT_SSI2);
+    }
+}
+//-----------------------------------------------------------------------------
+void SSIIntUnregister(uint32_t ui32Base)
+{
+    if(ui32Base == SSI2_BASE)
+    {
+        IntDisable(INT_SSI2);
+        IntUnregister(INT_SSI2);
+    }
+}
+//-----------------------------------------------------------------------------
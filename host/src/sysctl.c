@@ -0,0 +1,175 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: system control
+//
+// Also the virtual clock of the host: a count of system clock cycles that
+// only moves when the program waits (SysCtlDelay, SysCtlSleep). Timers, PWM
+// ADC triggers and ADC conversions (host/src/timer.c, pwm.c, adc.c) happen at
+// cycle counts of this clock, HostCycleAdvance runs them in order as it moves
+// forward.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "driverlib/sysctl.h"
+#include "host.h"
+
+#define MAX_PERIPHERALS 32
+
+static uint32_t g_ui32SysClock = 16000000;
+// Enabled peripherals, 0 is a free slot
+static uint32_t g_pui32Enabled[MAX_PERIPHERALS];
+// Virtual clock, cycles since start
+static uint64_t g_ui64Cycles;
+
+//-----------------------------------------------------------------------------
+uint32_t HostSysClockGet(void)
+{
+    return g_ui32SysClock;
+}
+//-----------------------------------------------------------------------------
+// Every requested clock is possible on the host
+uint32_t SysCtlClockFreqSet(uint32_t ui32Config, uint32_t ui32SysClock)
+{
+    (void)ui32Config;
+    g_ui32SysClock = ui32SysClock;
+    return ui32SysClock;
+}
+//-----------------------------------------------------------------------------
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+    int i;
+    int iFree = -1;
+
+    for(i = 0; i < MAX_PERIPHERALS; i++)
+    {
+        if(g_pui32Enabled[i] == ui32Peripheral)
+        {
+            return;
+        }
+        if(g_pui32Enabled[i] == 0 && iFree < 0)
+        {
+            iFree = i;
+        }
+    }
+    if(iFree >= 0)
+    {
+        g_pui32Enabled[iFree] = ui32Peripheral;
+    }
+}
+//-----------------------------------------------------------------------------
+void SysCtlPeripheralDisable(uint32_t ui32Peripheral)
+{
+    int i;
+
+    for(i = 0; i < MAX_PERIPHERALS; i++)
+    {
+        if(g_pui32Enabled[i] == ui32Peripheral)
+        {
+            g_pui32Enabled[i] = 0;
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void SysCtlPeripheralReset(uint32_t ui32Peripheral)
+{
+    (void)ui32Peripheral;
+}
+//-----------------------------------------------------------------------------
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral)
+{
+    int i;
+
+    for(i = 0; i < MAX_PERIPHERALS; i++)
+    {
+        if(g_pui32Enabled[i] == ui32Peripheral)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+// The PWM divider in RCC is only on the TM4C123, on the TM4C129 it is set
+// with PWMClockSet (host/src/pwm.c) and this does nothing
+void SysCtlPWMClockSet(uint32_t ui32Config)
+{
+    (void)ui32Config;
+}
+//-----------------------------------------------------------------------------
+uint64_t HostCycleCount(void)
+{
+    return g_ui64Cycles;
+}
+//-----------------------------------------------------------------------------
+// Cycle count of the next timer, PWM or ADC event, UINT64_MAX if nothing is running
+static uint64_t HostNextEvent(void)
+{
+    uint64_t ui64Next = HostTimerNextEvent();
+    uint64_t ui64PWM = HostPWMNextEvent();
+    uint64_t ui64ADC = HostADCNextEvent();
+
+    ui64Next = (ui64PWM < ui64Next) ? ui64PWM : ui64Next;
+    return (ui64ADC < ui64Next) ? ui64ADC : ui64Next;
+}
+//-----------------------------------------------------------------------------
+// Move the virtual clock to the cycle count ui64Until, running the events on the way
+static void HostCycleRun(uint64_t ui64Until)
+{
+    uint64_t ui64Next;
+
+    while((ui64Next = HostNextEvent()) <= ui64Until)
+    {
+        g_ui64Cycles = ui64Next;
+        HostTimerEvents(ui64Next);
+        HostPWMEvents(ui64Next);
+        HostADCEvents(ui64Next);
+    }
+    g_ui64Cycles = ui64Until;
+}
+//-----------------------------------------------------------------------------
+void HostCycleAdvance(uint64_t ui64Cycles)
+{
+    HostCycleRun(g_ui64Cycles + ui64Cycles);
+}
+//-----------------------------------------------------------------------------
+// Wait for ui64Cycles of the system clock in real time, headless it takes no time
+static void HostCycleSleep(uint64_t ui64Cycles)
+{
+    struct timespec sTime;
+    uint64_t ui64Ns = ui64Cycles * 1000000000 / g_ui32SysClock;
+
+    if(HostHeadlessGet())
+    {
+        return;
+    }
+    sTime.tv_sec = ui64Ns / 1000000000;
+    sTime.tv_nsec = ui64Ns % 1000000000;
+    nanosleep(&sTime, NULL);
+}
+//-----------------------------------------------------------------------------
+// The delay loop takes 3 cycles per count on the target
+void SysCtlDelay(uint32_t ui32Count)
+{
+    HostFrameMark(HOST_FRAME_DELAY, __builtin_return_address(0));
+    HostCycleAdvance((uint64_t)ui32Count * 3);
+    HostCycleSleep((uint64_t)ui32Count * 3);
+}
+//-----------------------------------------------------------------------------
+// Sleep until an interrupt handler has run, returns at once if no timer or
+// conversion is running that could cause one
+void SysCtlSleep(void)
+{
+    uint64_t ui64Start = g_ui64Cycles;
+    uint64_t ui64Next;
+    uint32_t ui32Handled = HostIntCount();
+
+    HostFrameMark(HOST_FRAME_DELAY, __builtin_return_address(0));
+    while(HostIntCount() == ui32Handled && (ui64Next = HostNextEvent()) != UINT64_MAX)
+    {
+        HostCycleRun(ui64Next);
+    }
+    HostCycleSleep(g_ui64Cycles - ui64Start);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,224 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: general purpose timers
+//
+// TIMER0 and TIMER1, timer A only, as one 32 bit timer counting down from the
+// load value in system clock cycles of the virtual clock (host/src/sysctl.c).
+// A timeout every load + 1 cycles sets the TIMER_TIMA_TIMEOUT flag, raises
+// INT_TIMERnA if that flag is enabled and, with TimerControlTrigger, starts
+// the ADC sequences that have ADC_TRIGGER_TIMER. One shot timers stop after
+// the first timeout.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/timer.h"
+#include "host.h"
+
+#define NUM_TIMERS 2
+
+typedef struct
+{
+    uint32_t ui32Config;
+    uint32_t ui32Load;
+    bool bEnabled;
+    bool bADCTrigger;
+    uint32_t ui32IntMask;
+    uint32_t ui32RawInt;
+    // Cycle count of the next timeout
+    uint64_t ui64Next;
+} tTimer;
+
+static tTimer g_psTimers[NUM_TIMERS];
+
+static const uint32_t g_pui32Interrupts[NUM_TIMERS] = {INT_TIMER0A, INT_TIMER1A};
+
+//-----------------------------------------------------------------------------
+static tTimer *TimerGet(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    if((ui32Base != TIMER0_BASE && ui32Base != TIMER1_BASE) || !(ui32Timer & TIMER_A))
+    {
+        return NULL;
+    }
+    return &g_psTimers[ui32Base == TIMER1_BASE];
+}
+//-----------------------------------------------------------------------------
+// Cycle count of the next timeout of any timer, UINT64_MAX if none is running
+uint64_t HostTimerNextEvent(void)
+{
+    uint64_t ui64Next = UINT64_MAX;
+    int i;
+
+    for(i = 0; i < NUM_TIMERS; i++)
+    {
+        if(g_psTimers[i].bEnabled && g_psTimers[i].ui64Next < ui64Next)
+        {
+            ui64Next = g_psTimers[i].ui64Next;
+        }
+    }
+    return ui64Next;
+}
+//-----------------------------------------------------------------------------
+// The virtual clock is at ui64Now, run the timeouts that are due
+void HostTimerEvents(uint64_t ui64Now)
+{
+    tTimer *psTimer;
+    int i;
+
+    for(i = 0; i < NUM_TIMERS; i++)
+    {
+        psTimer = &g_psTimers[i];
+        if(!psTimer->bEnabled || psTimer->ui64Next > ui64Now)
+        {
+            continue;
+        }
+        psTimer->ui64Next += (uint64_t)psTimer->ui32Load + 1;
+        if((psTimer->ui32Config & 0xFF) == (TIMER_CFG_ONE_SHOT & 0xFF))
+        {
+            psTimer->bEnabled = false;
+        }
+        if(psTimer->bADCTrigger)
+        {
+            HostADCTimerTrigger(ui64Now);
+        }
+        psTimer->ui32RawInt |= TIMER_TIMA_TIMEOUT;
+        if(psTimer->ui32IntMask & TIMER_TIMA_TIMEOUT)
+        {
+            HostIntTrigger(g_pui32Interrupts[i]);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config)
+{
+    tTimer *psTimer = TimerGet(ui32Base, TIMER_A);
+
+    if(psTimer != NULL)
+    {
+        psTimer->ui32Config = ui32Config;
+        psTimer->bEnabled = false;
+    }
+}
+//-----------------------------------------------------------------------------
+void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value)
+{
+    tTimer *psTimer = TimerGet(ui32Base, ui32Timer);
+
+    if(psTimer != NULL)
+    {
+        psTimer->ui32Load = ui32Value;
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t TimerLoadGet(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    tTimer *psTimer = TimerGet(ui32Base, ui32Timer);
+
+    return (psTimer != NULL) ? psTimer->ui32Load : 0;
+}
+//-----------------------------------------------------------------------------
+// Counts down from the load value, the first timeout is load + 1 cycles from now
+void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    tTimer *psTimer = TimerGet(ui32Base, ui32Timer);
+
+    if(psTimer != NULL && !psTimer->bEnabled)
+    {
+        psTimer->bEnabled = true;
+        psTimer->ui64Next = HostCycleCount() + psTimer->ui32Load + 1;
+    }
+}
+//-----------------------------------------------------------------------------
+void TimerDisable(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    tTimer *psTimer = TimerGet(ui32Base, ui32Timer);
+
+    if(psTimer != NULL)
+    {
+        psTimer->bEnabled = false;
+    }
+}
+//-----------------------------------------------------------------------------
+void TimerControlTrigger(uint32_t ui32Base, uint32_t ui32Timer, bool bEnable)
+{
+    tTimer *psTimer = TimerGet(ui32Base, ui32Timer);
+
+    if(psTimer != NULL)
+    {
+        psTimer->bADCTrigger = bEnable;
+    }
+}
+//-----------------------------------------------------------------------------
+// Only the timeout event exists here, TimerControlTrigger alone is enough
+void TimerADCEventSet(uint32_t ui32Base, uint32_t ui32ADCEvent)
+{
+    (void)ui32Base;
+    (void)ui32ADCEvent;
+}
+//-----------------------------------------------------------------------------
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tTimer *psTimer = TimerGet(ui32Base, TIMER_A);
+
+    if(psTimer != NULL)
+    {
+        psTimer->ui32IntMask |= ui32IntFlags;
+    }
+}
+//-----------------------------------------------------------------------------
+void TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tTimer *psTimer = TimerGet(ui32Base, TIMER_A);
+
+    if(psTimer != NULL)
+    {
+        psTimer->ui32IntMask &= ~ui32IntFlags;
+    }
+}
+//-----------------------------------------------------------------------------
+uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    tTimer *psTimer = TimerGet(ui32Base, TIMER_A);
+
+    if(psTimer == NULL)
+    {
+        return 0;
+    }
+    return bMasked ? (psTimer->ui32RawInt & psTimer->ui32IntMask) : psTimer->ui32RawInt;
+}
+//-----------------------------------------------------------------------------
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    tTimer *psTimer = TimerGet(ui32Base, TIMER_A);
+
+    if(psTimer != NULL)
+    {
+        psTimer->ui32RawInt &= ~ui32IntFlags;
+    }
+}
+//-----------------------------------------------------------------------------
+void TimerIntRegister(uint32_t ui32Base, uint32_t ui32Timer, void (*pfnHandler)(void))
+{
+    tTimer *psTimer = TimerGet(ui32Base, ui32Timer);
+
+    if(psTimer != NULL)
+    {
+        IntRegister(g_pui32Interrupts[psTimer - g_psTimers], pfnHandler);
+        IntEnable(g_pui32Interrupts[psTimer - g_psTimers]);
+    }
+}
+//-----------------------------------------------------------------------------
+void TimerIntUnregister(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    tTimer *psTimer = TimerGet(ui32Base, ui32Timer);
+
+    if(psTimer != NULL)
+    {
+        IntDisable(g_pui32Interrupts[psTimer - g_psTimers]);
+        IntUnregister(g_pui32Interrupts[psTimer - g_psTimers]);
+    }
+}
+//-----------------------------------------------------------------------------
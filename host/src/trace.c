@@ -0,0 +1,393 @@
+//-----------------------------------------------------------------------------
+// Host HAL control: input trace record and replay
+//
+// HOST_RECORD=file writes the input of every frame (the 20 ADC channel values
+// and the 15 GPIO input levels the program can read) to file, HOST_REPLAY=file
+// sets the inputs from it again before every frame, so the program reads the
+// same values through the same ADC and GPIO code. HOST_REPLAY_FROM=n starts the
+// replay at frame n of the trace. The replay ends the program after the last
+// frame of the trace.
+//
+// File format, numbers are LEB128 varints unless noted:
+//   "HTRC", version (1 byte), keyframe interval K
+//   one record per frame:
+//     keyframe (every K-th frame, starting with frame 0):
+//       rand() state, then every input as an absolute value
+//     other frames:
+//       number of inputs that changed times 2, plus 1 if rand() was called
+//       since the previous frame, then the number of rand() calls if so, then
+//       per changed input the distance to the previous changed input (first
+//       one from -1) and the zigzag encoded difference to its old value
+//   index: byte offset of every keyframe (uint32 LE), then the number of frames,
+//   the number of keyframes (uint32 LE) and "HIDX"
+// A replay from frame n decodes from the keyframe before n, sets the rand()
+// state of that keyframe and steps it on by the rand() calls of the frames in
+// between, so the program starts with the rand() state it had at frame n.
+// Version 1 traces (no rand() counts) can still be replayed, a replay from
+// frame n of one gets the rand() state of the keyframe before n. A trace
+// without an index (the recording was killed) can still be replayed from the
+// start.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "inc/hw_memmap.h"
+#include "host.h"
+
+#define TRACE_VERSION           2
+#define TRACE_KEYFRAME          256
+#define TRACE_ADC_CHANNELS      20
+#define TRACE_GPIO_PORTS        15
+#define TRACE_INPUTS            (TRACE_ADC_CHANNELS + TRACE_GPIO_PORTS)
+// Header: magic, version (the keyframe interval follows)
+#define TRACE_HEADER_SIZE       5
+// Index trailer: number of frames, number of keyframes, magic
+#define TRACE_TRAILER_SIZE      12
+
+static FILE *g_pRecord;
+static uint32_t g_ui32RecordOffset;
+static uint32_t *g_pui32Keyframes;
+static uint32_t g_ui32KeyframeCount;
+static uint32_t g_ui32RecordFrames;
+// HostRandCallsGet at the last frame recorded
+static uint32_t g_ui32RecordRandCalls;
+
+static uint8_t *g_pui8Replay;
+static uint32_t g_ui32ReplaySize;
+static uint32_t g_ui32ReplayPos;
+static uint32_t g_ui32ReplayFrame;
+static uint32_t g_ui32ReplayFrames;
+static uint32_t g_ui32Keyframe;
+static uint8_t g_ui8ReplayVersion;
+
+// Input values of the last frame recorded and of the last frame replayed
+static uint32_t g_pui32RecordInputs[TRACE_INPUTS];
+static uint32_t g_pui32ReplayInputs[TRACE_INPUTS];
+
+//-----------------------------------------------------------------------------
+// Current value of input i, ADC channels first
+static uint32_t TraceInputGet(uint32_t i)
+{
+    if(i < TRACE_ADC_CHANNELS)
+    {
+        return HostADCChannelGet(i);
+    }
+    return HostGPIOInputGet(GPIO_PORTA_AHB_BASE + (i - TRACE_ADC_CHANNELS) * 0x1000);
+}
+//-----------------------------------------------------------------------------
+static void TraceInputSet(uint32_t i, uint32_t ui32Value)
+{
+    if(i < TRACE_ADC_CHANNELS)
+    {
+        HostADCChannelSet(i, ui32Value);
+    }
+    else
+    {
+        HostGPIOInputSet(GPIO_PORTA_AHB_BASE + (i - TRACE_ADC_CHANNELS) * 0x1000, 0xFF, ui32Value);
+    }
+}
+//-----------------------------------------------------------------------------
+static void TraceVarintPut(uint32_t ui32Value)
+{
+    do
+    {
+        fputc((ui32Value & 0x7F) | ((ui32Value > 0x7F) ? 0x80 : 0), g_pRecord);
+        g_ui32RecordOffset++;
+        ui32Value >>= 7;
+    }
+    while(ui32Value != 0);
+}
+//-----------------------------------------------------------------------------
+static void TraceU32Put(uint32_t ui32Value)
+{
+    uint8_t pui8Bytes[4] = {ui32Value, ui32Value >> 8, ui32Value >> 16, ui32Value >> 24};
+
+    fwrite(pui8Bytes, 1, 4, g_pRecord);
+}
+//-----------------------------------------------------------------------------
+// Returns 0 at the end of the data
+static uint32_t TraceVarintGet(uint32_t *pui32Value)
+{
+    uint32_t ui32Shift = 0;
+    uint8_t ui8Byte;
+
+    *pui32Value = 0;
+    do
+    {
+        if(g_ui32ReplayPos >= g_ui32ReplaySize || ui32Shift > 28)
+        {
+            return 0;
+        }
+        ui8Byte = g_pui8Replay[g_ui32ReplayPos++];
+        *pui32Value |= (uint32_t)(ui8Byte & 0x7F) << ui32Shift;
+        ui32Shift += 7;
+    }
+    while(ui8Byte & 0x80);
+    return 1;
+}
+//-----------------------------------------------------------------------------
+static uint32_t TraceU32Get(const uint8_t *pui8Bytes)
+{
+    return pui8Bytes[0] | (pui8Bytes[1] << 8) | (pui8Bytes[2] << 16) | ((uint32_t)pui8Bytes[3] << 24);
+}
+//-----------------------------------------------------------------------------
+// Write the record of the frame that is about to run
+static void TraceRecordFrame(uint32_t ui32Frame)
+{
+    uint32_t pui32Changed[TRACE_INPUTS];
+    uint32_t ui32Count = 0;
+    uint32_t ui32Value;
+    uint32_t ui32RandCalls = HostRandCallsGet() - g_ui32RecordRandCalls;
+    int32_t i32Last = -1;
+    int32_t i32Delta;
+    uint32_t *pui32Keyframes;
+    uint32_t i;
+
+    if(ui32Frame % TRACE_KEYFRAME == 0)
+    {
+        pui32Keyframes = realloc(g_pui32Keyframes, (g_ui32KeyframeCount + 1) * sizeof(uint32_t));
+        if(pui32Keyframes != NULL)
+        {
+            g_pui32Keyframes = pui32Keyframes;
+            g_pui32Keyframes[g_ui32KeyframeCount++] = g_ui32RecordOffset;
+        }
+        TraceVarintPut(HostRandStateGet());
+        for(i = 0; i < TRACE_INPUTS; i++)
+        {
+            g_pui32RecordInputs[i] = TraceInputGet(i);
+            TraceVarintPut(g_pui32RecordInputs[i]);
+        }
+    }
+    else
+    {
+        for(i = 0; i < TRACE_INPUTS; i++)
+        {
+            if(TraceInputGet(i) != g_pui32RecordInputs[i])
+            {
+                pui32Changed[ui32Count++] = i;
+            }
+        }
+        TraceVarintPut(ui32Count * 2 + (ui32RandCalls != 0));
+        if(ui32RandCalls != 0)
+        {
+            TraceVarintPut(ui32RandCalls);
+        }
+        for(i = 0; i < ui32Count; i++)
+        {
+            ui32Value = TraceInputGet(pui32Changed[i]);
+            i32Delta = (int32_t)ui32Value - (int32_t)g_pui32RecordInputs[pui32Changed[i]];
+            TraceVarintPut(pui32Changed[i] - i32Last - 1);
+            TraceVarintPut(((uint32_t)i32Delta << 1) ^ (uint32_t)(i32Delta >> 31));
+            g_pui32RecordInputs[pui32Changed[i]] = ui32Value;
+            i32Last = pui32Changed[i];
+        }
+    }
+    g_ui32RecordRandCalls += ui32RandCalls;
+    g_ui32RecordFrames++;
+}
+//-----------------------------------------------------------------------------
+// Decode the record of the next frame into g_pui32RecordInputs, returns 0 at the end of the trace
+// pui32Rand gets the rand() state if it is a keyframe, pui32RandCalls the number of rand() calls
+// since the previous frame (0 for a keyframe)
+static uint32_t TraceReplayDecode(uint32_t *pui32Rand, uint32_t *pui32RandCalls)
+{
+    uint32_t ui32Count;
+    uint32_t ui32Value;
+    uint32_t ui32Skip;
+    int32_t i32Input = -1;
+    uint32_t i;
+
+    if(g_ui32ReplayFrames != 0 && g_ui32ReplayFrame >= g_ui32ReplayFrames)
+    {
+        return 0;
+    }
+    *pui32RandCalls = 0;
+    if(g_ui32ReplayFrame % g_ui32Keyframe == 0)
+    {
+        if(!TraceVarintGet(pui32Rand))
+        {
+            return 0;
+        }
+        for(i = 0; i < TRACE_INPUTS; i++)
+        {
+            if(!TraceVarintGet(&g_pui32ReplayInputs[i]))
+            {
+                return 0;
+            }
+        }
+    }
+    else
+    {
+        if(!TraceVarintGet(&ui32Count))
+        {
+            return 0;
+        }
+        if(g_ui8ReplayVersion >= 2)
+        {
+            if((ui32Count & 1) && !TraceVarintGet(pui32RandCalls))
+            {
+                return 0;
+            }
+            ui32Count >>= 1;
+        }
+        for(i = 0; i < ui32Count; i++)
+        {
+            if(!TraceVarintGet(&ui32Skip) || !TraceVarintGet(&ui32Value))
+            {
+                return 0;
+            }
+            if(ui32Skip >= TRACE_INPUTS)
+            {
+                return 0;
+            }
+            i32Input += ui32Skip + 1;
+            if(i32Input >= TRACE_INPUTS)
+            {
+                return 0;
+            }
+            g_pui32ReplayInputs[i32Input] += (ui32Value >> 1) ^ -(ui32Value & 1);
+        }
+    }
+    g_ui32ReplayFrame++;
+    return 1;
+}
+//-----------------------------------------------------------------------------
+static void TraceReplayApply(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < TRACE_INPUTS; i++)
+    {
+        TraceInputSet(i, g_pui32ReplayInputs[i]);
+    }
+}
+//-----------------------------------------------------------------------------
+static void TraceRecordClose(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < g_ui32KeyframeCount; i++)
+    {
+        TraceU32Put(g_pui32Keyframes[i]);
+    }
+    TraceU32Put(g_ui32RecordFrames);
+    TraceU32Put(g_ui32KeyframeCount);
+    fwrite("HIDX", 1, 4, g_pRecord);
+    fclose(g_pRecord);
+    g_pRecord = NULL;
+}
+//-----------------------------------------------------------------------------
+// Start recording to pcPath, returns 0 if the file can not be written
+int32_t HostRecordStart(const char *pcPath)
+{
+    g_pRecord = fopen(pcPath, "wb");
+    if(g_pRecord == NULL)
+    {
+        return 0;
+    }
+    fwrite("HTRC", 1, 4, g_pRecord);
+    fputc(TRACE_VERSION, g_pRecord);
+    g_ui32RecordOffset = 5;
+    TraceVarintPut(TRACE_KEYFRAME);
+    atexit(TraceRecordClose);
+    TraceRecordFrame(0);
+    return 1;
+}
+//-----------------------------------------------------------------------------
+// Start replaying pcPath from frame ui32From of the trace, returns 0 if the file is not a trace
+int32_t HostReplayStart(const char *pcPath, uint32_t ui32From)
+{
+    FILE *pFile = fopen(pcPath, "rb");
+    const uint8_t *pui8Trailer;
+    uint32_t ui32Keyframes;
+    uint32_t ui32Rand = 1;
+    uint32_t ui32RandCalls = 0;
+    uint32_t ui32FrameRandCalls;
+    long lSize;
+
+    if(pFile == NULL)
+    {
+        return 0;
+    }
+    fseek(pFile, 0, SEEK_END);
+    lSize = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+    g_pui8Replay = malloc(lSize > 0 ? lSize : 1);
+    if(g_pui8Replay == NULL || lSize < TRACE_HEADER_SIZE ||
+       fread(g_pui8Replay, 1, lSize, pFile) != (size_t)lSize ||
+       memcmp(g_pui8Replay, "HTRC", 4) != 0 || g_pui8Replay[4] == 0 || g_pui8Replay[4] > TRACE_VERSION)
+    {
+        fclose(pFile);
+        return 0;
+    }
+    fclose(pFile);
+    g_ui8ReplayVersion = g_pui8Replay[4];
+    g_ui32ReplaySize = lSize;
+    g_ui32ReplayPos = TRACE_HEADER_SIZE;
+    if(!TraceVarintGet(&g_ui32Keyframe) || g_ui32Keyframe == 0)
+    {
+        return 0;
+    }
+
+    // Jump to the keyframe before ui32From if there is an index
+    pui8Trailer = (g_ui32ReplaySize >= g_ui32ReplayPos + TRACE_TRAILER_SIZE) ?
+                  &g_pui8Replay[g_ui32ReplaySize - TRACE_TRAILER_SIZE] : NULL;
+    if(pui8Trailer != NULL && memcmp(pui8Trailer + 8, "HIDX", 4) == 0)
+    {
+        g_ui32ReplayFrames = TraceU32Get(pui8Trailer);
+        ui32Keyframes = TraceU32Get(pui8Trailer + 4);
+        if(ui32Keyframes > (g_ui32ReplaySize - g_ui32ReplayPos - TRACE_TRAILER_SIZE) / 4)
+        {
+            return 0;
+        }
+        g_ui32ReplaySize -= TRACE_TRAILER_SIZE + ui32Keyframes * 4;
+        if(ui32From / g_ui32Keyframe < ui32Keyframes)
+        {
+            g_ui32ReplayPos = TraceU32Get(&g_pui8Replay[g_ui32ReplaySize + (ui32From / g_ui32Keyframe) * 4]);
+            g_ui32ReplayFrame = ui32From - ui32From % g_ui32Keyframe;
+        }
+    }
+    // Only keyframes set ui32Rand, the last one decoded is the one before ui32From,
+    // the rand() calls of the frames after it up to ui32From are added up
+    do
+    {
+        if(g_ui32ReplayFrame % g_ui32Keyframe == 0)
+        {
+            ui32RandCalls = 0;
+        }
+        if(!TraceReplayDecode(&ui32Rand, &ui32FrameRandCalls))
+        {
+            return 0;
+        }
+        ui32RandCalls += ui32FrameRandCalls;
+    }
+    while(g_ui32ReplayFrame <= ui32From);
+    HostRandStateSet(ui32Rand);
+    HostRandAdvance(ui32RandCalls);
+    TraceReplayApply();
+    return 1;
+}
+//-----------------------------------------------------------------------------
+// Record or replay the input of frame ui32Frame before it runs, returns 0 when the replay has ended
+uint32_t HostTraceFrame(uint32_t ui32Frame)
+{
+    uint32_t ui32Rand;
+    uint32_t ui32RandCalls;
+
+    if(g_pui8Replay != NULL)
+    {
+        if(!TraceReplayDecode(&ui32Rand, &ui32RandCalls))
+        {
+            return 0;
+        }
+        TraceReplayApply();
+    }
+    if(g_pRecord != NULL)
+    {
+        TraceRecordFrame(ui32Frame);
+    }
+    return 1;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,38 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: UART
+// UART0 is stdin/stdout.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <poll.h>
+
+#include "driverlib/uart.h"
+
+//-----------------------------------------------------------------------------
+void UARTClockSourceSet(uint32_t ui32Base, uint32_t ui32Source)
+{
+    (void)ui32Base;
+    (void)ui32Source;
+}
+//-----------------------------------------------------------------------------
+bool UARTCharsAvail(uint32_t ui32Base)
+{
+    struct pollfd sPoll = {0, POLLIN, 0};
+
+    (void)ui32Base;
+    return poll(&sPoll, 1, 0) > 0;
+}
+//-----------------------------------------------------------------------------
+int32_t UARTCharGet(uint32_t ui32Base)
+{
+    (void)ui32Base;
+    return getchar();
+}
+//-----------------------------------------------------------------------------
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    (void)ui32Base;
+    putchar(ucData);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,318 @@
+//-----------------------------------------------------------------------------
+// Host driverlib: uDMA
+//
+// 32 channels, each with a primary and an alternate control structure (kept
+// here, the control table given to uDMAControlBaseSet is not used). A channel
+// moves items while it is enabled and the peripheral register it reads or
+// writes asks for data:
+//  - SSI2 data register: while SSIDMAEnable(SSI2_BASE, SSI_DMA_TX) is set
+//  - ADC sequencer FIFOs: while ADCSequenceDMAEnable is set and the FIFO has
+//    samples, the ADC model asks with HostUDMARequest when a sequence is done
+// Memory to memory is not modelled. Sending takes no time, so a transfer to
+// the SSI is done before uDMAChannelEnable returns, and the peripheral's DMA
+// interrupt (SSI_DMATX, ADC_INT_DMA_SSn) runs then too if it is enabled.
+// In ping-pong mode the channel continues with the other structure when one
+// is done, and stops when that one is stopped too, like the target.
+//-----------------------------------------------------------------------------
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "inc/hw_adc.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ssi.h"
+#include "driverlib/ssi.h"
+#include "driverlib/udma.h"
+#include "host.h"
+
+#define NUM_CHANNELS 32
+
+typedef struct
+{
+    uint32_t ui32Control;
+    uint32_t ui32Mode;
+    // Next item to read and write
+    uintptr_t uiSrc;
+    uintptr_t uiDst;
+    // Items left
+    uint32_t ui32Size;
+} tDMAControl;
+
+typedef struct
+{
+    // Primary and alternate
+    tDMAControl psControl[2];
+    bool bEnabled;
+    // Structure in use
+    uint32_t ui32Alt;
+    uint32_t ui32Attr;
+} tDMAChannel;
+
+static tDMAChannel g_psChannels[NUM_CHANNELS];
+static bool g_bEnabled;
+
+//-----------------------------------------------------------------------------
+static tDMAControl *DMAControlGet(uint32_t ui32ChannelStructIndex)
+{
+    uint32_t ui32Channel = ui32ChannelStructIndex & 0x1F;
+
+    return &g_psChannels[ui32Channel].psControl[(ui32ChannelStructIndex & UDMA_ALT_SELECT) ? 1 : 0];
+}
+//-----------------------------------------------------------------------------
+// 1 if the address is the SSI2 data register
+static bool DMAIsSSI2(uintptr_t uiAddr)
+{
+    return uiAddr == (uintptr_t)(SSI2_BASE + SSI_O_DR);
+}
+//-----------------------------------------------------------------------------
+// If the address is the FIFO of an ADC sequence, its ADC base and sequence number
+static bool DMAIsADC(uintptr_t uiAddr, uint32_t *pui32Base, uint32_t *pui32SequenceNum)
+{
+    uintptr_t uiBase = uiAddr & ~(uintptr_t)0xFFF;
+    uint32_t ui32Offset = (uint32_t)(uiAddr & 0xFFF);
+
+    // The FIFO registers are 0x20 apart
+    if((uiBase != ADC0_BASE && uiBase != ADC1_BASE) || ui32Offset < ADC_O_SSFIFO0 ||
+       ui32Offset > ADC_O_SSFIFO3 || (ui32Offset - ADC_O_SSFIFO0) % 0x20 != 0)
+    {
+        return false;
+    }
+    *pui32Base = (uint32_t)uiBase;
+    *pui32SequenceNum = (ui32Offset - ADC_O_SSFIFO0) / 0x20;
+    return true;
+}
+//-----------------------------------------------------------------------------
+// The peripheral at the source or destination wants an item
+static bool DMARequest(const tDMAControl *psControl)
+{
+    uint32_t ui32Base;
+    uint32_t ui32Seq;
+
+    if(DMAIsSSI2(psControl->uiDst))
+    {
+        return HostSSIDMARequest(SSI2_BASE, SSI_DMA_TX);
+    }
+    if(DMAIsADC(psControl->uiSrc, &ui32Base, &ui32Seq))
+    {
+        return HostADCDMARequest(ui32Base, ui32Seq);
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+// Bytes per item and increments from the control word
+static uint32_t DMAItemSize(uint32_t ui32Control)
+{
+    return 1 << ((ui32Control >> 24) & 3);
+}
+//-----------------------------------------------------------------------------
+static uint32_t DMAIncrement(uint32_t ui32Control, uint32_t ui32Shift)
+{
+    uint32_t ui32Inc = (ui32Control >> ui32Shift) & 3;
+
+    return (ui32Inc == 3) ? 0 : (1 << ui32Inc);
+}
+//-----------------------------------------------------------------------------
+static void DMAItemMove(tDMAControl *psControl)
+{
+    uint32_t ui32Size = DMAItemSize(psControl->ui32Control);
+    uint32_t ui32Value = 0;
+    uint32_t ui32Base;
+    uint32_t ui32Seq;
+
+    if(DMAIsADC(psControl->uiSrc, &ui32Base, &ui32Seq))
+    {
+        ui32Value = HostADCFifoRead(ui32Base, ui32Seq);
+    }
+    else if(ui32Size == 1)
+    {
+        ui32Value = *(const uint8_t *)psControl->uiSrc;
+    }
+    else if(ui32Size == 2)
+    {
+        ui32Value = *(const uint16_t *)psControl->uiSrc;
+    }
+    else
+    {
+        ui32Value = *(const uint32_t *)psControl->uiSrc;
+    }
+
+    if(DMAIsSSI2(psControl->uiDst))
+    {
+        SSIDataPut(SSI2_BASE, ui32Value);
+    }
+    else if(ui32Size == 1)
+    {
+        *(uint8_t *)psControl->uiDst = (uint8_t)ui32Value;
+    }
+    else if(ui32Size == 2)
+    {
+        *(uint16_t *)psControl->uiDst = (uint16_t)ui32Value;
+    }
+    else
+    {
+        *(uint32_t *)psControl->uiDst = ui32Value;
+    }
+    psControl->uiSrc += DMAIncrement(psControl->ui32Control, 26);
+    psControl->uiDst += DMAIncrement(psControl->ui32Control, 30);
+    psControl->ui32Size--;
+}
+//-----------------------------------------------------------------------------
+// Move what the peripheral asked for
+// The SSI takes bytes as fast as they come on the host (its request never
+// drops during a transfer), so a block of bytes to it goes in one call
+static void DMAItemsMove(tDMAControl *psControl)
+{
+    if(DMAIsSSI2(psControl->uiDst) && DMAItemSize(psControl->ui32Control) == 1 &&
+       DMAIncrement(psControl->ui32Control, 26) == 1 && DMAIncrement(psControl->ui32Control, 30) == 0)
+    {
+        HostSSIDataPutBuffer(SSI2_BASE, (const uint8_t *)psControl->uiSrc, psControl->ui32Size);
+        psControl->uiSrc += psControl->ui32Size;
+        psControl->ui32Size = 0;
+        return;
+    }
+    DMAItemMove(psControl);
+}
+//-----------------------------------------------------------------------------
+// The peripheral's interrupt for a finished transfer
+static void DMADone(const tDMAControl *psControl)
+{
+    uint32_t ui32Base;
+    uint32_t ui32Seq;
+
+    if(DMAIsSSI2(psControl->uiDst))
+    {
+        HostSSIIntSet(SSI2_BASE, SSI_DMATX);
+    }
+    else if(DMAIsADC(psControl->uiSrc, &ui32Base, &ui32Seq))
+    {
+        HostADCDMADone(ui32Base, ui32Seq);
+    }
+}
+//-----------------------------------------------------------------------------
+// Move items until the channel stops or the peripheral has had enough
+static void DMARun(uint32_t ui32Channel)
+{
+    tDMAChannel *psChannel = &g_psChannels[ui32Channel];
+    tDMAControl *psControl;
+
+    while(g_bEnabled && psChannel->bEnabled)
+    {
+        psControl = &psChannel->psControl[psChannel->ui32Alt];
+        if(psControl->ui32Mode == UDMA_MODE_STOP)
+        {
+            psChannel->bEnabled = false;
+            break;
+        }
+        if(!DMARequest(psControl))
+        {
+            break;
+        }
+        DMAItemsMove(psControl);
+        if(psControl->ui32Size > 0)
+        {
+            continue;
+        }
+        // Done, ping-pong goes on with the other structure
+        if(psControl->ui32Mode == UDMA_MODE_PINGPONG)
+        {
+            psChannel->ui32Alt ^= 1;
+        }
+        else
+        {
+            psChannel->bEnabled = false;
+        }
+        psControl->ui32Mode = UDMA_MODE_STOP;
+        // The handler may set up the next transfer, which runs from its uDMAChannelEnable
+        DMADone(psControl);
+    }
+}
+//-----------------------------------------------------------------------------
+void uDMAEnable(void)
+{
+    g_bEnabled = true;
+}
+//-----------------------------------------------------------------------------
+void uDMADisable(void)
+{
+    g_bEnabled = false;
+}
+//-----------------------------------------------------------------------------
+void uDMAControlBaseSet(void *pControlTable)
+{
+    (void)pControlTable;
+}
+//-----------------------------------------------------------------------------
+void uDMAChannelAssign(uint32_t ui32Mapping)
+{
+    (void)ui32Mapping;
+}
+//-----------------------------------------------------------------------------
+void uDMAChannelAttributeEnable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    tDMAChannel *psChannel = &g_psChannels[ui32ChannelNum & 0x1F];
+
+    psChannel->ui32Attr |= ui32Attr;
+    if(ui32Attr & UDMA_ATTR_ALTSELECT)
+    {
+        psChannel->ui32Alt = 1;
+    }
+}
+//-----------------------------------------------------------------------------
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    tDMAChannel *psChannel = &g_psChannels[ui32ChannelNum & 0x1F];
+
+    psChannel->ui32Attr &= ~ui32Attr;
+    if(ui32Attr & UDMA_ATTR_ALTSELECT)
+    {
+        psChannel->ui32Alt = 0;
+    }
+}
+//-----------------------------------------------------------------------------
+void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control)
+{
+    DMAControlGet(ui32ChannelStructIndex)->ui32Control = ui32Control;
+}
+//-----------------------------------------------------------------------------
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                            void *pvSrcAddr, void *pvDstAddr, uint32_t ui32TransferSize)
+{
+    tDMAControl *psControl = DMAControlGet(ui32ChannelStructIndex);
+
+    psControl->ui32Mode = ui32Mode;
+    psControl->uiSrc = (uintptr_t)pvSrcAddr;
+    psControl->uiDst = (uintptr_t)pvDstAddr;
+    psControl->ui32Size = ui32TransferSize;
+}
+//-----------------------------------------------------------------------------
+void uDMAChannelEnable(uint32_t ui32ChannelNum)
+{
+    g_psChannels[ui32ChannelNum & 0x1F].bEnabled = true;
+    DMARun(ui32ChannelNum & 0x1F);
+}
+//-----------------------------------------------------------------------------
+void uDMAChannelDisable(uint32_t ui32ChannelNum)
+{
+    g_psChannels[ui32ChannelNum & 0x1F].bEnabled = false;
+}
+//-----------------------------------------------------------------------------
+bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum)
+{
+    return g_psChannels[ui32ChannelNum & 0x1F].bEnabled;
+}
+//-----------------------------------------------------------------------------
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex)
+{
+    return DMAControlGet(ui32ChannelStructIndex)->ui32Mode;
+}
+//-----------------------------------------------------------------------------
+uint32_t uDMAChannelSizeGet(uint32_t ui32ChannelStructIndex)
+{
+    return DMAControlGet(ui32ChannelStructIndex)->ui32Size;
+}
+//-----------------------------------------------------------------------------
+void HostUDMARequest(uint32_t ui32Channel)
+{
+    DMARun(ui32Channel & 0x1F);
+}
+//-----------------------------------------------------------------------------
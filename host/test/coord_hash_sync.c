@@ -0,0 +1,229 @@
+//-----------------------------------------------------------------------------
+// Host test: the coord_hash.h index of a LinkedList stays in sync with the list
+//
+//   gcc -O2 -Ihost/include host/test/coord_hash_sync.c -o coord_hash_sync
+//   ./coord_hash_sync [steps]
+//   gcc -O2 -DCOORD_HASH_STATIC -Ihost/include host/test/coord_hash_sync.c -o coord_hash_sync_static
+//   ./coord_hash_sync_static [steps]
+//
+// Runs random sequences (default 1M steps) of every call of linked_list.h
+// that changes a list: the inserts, the deletes at both ends, delete_node by
+// coordinat, remove_node of a random node, delete_list and set_index on a list
+// that already has nodes. The coordinates come from a small range, so the
+// same one is often in the list several times and the probe runs are long.
+// The table starts small so that it grows (or, with COORD_HASH_STATIC, fills
+// up and the inserts fail, which must leave the list unchanged).
+//
+// After every change the counts of the list and the index must match and
+// search_list must give the same answer as walking the list. Every 16 changes
+// (and after set_index or delete_list) the whole index is checked: it must
+// hold exactly the nodes of the list, each one reachable from the home slot of
+// its coordinat. Exits with 1 on the first error.
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NODE_POOL_SIZE 4096
+#include "../../lab2_4.1/linked_list.h"
+
+// Coordinates are 0 to COORD_RANGE-1 in x and y
+#define COORD_RANGE 24
+#ifdef COORD_HASH_STATIC
+#define MAX_LENGTH 250
+#else
+#define MAX_LENGTH 1000
+#endif
+
+LinkedList list;
+CoordHash index_table;
+
+//-----------------------------------------------------------------------------
+// 1 if node is in the table at a slot a lookup of its coordinat gets to
+int16_t reachable(CoordHash *hash, struct _node *node)
+{
+    uint32_t mask = hash->capacity - 1;
+    uint32_t i = coord_hash_slot(hash, coord_hash_key(node->x, node->y));
+
+    while(hash->entries[i].node != NULL)
+    {
+        if(hash->entries[i].node == node)
+            return 1;
+        i = (i + 1) & mask;
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+// 1 if walking the list finds x, y
+int16_t walk_search(LinkedList *l, int16_t x, int16_t y)
+{
+    struct _node *temp;
+
+    for(temp = l->head; temp != NULL; temp = temp->next)
+    {
+        if(temp->x == x && temp->y == y)
+            return 1;
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+// Returns 0 if the list and its index agree, prints what is wrong otherwise
+// full also checks every node and every entry of the table
+int16_t check(uint32_t step, const char *operation, int16_t full)
+{
+    struct _node *temp;
+    uint32_t count = 0;
+    uint32_t i;
+    int16_t x;
+    int16_t y;
+
+    if(list.count != index_table.count)
+    {
+        printf("step %u (%s): list count %u, index count %u\n", step, operation, list.count, index_table.count);
+        return 1;
+    }
+    for(i = 0; i < 2; i++)
+    {
+        x = rand() % COORD_RANGE;
+        y = rand() % COORD_RANGE;
+        if(search_list(&list, x, y) != walk_search(&list, x, y))
+        {
+            printf("step %u (%s): search_list (%d, %d) is wrong\n", step, operation, x, y);
+            return 1;
+        }
+    }
+    if(!full)
+        return 0;
+
+    for(temp = list.head; temp != NULL; temp = temp->next)
+    {
+        if(!reachable(&index_table, temp))
+        {
+            printf("step %u (%s): node (%d, %d) not in the index\n", step, operation, temp->x, temp->y);
+            return 1;
+        }
+        count++;
+    }
+    // Every node of the list is in the table, so the same number of entries means nothing else is
+    if(count != list.count || index_table.count != count)
+    {
+        printf("step %u (%s): %u nodes, list count %u, index count %u\n", step, operation, count, list.count, index_table.count);
+        return 1;
+    }
+    for(i = 0; i < index_table.capacity; i++)
+    {
+        temp = index_table.entries[i].node;
+        if(temp != NULL && index_table.entries[i].key != coord_hash_key(temp->x, temp->y))
+        {
+            printf("step %u (%s): slot %u has the key of another coordinat\n", step, operation, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+// A random node of the list, NULL if it is empty
+struct _node* random_node(void)
+{
+    struct _node *temp = list.head;
+    uint32_t i;
+
+    if(list.count == 0)
+        return NULL;
+    for(i = rand() % list.count; i > 0; i--)
+        temp = temp->next;
+    return temp;
+}
+//-----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    uint32_t steps = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000;
+    const char *operation;
+    struct _node *node;
+    uint32_t count;
+    uint32_t step;
+    int16_t x;
+    int16_t y;
+
+    srand(1);
+    init_list(&list);
+    coord_hash_init(&index_table, 4, 75);
+    set_index(&list, &index_table);
+
+    for(step = 0; step < steps; step++)
+    {
+        x = rand() % COORD_RANGE;
+        y = rand() % COORD_RANGE;
+        node = random_node();
+        count = list.count;
+        // Mostly inserts up to MAX_LENGTH, then mostly deletes for a while, so every length is covered
+        switch((((step / 5000) & 1) == 0 && count < MAX_LENGTH) ? rand() % 8 : 4 + rand() % 8)
+        {
+        case 0:
+        case 1:
+            operation = "insert_at_begin";
+            insert_at_begin(&list, x, y);
+            break;
+        case 2:
+        case 3:
+            operation = "insert_at_end";
+            insert_at_end(&list, x, y);
+            break;
+        case 4:
+        case 5:
+            operation = "insert_after_node";
+            if(node != NULL)
+                insert_after_node(&list, node, x, y);
+            break;
+        case 6:
+        case 8:
+            operation = "delete_node";
+            delete_node(&list, x, y);
+            break;
+        case 7:
+        case 9:
+            operation = "remove_node";
+            if(node != NULL)
+                remove_node(&list, node);
+            break;
+        case 10:
+            operation = "delete_at_begin";
+            delete_at_begin(&list);
+            break;
+        default:
+            operation = "delete_at_end";
+            delete_at_end(&list);
+            break;
+        }
+        if(list.count > count + 1 || list.count + 1 < count)
+        {
+            printf("step %u (%s): count went from %u to %u\n", step, operation, count, list.count);
+            return 1;
+        }
+        if(step % 20000 == 19999)
+        {
+            // Build a new index over the nodes that are there, or start over
+            if(rand() & 1)
+            {
+                operation = "set_index";
+                if(!set_index(&list, &index_table))
+                {
+                    printf("step %u: set_index of %u nodes failed\n", step, list.count);
+                    return 1;
+                }
+            }
+            else
+            {
+                operation = "delete_list";
+                delete_list(&list);
+            }
+        }
+        if(check(step, operation, (step % 16 == 0) || (step % 20000 == 19999)))
+        {
+            return 1;
+        }
+    }
+    printf("%u steps, index in sync, table of %u entries\n", steps, index_table.capacity);
+    return 0;
+}
+//-----------------------------------------------------------------------------
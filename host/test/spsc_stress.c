@@ -0,0 +1,164 @@
+//-----------------------------------------------------------------------------
+// Host test: common/spsc_queue.h with producer and consumer on two threads
+//
+//   gcc -O2 -pthread host/test/spsc_stress.c -o spsc_stress
+//   ./spsc_stress [items]
+//   gcc -O1 -g -fsanitize=thread -pthread host/test/spsc_stress.c -o spsc_stress_tsan
+//   ./spsc_stress_tsan 1000000
+//
+// The producer thread enqueues items numbered 0 to items-1 (default 20M), the
+// consumer thread dequeues them and checks that every number comes exactly
+// once and in order. An item is three words written separately (the number,
+// its complement and a hash of it), so an element read before the producer
+// finished writing it, or after it was overwritten, shows up as a mismatch.
+// Neither thread waits on the other except by retrying a full or empty
+// queue (giving up the CPU in between, so it also works on one core), like
+// an ISR and the main loop. It runs with a tiny queue (wraps and is full or
+// empty all the time) and with a larger one, prints one line per run and
+// exits with 1 on the first error. Under ThreadSanitizer a missing release
+// or acquire in the queue is reported as a data race on the buffer.
+//-----------------------------------------------------------------------------
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../common/spsc_queue.h"
+
+typedef struct
+{
+    uint32_t number;
+    uint32_t complement;
+    uint32_t hash;
+} Item;
+
+SPSC_QUEUE(SmallQueue, Item, 4)
+SPSC_QUEUE(LargeQueue, Item, 256)
+
+SmallQueue small_queue;
+LargeQueue large_queue;
+uint32_t item_count;
+// Set by the consumer on an error, so the producer does not wait forever on a full queue
+atomic_bool stress_failed;
+
+//-----------------------------------------------------------------------------
+uint32_t item_hash(uint32_t number)
+{
+    number ^= number >> 16;
+    number *= 0x7FEB352D;
+    number ^= number >> 15;
+    return number;
+}
+//-----------------------------------------------------------------------------
+Item item_make(uint32_t number)
+{
+    Item item;
+
+    item.number = number;
+    item.complement = ~number;
+    item.hash = item_hash(number);
+    return item;
+}
+//-----------------------------------------------------------------------------
+// Returns 0 if item is number, prints what is wrong otherwise
+int item_check(const Item* item, uint32_t number)
+{
+    if (item->number != number)
+    {
+        printf("item %u: got %u (%s)\n", number, item->number, (item->number < number) ? "repeated" : "lost or reordered");
+        return 1;
+    }
+    if (item->complement != ~number || item->hash != item_hash(number))
+    {
+        printf("item %u: torn, complement %08x hash %08x\n", number, item->complement, item->hash);
+        return 1;
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+// Producer and consumer of one queue type
+#define SPSC_STRESS(name)                                                       \
+void* name##_producer(void* argument)                                           \
+{                                                                               \
+    name* q = argument;                                                         \
+    uint32_t number;                                                            \
+                                                                                \
+    for (number = 0; number < item_count; number++)                             \
+    {                                                                           \
+        while (!name##_enqueue(q, item_make(number)))                           \
+        {                                                                       \
+            if (atomic_load(&stress_failed))                                    \
+            {                                                                   \
+                return NULL;                                                    \
+            }                                                                   \
+            sched_yield();                                                      \
+        }                                                                       \
+    }                                                                           \
+    return NULL;                                                                \
+}                                                                               \
+                                                                                \
+void* name##_consumer(void* argument)                                           \
+{                                                                               \
+    name* q = argument;                                                         \
+    uintptr_t errors = 0;                                                       \
+    uint32_t number;                                                            \
+    Item item;                                                                  \
+                                                                                \
+    for (number = 0; number < item_count && errors == 0; number++)              \
+    {                                                                           \
+        while (!name##_dequeue(q, &item))                                       \
+        {                                                                       \
+            sched_yield();                                                      \
+        }                                                                       \
+        errors += item_check(&item, number);                                    \
+    }                                                                           \
+    /* Nothing may be left over */                                              \
+    if (errors == 0 && !name##_check_empty(q))                                  \
+    {                                                                           \
+        printf("%u items left in the queue\n", name##_count(q));                \
+        errors++;                                                               \
+    }                                                                           \
+    atomic_store(&stress_failed, errors != 0);                                  \
+    return (void*)errors;                                                       \
+}                                                                               \
+                                                                                \
+int name##_run(name* q, uint32_t size)                                          \
+{                                                                               \
+    pthread_t producer;                                                         \
+    pthread_t consumer;                                                         \
+    struct timespec start;                                                      \
+    struct timespec end;                                                        \
+    void* errors;                                                               \
+    double seconds;                                                             \
+                                                                                \
+    name##_init(q);                                                             \
+    clock_gettime(CLOCK_MONOTONIC, &start);                                     \
+    pthread_create(&consumer, NULL, name##_consumer, q);                        \
+    pthread_create(&producer, NULL, name##_producer, q);                        \
+    pthread_join(producer, NULL);                                               \
+    pthread_join(consumer, &errors);                                            \
+    clock_gettime(CLOCK_MONOTONIC, &end);                                       \
+    seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;\
+    printf("queue size %3u: %u items %s, %.1f Mitems/s\n", size, item_count,    \
+           errors ? "FAILED" : "in order, none lost", item_count / seconds * 1e-6);\
+    return errors != NULL;                                                      \
+}
+
+SPSC_STRESS(SmallQueue)
+SPSC_STRESS(LargeQueue)
+
+//-----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    item_count = (argc > 1) ? strtoul(argv[1], NULL, 0) : 20000000;
+    if (SmallQueue_run(&small_queue, 4) || LargeQueue_run(&large_queue, 256))
+    {
+        return 1;
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
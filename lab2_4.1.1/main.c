@@ -21,6 +21,10 @@
 #include "utils/uartstdio.c"
 #include "drivers/pinout.h"
 #include "drivers/CF128x128x16_ST7735S.h"
+#include "../common/profile.h"
+#include "../common/compositor.h"
+#include "../common/framebuffer.h"
+#include "../common/hud.h"
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 
@@ -48,65 +52,6 @@ void ConfigureUART(void)
     UARTStdioConfig(0, 115200, 16000000);
 }
 //=============================================================================
-// A utility function to reverse a string
-void reverse_string(char str[], int length)
-{
-    char temp;
-    int start = 0;
-    int end = length - 1;
-
-    // Switch place on everything until we meet in the middle
-    while (start < end)
-    {
-        temp = str[start];
-        str[start] = str[end];
-        str[end] = temp;
-        end--;
-        start++;
-    }
-}
-//=============================================================================
-// Implementation of itoa()
-char* itoa(int num, char* str, int base)
-{
-    int i = 0;
-    bool isNegative = false;
-
-    /* Handle 0 explicitly, otherwise empty string is
-     * printed for 0 */
-    if (num == 0) {
-        str[i++] = '0';
-        str[i] = '\0';
-        return str;
-    }
-
-    // In standard itoa(), negative numbers are handled
-    // only with base 10. Otherwise numbers are
-    // considered unsigned.
-    if (num < 0 && base == 10) {
-        isNegative = true;
-        num = -num;
-    }
-
-    // Process individual digits
-    while (num != 0) {
-        int rem = num % base;
-        str[i++] = (rem > 9) ? (rem - 10) + 'a' : rem + '0';
-        num = num / base;
-    }
-
-    // If number is negative, append '-'
-    if (isNegative)
-        str[i++] = '-';
-
-    str[i] = '\0'; // Append string terminator
-
-    // Reverse the string
-    reverse_string(str, i);
-
-    return str;
-}
-//=============================================================================
 // Main Function
 int main(void)
 {
@@ -115,8 +60,11 @@ int main(void)
     uint32_t systemClock;
     // Run from the PLL at 40 MHz (needs to be 2*15MHz for SSIConfigSetExpClk(); to work).
     systemClock = SysCtlClockFreqSet((SYSCTL_XTAL_25MHZ | SYSCTL_OSC_MAIN | SYSCTL_USE_PLL | SYSCTL_CFG_VCO_480), 40000000);
+    PROFILE_INIT(systemClock);
 
     tContext context;
+    // Draws the walls, rackets and ball, only what changed each frame
+    Compositor compositor;
     //-----------------------------------------------------------------------------
     // LCD Colors
     // see https://www.ti.com/lit/ug/spmu300e/spmu300e.pdf?ts=1693897900634&ref_url=https%253A%252F%252Fwww.startpage.com%252F page 269
@@ -160,13 +108,14 @@ int main(void)
     // Points
     int16_t left_points = 0;
     int16_t right_points = 0;
+    // One digit each, where the centered text used to be
+    HudField left_points_field;
+    HudField right_points_field;
     //-----------------------------------------------------------------------------
 
     uint32_t joystick_val_ver;
     uint32_t joystick_val_hor;
 
-    char itoa_buf [10];
-
     // Configure the device pins (Ethernet and USB).
     PinoutSet(false, false);
 
@@ -174,16 +123,29 @@ int main(void)
     // LCD
     // Initialize the base LCD driver.
     CF128x128x16_ST7735SInit(systemClock);
+    // Draw into RAM, GrFlush sends what changed to the LCD with uDMA
+    framebuffer_init();
     // Clears/redraws the screen.
-    CF128x128x16_ST7735SClear(background_color);
+    framebuffer_clear(background_color);
     // Initialize the grlib library.
-    GrContextInit(&context, &g_sCF128x128x16_ST7735S);
+    GrContextInit(&context, &framebuffer_display);
     // Sets text font.
     GrContextFontSet(&context, &g_sFontFixed6x8);
     // Set the color for pixels drawn
     GrContextForegroundSet(&context, pixel_color);
     // Sets text background color behind text.
     GrContextBackgroundSet(&context, background_color_text);
+    // Digits of the font for the points
+    hud_init(&g_sFontFixed6x8);
+    hud_field_init(&left_points_field, 41, 61, 1);
+    hud_field_init(&right_points_field, 81, 61, 1);
+    // Objects on the screen, the ball last so it is drawn on top
+    compositor_init(&compositor, &context, background_color);
+    compositor_add(&compositor, &upper_wall, pixel_color);
+    compositor_add(&compositor, &lower_wall, pixel_color);
+    compositor_add(&compositor, &left_racket, pixel_color);
+    compositor_add(&compositor, &right_racket, pixel_color);
+    compositor_add(&compositor, &ball_rectangle, pixel_color);
     //-----------------------------------------------------------------------------
     // VERTICAL
     // Enable the ADC0 module.
@@ -231,45 +193,42 @@ int main(void)
         while((left_points < 3) && (right_points < 3))
         {
             // Clears/redraws the screen.
-            CF128x128x16_ST7735SClear(background_color);
-            // Set pixel color to draw with
-            GrContextForegroundSet(&context, pixel_color);
+            framebuffer_clear(background_color);
+            // Nothing is on the screen anymore, the next flush draws everything
+            compositor_invalidate(&compositor);
+            hud_field_invalidate(&left_points_field);
+            hud_field_invalidate(&right_points_field);
 
-            // Draw upper wall
+            // Upper wall
             upper_wall.i16XMin = 0;
             upper_wall.i16YMin = 0;
             upper_wall.i16XMax = wall_width;
             upper_wall.i16YMax = wall_height;
-            GrRectFill(&context, &upper_wall);
 
-            // Draw lower wall
+            // Lower wall
             lower_wall.i16XMin = 0;
             lower_wall.i16YMin = 128-wall_height;
             lower_wall.i16XMax = wall_width;
             lower_wall.i16YMax = 128;
-            GrRectFill(&context, &lower_wall);
 
-            // Draw left racket, start in middle
+            // Left racket, start in middle
             left_racket.i16XMin = 4;
             left_racket.i16YMin = 48;
             left_racket.i16XMax = left_racket.i16XMin + racket_width;
             left_racket.i16YMax = left_racket.i16YMin + racket_height;
-            GrRectFill(&context, &left_racket);
 
-            // Draw right racket, start in middle
+            // Right racket, start in middle
             right_racket.i16XMin = 128-(racket_width+4);
             right_racket.i16YMin = 48;
             right_racket.i16XMax = 128-4;
             right_racket.i16YMax = right_racket.i16YMin + racket_height;
-            GrRectFill(&context, &right_racket);
-
 
             // Starting position, in the middle
             ball_rectangle.i16XMin = 62;
             ball_rectangle.i16YMin = 62;
             ball_rectangle.i16XMax = ball_rectangle.i16XMin + ball_size;
             ball_rectangle.i16YMax = ball_rectangle.i16YMin + ball_size;
-            GrRectFill(&context, &ball_rectangle);
+            compositor_flush(&compositor);
             // Ball initially moves left
             ball_direction = 180;
             // Initially left racket has control
@@ -281,6 +240,7 @@ int main(void)
             // Loop for one round
             while(1)
             {
+                PROFILE_BEGIN(frame);
                 //-----------------------------------------------------------------------------
                 // VERTICAL
                 // Wait for joystick trigger and then get value.
@@ -310,9 +270,7 @@ int main(void)
                 //-----------------------------------------------------------------------------
                 // Ball movement
                 //-----------------------------------------------------------------------------
-                // First remove old ball position from LCD screen by coloring over it with background color
-                GrContextForegroundSet(&context, background_color);
-                GrRectFill(&context, &ball_rectangle);
+                PROFILE_BEGIN(ball_direction);
                 // Move straight right (east)
                 if(ball_direction == 0)
                 {
@@ -348,11 +306,10 @@ int main(void)
                     ball_rectangle.i16YMin = ball_rectangle.i16YMin + ball_speed;
 
                 }
-                // Update ball position and draw it
+                PROFILE_END(ball_direction);
+                // Update ball position, it is drawn by the compositor at the end of the frame
                 ball_rectangle.i16XMax = ball_rectangle.i16XMin + ball_size;
                 ball_rectangle.i16YMax = ball_rectangle.i16YMin + ball_size;
-                GrContextForegroundSet(&context, pixel_color);
-                GrRectFill(&context, &ball_rectangle);
                 //-----------------------------------------------------------------------------
 
                 //-----------------------------------------------------------------------------
@@ -385,18 +342,12 @@ int main(void)
                     // Move racket up, unless it is at top (Y goes from 0 at top to 128 at bottom)
                     if((joystick_val_ver > 70) && (left_racket.i16YMin > wall_height))
                     {
-                        // Remove old position of left racket by drawing over old position with background color
-                        GrContextForegroundSet(&context, background_color);
-                        GrRectFill(&context, &left_racket);
                         left_racket.i16YMin = left_racket.i16YMin - racket_speed;
                         left_racket.i16YMax = left_racket.i16YMin + racket_height;
                     }
                     // Move racket down, unless it is at bottom (Y goes from 0 at top to 128 at bottom)
                     else if((joystick_val_ver < 30) && (left_racket.i16YMax < (128-wall_height)))
                     {
-                        // Remove old position of left racket by drawing over old position with background color
-                        GrContextForegroundSet(&context, background_color);
-                        GrRectFill(&context, &left_racket);
                         left_racket.i16YMin = left_racket.i16YMin + racket_speed;
                         left_racket.i16YMax = left_racket.i16YMin + racket_height;
                     }
@@ -407,29 +358,17 @@ int main(void)
                     // Move racket up, unless it is at top (Y goes from 0 at top to 128 at bottom)
                     if((joystick_val_ver > 70)  && (right_racket.i16YMin > wall_height))
                     {
-                        // Remove old position of right racket by drawing over old position with background color
-                        GrContextForegroundSet(&context, background_color);
-                        GrRectFill(&context, &right_racket);
                         right_racket.i16YMin = right_racket.i16YMin - racket_speed;
                         right_racket.i16YMax = right_racket.i16YMin + racket_height;
                     }
                     // Move racket down, unless it is at bottom (Y goes from 0 at top to 128 at bottom)
                     else if((joystick_val_ver < 30) && (right_racket.i16YMax < (128-wall_height)))
                     {
-                        // Remove old position of right racket by drawing over old position with background color
-                        GrContextForegroundSet(&context, background_color);
-                        GrRectFill(&context, &right_racket);
                         right_racket.i16YMin = right_racket.i16YMin + racket_speed;
                         right_racket.i16YMax = right_racket.i16YMin + racket_height;
                     }
 
                 }
-                // Redraw/update left racket
-                GrContextForegroundSet(&context, pixel_color);
-                GrRectFill(&context, &left_racket);
-                // Redraw/update right racket
-                GrContextForegroundSet(&context, pixel_color);
-                GrRectFill(&context, &right_racket);
                 //-----------------------------------------------------------------------------
 
                 //-----------------------------------------------------------------------------
@@ -518,12 +457,11 @@ int main(void)
                         ball_direction = 135;
                     }
                 }
-                // Redrawn wall incase ball has hit it
-                GrContextForegroundSet(&context, pixel_color);
-                GrRectFill(&context, &upper_wall);
-                // Redrawn wall incase ball has hit it
-                GrContextForegroundSet(&context, pixel_color);
-                GrRectFill(&context, &lower_wall);
+                //-----------------------------------------------------------------------------
+
+                //-----------------------------------------------------------------------------
+                // Draw what moved (ball and rackets), the parts of the walls the ball has left are redrawn with them
+                compositor_flush(&compositor);
                 //-----------------------------------------------------------------------------
 
                 //-----------------------------------------------------------------------------
@@ -533,8 +471,10 @@ int main(void)
                 if(ball_rectangle.i16XMax < 0)
                 {
                     left_points++;
-                    GrStringDrawCentered(&context, itoa(left_points, itoa_buf, 10), -1, 44, 64, 1);
-                    GrStringDrawCentered(&context, itoa(right_points, itoa_buf, 10), -1, 84, 64, 1);
+                    hud_field_set(&left_points_field, &context, left_points);
+                    hud_field_set(&right_points_field, &context, right_points);
+                    // The screen only changes at GrFlush
+                    GrFlush(&context);
 
                     // This function provides a means of generating a constant length
                     // delay.  The function delay (in cycles) = 3 * parameter.  Delay
@@ -547,8 +487,10 @@ int main(void)
                 else if(ball_rectangle.i16XMax > 128)
                 {
                     right_points++;
-                    GrStringDrawCentered(&context, itoa(left_points, itoa_buf, 10), -1, 44, 64, 1);
-                    GrStringDrawCentered(&context, itoa(right_points, itoa_buf, 10), -1, 84, 64, 1);
+                    hud_field_set(&left_points_field, &context, left_points);
+                    hud_field_set(&right_points_field, &context, right_points);
+                    // The screen only changes at GrFlush
+                    GrFlush(&context);
 
                     // This function provides a means of generating a constant length
                     // delay.  The function delay (in cycles) = 3 * parameter.  Delay
@@ -558,6 +500,9 @@ int main(void)
                     break;
                 }
 
+                PROFILE_END(frame);
+                PROFILE_FRAME();
+
                 // According to the documentation, GrFlush is important to use when drawing pixels, since it ensures any buffered pixels are drawn
                 GrFlush(&context);
 
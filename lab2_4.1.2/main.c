@@ -21,6 +21,11 @@
 #include "utils/uartstdio.c"
 #include "drivers/pinout.h"
 #include "drivers/CF128x128x16_ST7735S.h"
+#include "../common/rect_batch.h"
+#include "../common/profile.h"
+#include "../common/compositor.h"
+#include "../common/framebuffer.h"
+#include "../common/hud.h"
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 
@@ -48,65 +53,6 @@ void ConfigureUART(void)
     UARTStdioConfig(0, 115200, 16000000);
 }
 //=============================================================================
-// A utility function to reverse a string
-void reverse_string(char str[], int length)
-{
-    char temp;
-    int start = 0;
-    int end = length - 1;
-
-    // Switch place on everything until we meet in the middle
-    while (start < end)
-    {
-        temp = str[start];
-        str[start] = str[end];
-        str[end] = temp;
-        end--;
-        start++;
-    }
-}
-//=============================================================================
-// Implementation of itoa()
-char* itoa(int num, char* str, int base)
-{
-    int i = 0;
-    bool isNegative = false;
-
-    /* Handle 0 explicitly, otherwise empty string is
-     * printed for 0 */
-    if (num == 0) {
-        str[i++] = '0';
-        str[i] = '\0';
-        return str;
-    }
-
-    // In standard itoa(), negative numbers are handled
-    // only with base 10. Otherwise numbers are
-    // considered unsigned.
-    if (num < 0 && base == 10) {
-        isNegative = true;
-        num = -num;
-    }
-
-    // Process individual digits
-    while (num != 0) {
-        int rem = num % base;
-        str[i++] = (rem > 9) ? (rem - 10) + 'a' : rem + '0';
-        num = num / base;
-    }
-
-    // If number is negative, append '-'
-    if (isNegative)
-        str[i++] = '-';
-
-    str[i] = '\0'; // Append string terminator
-
-    // Reverse the string
-    reverse_string(str, i);
-
-    return str;
-}
-//=============================================================================
 // Main Function
 int main(void)
 {
@@ -115,8 +61,11 @@ int main(void)
     uint32_t systemClock;
     // Run from the PLL at 40 MHz (needs to be 2*15MHz for SSIConfigSetExpClk(); to work).
     systemClock = SysCtlClockFreqSet((SYSCTL_XTAL_25MHZ | SYSCTL_OSC_MAIN | SYSCTL_USE_PLL | SYSCTL_CFG_VCO_480), 40000000);
+    PROFILE_INIT(systemClock);
 
     tContext context;
+    // Draws the bricks, racket and ball, only what changed each frame
+    Compositor compositor;
     //-----------------------------------------------------------------------------
     // LCD Colors
     // see https://www.ti.com/lit/ug/spmu300e/spmu300e.pdf?ts=1693897900634&ref_url=https%253A%252F%252Fwww.startpage.com%252F page 269
@@ -135,6 +84,8 @@ int main(void)
     int16_t ball_size = 5;
     int16_t ball_speed = 1;
     int16_t num_balls = 5;
+    // Balls left, shown in the middle of the screen after a miss
+    HudField num_balls_field;
     // ball direction works on a unit circle degrees logic, where origin is the ball, so 90 would mean the ball is traveling straight up
     int16_t ball_direction;
     //-----------------------------------------------------------------------------
@@ -148,11 +99,17 @@ int main(void)
     int16_t brick_width = 15;
     int16_t brick_height = 5;
     int16_t num_bricks = 24;
-    tRectangle brick_rectangle;
-    // Matrix for all the brick XMin and YMin coordinates, last value is 1 if the brick has not been destroyed
-    int16_t brick_matrix [3][8][3] = {{{1, 15, 1}, {17, 15, 1}, {33, 15, 1}, {49, 15, 1}, {65, 15, 1}, {81, 15, 1}, {97, 15, 1}, {113, 15, 1}},
-                                   {{1, 21, 1}, {17, 21, 1}, {33, 21, 1}, {49, 21, 1}, {65, 21, 1}, {81, 21, 1}, {97, 21, 1}, {113, 21, 1}},
-                                   {{1, 27, 1}, {17, 27, 1}, {33, 27, 1}, {49, 27, 1}, {65, 27, 1}, {81, 27, 1}, {97, 27, 1}, {113, 27, 1}}};
+    // Brick i is also object i of the compositor
+    tRectangle brick_rectangles[24];
+    // XMin and YMin of all bricks, 3 rows of 8, brick i is in row i/8
+    RectBatch bricks;
+    // Bit i is 1 if brick i has not been destroyed
+    uint32_t bricks_left;
+    // Bit i is 1 if brick i is hit by the ball this frame
+    uint32_t bricks_hit;
+    //-----------------------------------------------------------------------------
+    // Compositor objects
+    int16_t ball_object;
     //-----------------------------------------------------------------------------
 
     int16_t i;
@@ -160,7 +117,15 @@ int main(void)
 
     uint32_t joystick_val_hor;
 
-    char itoa_buf [10];
+    // 8 bricks per row, spaced 1 pixel apart, rows start at Y 15, 21 and 27
+    rect_batch_init(&bricks, brick_width, brick_height);
+    for(i = 0; i < 3; i++)
+    {
+        for(j = 0; j < 8; j++)
+        {
+            rect_batch_add(&bricks, 1 + j*(brick_width+1), 15 + i*(brick_height+1));
+        }
+    }
 
     // Configure the device pins (Ethernet and USB).
     PinoutSet(false, false);
@@ -170,16 +135,31 @@ int main(void)
     //-----------------------------------------------------------------------------
     // Initialize the base LCD driver.
     CF128x128x16_ST7735SInit(systemClock);
+    // Draw into RAM, GrFlush sends what changed to the LCD with uDMA
+    framebuffer_init();
     // Clears/redraws the screen.
-    CF128x128x16_ST7735SClear(background_color);
+    framebuffer_clear(background_color);
     // Initialize the grlib library.
-    GrContextInit(&context, &g_sCF128x128x16_ST7735S);
+    GrContextInit(&context, &framebuffer_display);
     // Sets text font.
     GrContextFontSet(&context, &g_sFontFixed6x8);
     // Set the color for pixels drawn
     GrContextForegroundSet(&context, racket_ball_color);
     // Sets text background color behind text.
     GrContextBackgroundSet(&context, background_color_text);
+    // Digits of the font for the number of balls
+    hud_init(&g_sFontFixed6x8);
+    hud_field_init(&num_balls_field, 61, 77, 1);
+    // Objects on the screen, the bricks first so their ids are the brick numbers, the ball last so it is drawn on top
+    compositor_init(&compositor, &context, background_color);
+    for(i = 0; i < 24; i++)
+    {
+        rect_batch_get(&bricks, i, &brick_rectangles[i]);
+        // First row yellow, second lime, third blue violet
+        compositor_add(&compositor, &brick_rectangles[i], (i < 8) ? top_row : ((i < 16) ? mid_row : bottom_row));
+    }
+    compositor_add(&compositor, &bottom_racket, racket_ball_color);
+    ball_object = compositor_add(&compositor, &ball_rectangle, racket_ball_color);
     //-----------------------------------------------------------------------------
     // HORIZONTAL
     //-----------------------------------------------------------------------------
@@ -206,47 +186,24 @@ int main(void)
         num_balls = 5;
         num_bricks = 24;
         // Clears/redraws the screen.
-        CF128x128x16_ST7735SClear(background_color);
+        framebuffer_clear(background_color);
+
+        // Nothing is on the screen anymore, the next flush draws everything
+        compositor_invalidate(&compositor);
 
-        // Draw racket, start in middle
+        // Racket, start in middle
         bottom_racket.i16XMin = 54;
         bottom_racket.i16YMin = 128-racket_height;
         bottom_racket.i16XMax = bottom_racket.i16XMin + racket_width;
         bottom_racket.i16YMax = 128;
-        // Set the color for pixels drawn
-        GrContextForegroundSet(&context, racket_ball_color);
-        GrRectFill(&context, &bottom_racket);
-
 
-        // Create and draw all bricks
-        for(i = 0; i < 3; i++)
+        // All bricks
+        for(i = 0; i < 24; i++)
         {
-            // First row color
-            if(i == 0)
-            {
-                GrContextForegroundSet(&context, top_row);
-            }
-            // Second row color
-            else if (i == 1)
-            {
-                GrContextForegroundSet(&context, mid_row);
-            }
-            // Third row color
-            else
-            {
-                GrContextForegroundSet(&context, bottom_row);
-            }
-            for(j = 0; j < 8; j++)
-            {
-                // Set last value back to 1 to mark them as not destroyed again
-                brick_matrix[i][j][2] = 1;
-                brick_rectangle.i16XMin = brick_matrix[i][j][0];
-                brick_rectangle.i16YMin = brick_matrix[i][j][1];
-                brick_rectangle.i16XMax = brick_rectangle.i16XMin + brick_width;
-                brick_rectangle.i16YMax = brick_rectangle.i16YMin + brick_height;
-                GrRectFill(&context, &brick_rectangle);
-            }
+            compositor_show(&compositor, i, true);
         }
+        // Mark all bricks as not destroyed again
+        bricks_left = rect_batch_mask(&bricks);
 
         // Loop for one game
         while((num_balls > 0) && (num_bricks > 0))
@@ -256,9 +213,8 @@ int main(void)
             ball_rectangle.i16YMin = 50;
             ball_rectangle.i16XMax = ball_rectangle.i16XMin + ball_size;
             ball_rectangle.i16YMax = ball_rectangle.i16YMin + ball_size;
-            // Set the color for pixels drawn
-            GrContextForegroundSet(&context, racket_ball_color);
-            GrRectFill(&context, &ball_rectangle);
+            compositor_show(&compositor, ball_object, true);
+            compositor_flush(&compositor);
             // Ball initially moves south west or south east
             if(rand() > roundf(32767.0/2.0))
             {
@@ -272,6 +228,7 @@ int main(void)
             // Loop for not missing ball
             while(1)
             {
+                PROFILE_BEGIN(frame);
                 //-----------------------------------------------------------------------------
                 // HORIZONTAL
                 //-----------------------------------------------------------------------------
@@ -290,9 +247,6 @@ int main(void)
                 //-----------------------------------------------------------------------------
                 // Ball movement
                 //-----------------------------------------------------------------------------
-                // First remove old ball position from LCD screen by coloring over it with background color
-                GrContextForegroundSet(&context, background_color);
-                GrRectFill(&context, &ball_rectangle);
                 // Move straight up (north)
                 if(ball_direction == 90)
                 {
@@ -330,13 +284,9 @@ int main(void)
                     ball_rectangle.i16YMin = ball_rectangle.i16YMin + ball_speed;
 
                 }
-                // Update ball position
+                // Update ball position, it is drawn by the compositor at the end of the frame
                 ball_rectangle.i16XMax = ball_rectangle.i16XMin + ball_size;
                 ball_rectangle.i16YMax = ball_rectangle.i16YMin + ball_size;
-                // Set the color for pixels drawn
-                GrContextForegroundSet(&context, racket_ball_color);
-                // Draw new position
-                GrRectFill(&context, &ball_rectangle);
                 //-----------------------------------------------------------------------------
 
                 //-----------------------------------------------------------------------------
@@ -345,26 +295,15 @@ int main(void)
                 // Move racket left, unless it is at left corner
                 if ((joystick_val_hor < 30) && (bottom_racket.i16XMin > 0))
                 {
-                    // Remove old position of left racket by drawing over old position with background color
-                    GrContextForegroundSet(&context, background_color);
-                    GrRectFill(&context, &bottom_racket);
                     bottom_racket.i16XMin = bottom_racket.i16XMin - racket_speed;
                     bottom_racket.i16XMax = bottom_racket.i16XMin + racket_width;
                 }
                 // Move racket right, unless it is at right corner
                 else if ((joystick_val_hor > 70) && (bottom_racket.i16XMax < 128))
                 {
-                    // Remove old position of left racket by drawing over old position with background color
-                    GrContextForegroundSet(&context, background_color);
-                    GrRectFill(&context, &bottom_racket);
                     bottom_racket.i16XMin = bottom_racket.i16XMin + racket_speed;
                     bottom_racket.i16XMax = bottom_racket.i16XMin + racket_width;
                 }
-                // Redraw/update racket
-                // Set the color for pixels drawn
-                GrContextForegroundSet(&context, racket_ball_color);
-                GrRectFill(&context, &bottom_racket);
-
                 //-----------------------------------------------------------------------------
                 // Racket ball logic
                 //-----------------------------------------------------------------------------
@@ -438,55 +377,48 @@ int main(void)
                 //-----------------------------------------------------------------------------
                 // Brick logic
                 //-----------------------------------------------------------------------------
-                // Check all bricks that haven't been destroyed
-                for (i = 0; i < 3; i++)
+                PROFILE_BEGIN(brick_scan);
+                // Test the ball against all bricks at once, only bricks that haven't been destroyed count
+                bricks_hit = rect_batch_overlap(&bricks, &ball_rectangle) & bricks_left;
+                // Go through the hit bricks, stops after the last one
+                for (i = 0; bricks_hit != 0; i++, bricks_hit >>= 1)
                 {
-                    for (j = 0; j < 8; j++)
+                    // Check if brick is hit by ball
+                    if(bricks_hit & 1)
                     {
-                        // If brick hasn't been destroyed
-                        if(brick_matrix[i][j][2] == 1)
+                        // Set brick to destroyed
+                        bricks_left &= ~((uint32_t)1 << i);
+                        // Clear hit brick
+                        compositor_show(&compositor, i, false);
+                        num_bricks--;
+
+                        //-----------------------------------------------------------------------------
+                        // Fix ball bounce on brick
+                        //-----------------------------------------------------------------------------
+                        if (ball_direction == 45)
+                        {
+                            ball_direction = 315;
+                        }
+                        else if(ball_direction == 135)
+                        {
+                            ball_direction = 225;
+                        }
+                        else if(ball_direction == 225)
+                        {
+                            ball_direction = 135;
+                        }
+                        else if(ball_direction == 315)
                         {
-                            brick_rectangle.i16XMin = brick_matrix[i][j][0];
-                            brick_rectangle.i16YMin = brick_matrix[i][j][1];
-                            brick_rectangle.i16XMax = brick_rectangle.i16XMin + brick_width;
-                            brick_rectangle.i16YMax = brick_rectangle.i16YMin + brick_height;
-                            // Check if brick is hit by ball
-                            if(GrRectOverlapCheck(&ball_rectangle, &brick_rectangle))
-                            {
-                                // Set brick to destroyed
-                                brick_matrix[i][j][2] = 0;
-                                // Clear hit brick
-                                GrContextForegroundSet(&context, background_color);
-                                GrRectFill(&context, &brick_rectangle);
-                                num_bricks--;
-
-                                //-----------------------------------------------------------------------------
-                                // Fix ball bounce on brick
-                                //-----------------------------------------------------------------------------
-                                if (ball_direction == 45)
-                                {
-                                    ball_direction = 315;
-                                }
-                                else if(ball_direction == 135)
-                                {
-                                    ball_direction = 225;
-                                }
-                                else if(ball_direction == 225)
-                                {
-                                    ball_direction = 135;
-                                }
-                                else if(ball_direction == 315)
-                                {
-                                    ball_direction = 45;
-                                }
-                                //-----------------------------------------------------------------------------
-                                // Redraw ball
-                                GrContextForegroundSet(&context, racket_ball_color);
-                                GrRectFill(&context, &ball_rectangle);
-                            }
+                            ball_direction = 45;
                         }
                     }
                 }
+                PROFILE_END(brick_scan);
+                //-----------------------------------------------------------------------------
+
+                //-----------------------------------------------------------------------------
+                // Draw what changed (ball, racket and hit bricks)
+                compositor_flush(&compositor);
                 //-----------------------------------------------------------------------------
 
                 //-----------------------------------------------------------------------------
@@ -496,15 +428,17 @@ int main(void)
                 if(ball_rectangle.i16YMax > 128)
                 {
                     // Clear the missed ball
-                    GrContextForegroundSet(&context, background_color);
-                    GrRectFill(&context, &ball_rectangle);
+                    compositor_show(&compositor, ball_object, false);
+                    compositor_flush(&compositor);
 
                     num_balls--;
                     // Set the color for pixels drawn
                     GrContextForegroundSet(&context, racket_ball_color);
                     // Sets text background color behind text.
                     GrContextBackgroundSet(&context, background_color_text);
-                    GrStringDrawCentered(&context, itoa(num_balls, itoa_buf, 10), -1, 64, 80, 1);
+                    hud_field_set(&num_balls_field, &context, num_balls);
+                    // The screen only changes at GrFlush
+                    GrFlush(&context);
 
                     // This function provides a means of generating a constant length
                     // delay.  The function delay (in cycles) = 3 * parameter.  Delay
@@ -512,10 +446,8 @@ int main(void)
                     MAP_SysCtlDelay(systemClock / 4);
 
                     // Clear the text just written
-                    GrContextForegroundSet(&context, background_color);
-                    // Sets text background color behind text.
                     GrContextBackgroundSet(&context, background_color);
-                    GrStringDrawCentered(&context, itoa(num_balls, itoa_buf, 10), -1, 64, 80, 1);
+                    hud_field_clear(&num_balls_field, &context);
 
                     break;
                 }
@@ -527,6 +459,8 @@ int main(void)
                     // Sets text background color behind text.
                     GrContextBackgroundSet(&context, background_color_text);
                     GrStringDrawCentered(&context, "Victory", -1, 64, 80, 1);
+                    // The screen only changes at GrFlush
+                    GrFlush(&context);
 
                     // This function provides a means of generating a constant length
                     // delay.  The function delay (in cycles) = 3 * parameter.  Delay
@@ -537,6 +471,9 @@ int main(void)
                 }
                 //-----------------------------------------------------------------------------
 
+                PROFILE_END(frame);
+                PROFILE_FRAME();
+
                 // According to the documentation, GrFlush is important to use when drawing pixels, since it ensures any buffered pixels are drawn
                 GrFlush(&context);
 
@@ -21,6 +21,10 @@
 #include "utils/uartstdio.c"
 #include "drivers/pinout.h"
 #include "drivers/CF128x128x16_ST7735S.h"
+#include "../common/rect_batch.h"
+#include "../common/profile.h"
+#include "../common/compositor.h"
+#include "../common/framebuffer.h"
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 
@@ -56,8 +60,11 @@ int main(void)
     uint32_t systemClock;
     // Run from the PLL at 40 MHz (needs to be 2*15MHz for SSIConfigSetExpClk(); to work).
     systemClock = SysCtlClockFreqSet((SYSCTL_XTAL_25MHZ | SYSCTL_OSC_MAIN | SYSCTL_USE_PLL | SYSCTL_CFG_VCO_480), 40000000);
+    PROFILE_INIT(systemClock);
 
     tContext context;
+    // Draws the asteroids, laser and ship, only what changed each frame
+    Compositor compositor;
     //-----------------------------------------------------------------------------
     // LCD Colors
     // see https://www.ti.com/lit/ug/spmu300e/spmu300e.pdf?ts=1693897900634&ref_url=https%253A%252F%252Fwww.startpage.com%252F page 269
@@ -82,13 +89,19 @@ int main(void)
     int16_t laser_active = 0;
     //-----------------------------------------------------------------------------
     // Asteroid
-    tRectangle asteroid_rectangle;
+    // Asteroid i is also object i of the compositor, copied from the batch before drawing
+    tRectangle asteroid_rectangles[24];
     int16_t asteroid_size = 9;
     int16_t asteroid_speed = 5;
-    // Matrix for all the asteroid XMin and YMin coordinates, last value is 1 if the asteroid has not been destroyed
-    int16_t asteroid_matrix [24][2] = {{-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10},
-                                       {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10},
-                                       {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}, {-10, -10}};
+    // XMin and YMin of all 24 asteroids
+    RectBatch asteroids;
+    // Bit i is 1 if asteroid i is hit by the laser
+    uint32_t asteroids_hit;
+    // Bit i is 1 if asteroid i hits the ship
+    uint32_t ship_hit;
+    //-----------------------------------------------------------------------------
+    // Compositor objects
+    int16_t laser_object;
     //-----------------------------------------------------------------------------
 
     uint32_t joystick_val_hor;
@@ -96,6 +109,12 @@ int main(void)
 
     int16_t i;
 
+    rect_batch_init(&asteroids, asteroid_size, asteroid_size);
+    for(i=0 ; i<24 ; i++)
+    {
+        rect_batch_add(&asteroids, -10, -10);
+    }
+
     // Configure the device pins (Ethernet and USB).
     PinoutSet(false, false);
 
@@ -104,16 +123,27 @@ int main(void)
     //-----------------------------------------------------------------------------
     // Initialize the base LCD driver.
     CF128x128x16_ST7735SInit(systemClock);
+    // Draw into RAM, GrFlush sends what changed to the LCD with uDMA
+    framebuffer_init();
     // Clears/redraws the screen.
-    CF128x128x16_ST7735SClear(background_color);
+    framebuffer_clear(background_color);
     // Initialize the grlib library.
-    GrContextInit(&context, &g_sCF128x128x16_ST7735S);
+    GrContextInit(&context, &framebuffer_display);
     // Sets text font.
     GrContextFontSet(&context, &g_sFontFixed6x8);
     // Set the color for pixels drawn
     GrContextForegroundSet(&context, ship_color);
     // Sets text background color behind text.
     GrContextBackgroundSet(&context, background_color_text);
+    // Objects on the screen, the asteroids first so their ids are the asteroid numbers
+    // The ship is above the laser since the laser spawns on it
+    compositor_init(&compositor, &context, background_color);
+    for(i=0 ; i<24 ; i++)
+    {
+        compositor_add(&compositor, &asteroid_rectangles[i], asteroid_color);
+    }
+    laser_object = compositor_add(&compositor, &laser_rectangle, laser_color);
+    compositor_add(&compositor, &ship_rectangle, ship_color);
     //-----------------------------------------------------------------------------
     // HORIZONTAL
     // Enable the ADC1 module.
@@ -149,28 +179,31 @@ int main(void)
     while(1)
     {
         // Clears/redraws the screen.
-        CF128x128x16_ST7735SClear(background_color);
-        // Draw player at bottom mid
+        framebuffer_clear(background_color);
+        // Nothing is on the screen anymore, the next flush draws everything
+        compositor_invalidate(&compositor);
+        // Player at bottom mid
         ship_rectangle.i16XMin = 60;
         ship_rectangle.i16YMin = 122 - ship_size;
         ship_rectangle.i16XMax = ship_rectangle.i16XMin + ship_size;
         ship_rectangle.i16YMax = 122;
-        GrContextForegroundSet(&context, ship_color);
-        GrRectFill(&context, &ship_rectangle);
 
         for(i=0 ; i<24 ; i++)
         {
             // X, random start x-value
-            asteroid_matrix[i][0] = roundf(((128.0-asteroid_size) / 32767.0) * rand());
+            asteroids.x[i] = roundf(((128.0-asteroid_size) / 32767.0) * rand());
             // Y, give a random - y-value to make them not appear all at the same time
-            asteroid_matrix[i][1] = -roundf((1000.0 / 32767.0) * rand());
+            asteroids.y[i] = -roundf((1000.0 / 32767.0) * rand());
             // Set all asteroids as not destroyed
 
-            // We do not need to draw the asteroids yet since they are not within the screen yet
+            // The asteroids are not within the screen yet, the compositor skips them
+            rect_batch_get(&asteroids, i, &asteroid_rectangles[i]);
         }
 
         // No laser has been shot
         laser_active = 0;
+        compositor_show(&compositor, laser_object, false);
+        compositor_flush(&compositor);
         // These are set to avoid values from last loop persisting and having an effect on the new loop
         ADCSequenceDataGet(ADC1_BASE, 0, &joystick_val_hor);
         joystick_val_hor = 50;
@@ -178,6 +211,7 @@ int main(void)
         // Loop for one round
         while(1)
         {
+            PROFILE_BEGIN(frame);
             //-----------------------------------------------------------------------------
             // HORIZONTAL
             // Wait for joystick trigger and then get value.
@@ -202,29 +236,17 @@ int main(void)
             // Move right
             if ((joystick_val_hor > 60) && (ship_rectangle.i16XMax < 128))
             {
-                // Character has moved, remove old location
-                GrContextForegroundSet(&context, background_color);
-                GrRectFill(&context, &ship_rectangle);
                 // Update position
                 ship_rectangle.i16XMin = ship_rectangle.i16XMin + ship_speed;
                 ship_rectangle.i16XMax = ship_rectangle.i16XMin + ship_size;
-                // Character has moved, remove old location
-                GrContextForegroundSet(&context, ship_color);
-                GrRectFill(&context, &ship_rectangle);
             }
             //-----------------------------------------------------------------------------
             // Move left
             else if ((joystick_val_hor < 40) && (ship_rectangle.i16XMin > 0))
             {
-                // Character has moved, remove old location
-                GrContextForegroundSet(&context, background_color);
-                GrRectFill(&context, &ship_rectangle);
                 // Update position
                 ship_rectangle.i16XMin = ship_rectangle.i16XMin - ship_speed;
                 ship_rectangle.i16XMax = ship_rectangle.i16XMin + ship_size;
-                // Character has moved, remove old location
-                GrContextForegroundSet(&context, ship_color);
-                GrRectFill(&context, &ship_rectangle);
             }
             //-----------------------------------------------------------------------------
 
@@ -240,12 +262,6 @@ int main(void)
                 laser_rectangle.i16YMin = ship_rectangle.i16YMin - (laser_height+1);
                 laser_rectangle.i16XMax = laser_rectangle.i16XMin + laser_width;
                 laser_rectangle.i16YMax = laser_rectangle.i16YMin + laser_height;
-                // Draw laser
-                GrContextForegroundSet(&context, laser_color);
-                GrRectFill(&context, &laser_rectangle);
-                // Redraw ship since laser spawns on ship and overwrites part of ship
-                GrContextForegroundSet(&context, ship_color);
-                GrRectFill(&context, &ship_rectangle);
 
                 // A laser has been shot and is active
                 laser_active = 1;
@@ -254,15 +270,9 @@ int main(void)
             // Updates laser position
             else if (laser_active == 1)
             {
-                // First remove old laser position
-                GrContextForegroundSet(&context, background_color);
-                GrRectFill(&context, &laser_rectangle);
                 // Update laser position, only moves in y-axis
                 laser_rectangle.i16YMin = laser_rectangle.i16YMin - laser_speed;
                 laser_rectangle.i16YMax = laser_rectangle.i16YMin + laser_height;
-                // Draw laser
-                GrContextForegroundSet(&context, laser_color);
-                GrRectFill(&context, &laser_rectangle);
             }
             //-----------------------------------------------------------------------------
             // If laser goes outside screen, it despawns
@@ -276,50 +286,46 @@ int main(void)
             //-----------------------------------------------------------------------------
             // Asteroids
             //-----------------------------------------------------------------------------
-            // Loop through the asteroid matrix
+            // Update the positions, they only move in y-axis
+            PROFILE_BEGIN(asteroid_update);
             for(i=0 ; i<24 ; i++)
             {
-                //-----------------------------------------------------------------------------
-                // Update position
-                // First check if asteroid coordinates are on screen, otherwise we don't need to remove old position from screen
-                if((asteroid_matrix[i][1] + asteroid_size) > (0-asteroid_size))
-                {
-                    // First remove old position
-                    asteroid_rectangle.i16XMin = asteroid_matrix[i][0];
-                    asteroid_rectangle.i16YMin = asteroid_matrix[i][1];
-                    asteroid_rectangle.i16XMax = asteroid_rectangle.i16XMin + asteroid_size;
-                    asteroid_rectangle.i16YMax = asteroid_rectangle.i16YMin + asteroid_size;
-                    // Redraw old position with background color (erasing old position)
-                    GrContextForegroundSet(&context, background_color);
-                    GrRectFill(&context, &asteroid_rectangle);
-                }
-
-                // Update position, it only moves in y-axis
-                asteroid_matrix[i][1] = asteroid_matrix[i][1] + asteroid_speed;
-                asteroid_rectangle.i16YMin = asteroid_matrix[i][1];
-                asteroid_rectangle.i16YMax = asteroid_rectangle.i16YMin + asteroid_size;
+                asteroids.y[i] = asteroids.y[i] + asteroid_speed;
+            }
+            // Test the ship and the laser against all asteroids at once, at their new positions
+            ship_hit = rect_batch_overlap(&asteroids, &ship_rectangle);
+            asteroids_hit = (laser_active == 1) ? rect_batch_overlap(&asteroids, &laser_rectangle) : 0;
+            PROFILE_END(asteroid_update);
+            //-----------------------------------------------------------------------------
 
-                // We only need to draw new position if it is on screen
-                if((asteroid_matrix[i][1] + asteroid_size) > (0-asteroid_size))
-                {
-                    // Draw new position
-                    GrContextForegroundSet(&context, asteroid_color);
-                    GrRectFill(&context, &asteroid_rectangle);
-                }
-                //-----------------------------------------------------------------------------
+            //-----------------------------------------------------------------------------
+            // Then go through the asteroids one at a time like before the batch test: show the new
+            // position, ship hit, respawn at the bottom, laser hit. This keeps the rand() calls of
+            // the respawns in the same order, and the asteroids after the one that hits the ship
+            // are not moved on the screen.
+            for(i=0 ; i<24 ; i++)
+            {
+                // Asteroids that are not on the screen yet are skipped by the compositor
+                rect_batch_get(&asteroids, i, &asteroid_rectangles[i]);
 
                 //-----------------------------------------------------------------------------
                 // Asteroid hits ship
-                if(GrRectOverlapCheck(&asteroid_rectangle, &ship_rectangle))
+                if(ship_hit & ((uint32_t)1 << i))
                 {
                     // Despawn laser
                     laser_active = 0;
 
+                    // Draw the collision before the text
+                    compositor_show(&compositor, laser_object, false);
+                    compositor_flush(&compositor);
+
                     // Set the color for pixels drawn
                     GrContextForegroundSet(&context, ship_color);
                     // Sets text background color behind text.
                     GrContextBackgroundSet(&context, background_color_text);
                     GrStringDrawCentered(&context, "Defeat", -1, 64, 80, 1);
+                    // The screen only changes at GrFlush
+                    GrFlush(&context);
 
                     // This function provides a means of generating a constant length
                     // delay.  The function delay (in cycles) = 3 * parameter.  Delay
@@ -334,37 +340,41 @@ int main(void)
                 //-----------------------------------------------------------------------------
                 // Respawn
                 // If asteroid disappears down on screen
-                if((asteroid_matrix[i][1] > 128))
+                if((asteroids.y[i] > 128))
                 {
                     // Respawn asteroid
                     // X, random start x-value
-                    asteroid_matrix[i][0] = roundf(((128.0-asteroid_size) / 32767.0) * rand());
+                    asteroids.x[i] = roundf(((128.0-asteroid_size) / 32767.0) * rand());
                     // Y, give a random - y-value to make them not appear all at the same time
-                    asteroid_matrix[i][1] = -roundf((1000.0 / 32767.0) * rand());
+                    asteroids.y[i] = -roundf((1000.0 / 32767.0) * rand());
+                    rect_batch_get(&asteroids, i, &asteroid_rectangles[i]);
                 }
-                // If laser is active and hits an asteroid
-                if((laser_active == 1) && (GrRectOverlapCheck(&asteroid_rectangle, &laser_rectangle)))
+                // If laser is active and hits an asteroid, only the first one hit is destroyed
+                if((laser_active == 1) && (asteroids_hit & ((uint32_t)1 << i)))
                 {
-                    // Despawn asteroid
-                    GrContextForegroundSet(&context, background_color);
-                    GrRectFill(&context, &asteroid_rectangle);
-
-                    // Respawn asteroid
+                    // Despawn asteroid, respawn it above the screen
                     // X, random start x-value
-                    asteroid_matrix[i][0] = roundf(((128.0 - asteroid_size) / 32767.0) * rand());
+                    asteroids.x[i] = roundf(((128.0 - asteroid_size) / 32767.0) * rand());
                     // Y, give a random - y-value to make them not appear all at the same time
-                    asteroid_matrix[i][1] = -roundf((1000.0 / 32767.0) * rand());
+                    asteroids.y[i] = -roundf((1000.0 / 32767.0) * rand());
+                    rect_batch_get(&asteroids, i, &asteroid_rectangles[i]);
 
                     // Despawn laser
-                    GrContextForegroundSet(&context, background_color);
-                    GrRectFill(&context, &laser_rectangle);
                     laser_active = 0;
                 }
                 //-----------------------------------------------------------------------------
-
             }
             //-----------------------------------------------------------------------------
 
+            //-----------------------------------------------------------------------------
+            // Draw what changed (asteroids, ship and laser)
+            compositor_show(&compositor, laser_object, laser_active);
+            compositor_flush(&compositor);
+            //-----------------------------------------------------------------------------
+
+            PROFILE_END(frame);
+            PROFILE_FRAME();
+
             // According to the documentation, GrFlush is important to use when drawing pixels, since it ensures any buffered pixels are drawn
             GrFlush(&context);
 
@@ -1,21 +1,73 @@
 #include<stdio.h>
 
-// Limited by RAM size
-#define QUEUESIZE 60
+#include "../common/ring_buffer.h"
 
 typedef struct
 {
     int16_t x;
     int16_t y;
 } Coordinat;
+
+//-----------------------------------------------------------------------------
+// Occupancy grid
+// The snake only moves in steps of snake_body_size+2 = 11 pixels from its starting position 60,60 (see main.c),
+// so every part of the snake lies on a grid of 11x11 cells. The first cell that is on screen starts at 60 - 5*11 = 5.
+#define GRID_STEP 11
+#define GRID_ORIGIN 5
+// Number of cells on screen in x and y, the last one is 5 + 10*11 = 115 to 124
+#define GRID_SIZE 11
+#define GRID_CELLS (GRID_SIZE*GRID_SIZE)
+// One bit per cell
+#define GRID_WORDS ((GRID_CELLS + 31) / 32)
+//-----------------------------------------------------------------------------
+
+// The body is stored as one byte cell index per part instead of an x, y pixel coordinat,
+// so a snake covering every cell on screen (121) only needs 128 bytes.
+// Has to be a power of two so that stepping through the queue is a mask instead of a division
+#define QUEUESIZE 128
+
+// front (oldest, snake tail) is at head, rear (newest, snake head) is at tail-1
+RING_BUFFER(CellRing, uint8_t, QUEUESIZE)
+
 typedef struct
 {
-    int16_t front;
-    int16_t rear;
-    Coordinat queue[QUEUESIZE];
+    CellRing body;
+    // Bit is set if a part of the snake is in that cell, kept up to date by enqueue and dequeue
+    uint32_t occupied[GRID_WORDS];
+    // Set by enqueue if a part was added to a cell that was already occupied
+    int16_t overlap;
 } CircularQueue;
- 
 
+//-----------------------------------------------------------------------------
+// Cell (index into occupied) that coordinate x, y lies on
+// Returns -1 if x, y is not on the grid (outside of the screen)
+int16_t grid_cell(int16_t x, int16_t y)
+{
+    int16_t column;
+    int16_t row;
+
+    if ((x < GRID_ORIGIN) || (y < GRID_ORIGIN))
+    {
+        return -1;
+    }
+    column = (x - GRID_ORIGIN) / GRID_STEP;
+    row = (y - GRID_ORIGIN) / GRID_STEP;
+    if ((column >= GRID_SIZE) || (row >= GRID_SIZE) ||
+            ((x - GRID_ORIGIN) != column * GRID_STEP) || ((y - GRID_ORIGIN) != row * GRID_STEP))
+    {
+        return -1;
+    }
+    return row * GRID_SIZE + column;
+}
+//-----------------------------------------------------------------------------
+// Pixel coordinat of the upper left corner of cell, only needed when drawing
+Coordinat cell_coordinat(uint8_t cell)
+{
+    Coordinat temp;
+    temp.x = GRID_ORIGIN + (cell % GRID_SIZE) * GRID_STEP;
+    temp.y = GRID_ORIGIN + (cell / GRID_SIZE) * GRID_STEP;
+    return temp;
+}
 //-----------------------------------------------------------------------------
 // LEGACY
 // DOESNT WORK, NOT USED
@@ -24,175 +76,249 @@ typedef struct
 // S i head of snake, O is another part of the snake
 int16_t check_overlap(CircularQueue* q, int16_t size)
 {
-    // Temp is used to step through the list and check all elements
-    int16_t temp = q->front;
+    // The queue content is at most two contiguous spans, step through both and check all elements
+    uint8_t* spans[2];
+    uint16_t counts[2];
+    int16_t span;
+    uint16_t temp;
+    Coordinat front;
+    Coordinat part;
+
+    if (CellRing_check_empty(&q->body))
+    {
+        return 0;
+    }
+    CellRing_spans(&q->body, &spans[0], &counts[0], &spans[1], &counts[1]);
+    front = cell_coordinat(spans[0][0]);
+    // This will make sure we do not check with head of snake
+    spans[0]++;
+    counts[0]--;
     // Go through entire list to see if snake overlaps with any part of itself
-    while(temp != q->rear)
+    for(span = 0; span < 2; span++)
     {
-        // This will make sure we do not check with head of snake
-        temp = (temp+1) % QUEUESIZE;
-        /* The following is the logic in order, first the first part of the OR, then the second part of the OR etc
-         * --------------------------------------------------------------------
-         *
-         *        +
-         *        +
-         *     +  +
-         *     +  +
-         *    -+--S++++
-         *     +  -
-         * ----O++++
-         *     -  -
-         *     -  -
-         *     -
-         *     -
-         *
-         * --------------------------------------------------------------------
-         *
-         *     +
-         *     +
-         *     +
-         *     + +
-         * ----S++++
-         *       +
-         *       +
-         *   ----O++++
-         *       -
-         *       -
-         *       -
-         *       -
-         *
-         * --------------------------------------------------------------------
-         *
-         *         +
-         *      +  +
-         *      +  +
-         *      +  +
-         *     ----O++++
-         *  ----S++-+
-         *      -  -
-         *      -  -
-         *      -  -
-         *      -
-         *
-         * --------------------------------------------------------------------
-         *
-         *     +
-         *     +
-         *     +
-         *     +   +
-         * ----O++++
-         *     -   +
-         *     -   +
-         *     ----S++++
-         *     -   -
-         *         -
-         *         -
-         *         -
-         *
-         * --------------------------------------------------------------------
-         */
-        if(((q->queue[q->front].x < (q->queue[temp].x + size)) && (q->queue[q->front].y < (q->queue[temp].y + size))) ||
-                ((q->queue[q->front].x > (q->queue[temp].x - size)) && (q->queue[q->front].y < (q->queue[temp].y + size))) ||
-                ((q->queue[q->front].x > (q->queue[temp].x - size)) && (q->queue[q->front].y > (q->queue[temp].y - size))) ||
-                ((q->queue[q->front].x < (q->queue[temp].x + size)) && (q->queue[q->front].y > (q->queue[temp].y - size))))
+        for(temp = 0; temp < counts[span]; temp++)
         {
-            return 1;
+            part = cell_coordinat(spans[span][temp]);
+            /* The following is the logic in order, first the first part of the OR, then the second part of the OR etc
+             * --------------------------------------------------------------------
+             *
+             *        +
+             *        +
+             *     +  +
+             *     +  +
+             *    -+--S++++
+             *     +  -
+             * ----O++++
+             *     -  -
+             *     -  -
+             *     -
+             *     -
+             *
+             * --------------------------------------------------------------------
+             *
+             *     +
+             *     +
+             *     +
+             *     + +
+             * ----S++++
+             *       +
+             *       +
+             *   ----O++++
+             *       -
+             *       -
+             *       -
+             *       -
+             *
+             * --------------------------------------------------------------------
+             *
+             *         +
+             *      +  +
+             *      +  +
+             *      +  +
+             *     ----O++++
+             *  ----S++-+
+             *      -  -
+             *      -  -
+             *      -  -
+             *      -
+             *
+             * --------------------------------------------------------------------
+             *
+             *     +
+             *     +
+             *     +
+             *     +   +
+             * ----O++++
+             *     -   +
+             *     -   +
+             *     ----S++++
+             *     -   -
+             *         -
+             *         -
+             *         -
+             *
+             * --------------------------------------------------------------------
+             */
+            if(((front.x < (part.x + size)) && (front.y < (part.y + size))) ||
+                    ((front.x > (part.x - size)) && (front.y < (part.y + size))) ||
+                    ((front.x > (part.x - size)) && (front.y > (part.y - size))) ||
+                    ((front.x < (part.x + size)) && (front.y > (part.y - size))))
+            {
+                return 1;
+            }
         }
     }
     return 0;
 }
 //-----------------------------------------------------------------------------
-// Here we check if the Circular queue is full or not
-int16_t check_full (CircularQueue* q)
+// Returns 1 if a part of the snake is in cell
+int16_t check_cell(CircularQueue* q, int16_t cell)
+{
+    return (q->occupied[cell >> 5] >> (cell & 31)) & 1;
+}
+//-----------------------------------------------------------------------------
+// Returns the cell of the head of the snake (the newest part), -1 if the queue is empty
+int16_t head_cell(CircularQueue* q)
 {
-    if ((q->front == q->rear + 1) || (q->front == 0 && q->rear == QUEUESIZE - 1))
+    if (CellRing_check_empty(&q->body))
     {
-        return 1;
+        return -1;
     }
-    return 0;
+    return *CellRing_at(&q->body, CellRing_count(&q->body) - 1);
 }
 //-----------------------------------------------------------------------------
-// Here we check if the Circular queue is empty or not
-int16_t check_empty (CircularQueue* q)
+// Returns 1 if any cell where a part of the snake (of size pixels) would overlap
+// the rectangle x_min, y_min to x_max, y_max (inclusive, like GrRectOverlapCheck) is occupied.
+// Since parts are spaced GRID_STEP apart, a rectangle smaller than GRID_STEP - size covers at most 2x2 cells.
+// skip_cell (-1 for none) only counts if another part is in it too (overlap), so the head can be left out.
+int16_t check_occupied_rect(CircularQueue* q, int16_t size, int16_t x_min, int16_t y_min, int16_t x_max, int16_t y_max, int16_t skip_cell)
 {
-    if (q->front == -1)
+    int16_t first_column;
+    int16_t last_column;
+    int16_t first_row;
+    int16_t last_row;
+    int16_t column;
+    int16_t row;
+    int16_t cell;
+
+    // A part in column c covers GRID_ORIGIN + c*GRID_STEP to GRID_ORIGIN + c*GRID_STEP + size
+    first_column = (x_min - size - GRID_ORIGIN <= 0) ? 0 : (x_min - size - GRID_ORIGIN + GRID_STEP - 1) / GRID_STEP;
+    first_row = (y_min - size - GRID_ORIGIN <= 0) ? 0 : (y_min - size - GRID_ORIGIN + GRID_STEP - 1) / GRID_STEP;
+    last_column = (x_max < GRID_ORIGIN) ? -1 : (x_max - GRID_ORIGIN) / GRID_STEP;
+    last_row = (y_max < GRID_ORIGIN) ? -1 : (y_max - GRID_ORIGIN) / GRID_STEP;
+    if (last_column >= GRID_SIZE)
+    {
+        last_column = GRID_SIZE - 1;
+    }
+    if (last_row >= GRID_SIZE)
     {
-        return 1;
+        last_row = GRID_SIZE - 1;
+    }
+
+    for (row = first_row; row <= last_row; row++)
+    {
+        for (column = first_column; column <= last_column; column++)
+        {
+            cell = row * GRID_SIZE + column;
+            if (check_cell(q, cell) && ((cell != skip_cell) || q->overlap))
+            {
+                return 1;
+            }
+        }
     }
     return 0;
 }
 //-----------------------------------------------------------------------------
+// Here we check if the Circular queue is full or not
+int16_t check_full (CircularQueue* q)
+{
+    return CellRing_check_full(&q->body);
+}
+//-----------------------------------------------------------------------------
+// Here we check if the Circular queue is empty or not
+int16_t check_empty (CircularQueue* q)
+{
+    return CellRing_check_empty(&q->body);
+}
+//-----------------------------------------------------------------------------
 // Addtion in the Circular Queue
+// Returns 0 if the queue is full or x, y is not on the grid (outside of the screen, the snake dies there anyway)
 int16_t enqueue (CircularQueue* q, int16_t x, int16_t y)
 {
-    if (check_full (q))
+    int16_t cell = grid_cell(x, y);
+    if (cell < 0)
+    {
+        return 0;
+    }
+    if (!CellRing_enqueue(&q->body, cell))
     {
         //printf ("Overflow condition\n");
         return 0;
     }
 
-    else
+    if (check_cell(q, cell))
     {
-        if (q->front == -1)
-            q->front = 0;
-
-        q->rear = (q->rear + 1) % QUEUESIZE;
-        q->queue[q->rear].x = x;
-        q->queue[q->rear].y = y;
-        //UARTprintf("(%d, %d) was enqueued to circular queue\n", x, y);
-        return 1;
+        q->overlap = 1;
     }
+    q->occupied[cell >> 5] |= (uint32_t)1 << (cell & 31);
+    //UARTprintf("(%d, %d) was enqueued to circular queue\n", x, y);
+    return 1;
 }
 //-----------------------------------------------------------------------------
 
 void empty_queue(CircularQueue* q)
 {
-    q->front = -1;
-    q->rear = -1;
+    int16_t i;
+    CellRing_clear(&q->body);
+    for (i = 0; i < GRID_WORDS; i++)
+    {
+        q->occupied[i] = 0;
+    }
+    q->overlap = 0;
 }
 //-----------------------------------------------------------------------------
 // Removal from the Circular Queue
 Coordinat dequeue (CircularQueue* q)
 {
     Coordinat temp;
-    if (check_empty (q))
+    uint8_t cell;
+    if (!CellRing_dequeue(&q->body, &cell))
     {
         temp.x = -1;
         temp.y = -1;
         //printf ("Underflow condition\n");
         return temp;
     }
-    else
-    {
-        temp.x = q->queue[q->front].x;
-        temp.y = q->queue[q->front].y;
-        if (q->front == q->rear)
-        {
-            q->front = q->rear = -1;
-        }
-        else
-        {
-            q->front = (q->front + 1) % QUEUESIZE;
-        }
-        //UARTprintf ("(%d, %d) was dequeued from circular queue\n", x, y);
-        return temp;
-    }
+
+    q->occupied[cell >> 5] &= ~((uint32_t)1 << (cell & 31));
+    temp = cell_coordinat(cell);
+    //UARTprintf ("(%d, %d) was dequeued from circular queue\n", x, y);
+    return temp;
 }
 //-----------------------------------------------------------------------------
 // Display the queue
 void print (CircularQueue* q)
 {
-    int i;
+    uint8_t* spans[2];
+    uint16_t counts[2];
+    int16_t span;
+    uint16_t i;
+    Coordinat part;
     if (check_empty (q))
         printf ("Nothing to dequeue\n");
     else
     {
         printf ("\nThe queue looks like: \n");
-        for (i = q->front; i != q->rear; i = (i + 1) % QUEUESIZE)
+        CellRing_spans(&q->body, &spans[0], &counts[0], &spans[1], &counts[1]);
+        for (span = 0; span < 2; span++)
         {
-            printf ("(%d, %d)", q->queue[i].x, q->queue[i].y);
+            for (i = 0; i < counts[span]; i++)
+            {
+                part = cell_coordinat(spans[span][i]);
+                printf ("(%d, %d)", part.x, part.y);
+            }
         }
-        printf ("(%d, %d)\n\n", q->queue[i].x, q->queue[i].y);
+        printf ("\n\n");
 
     }
 }
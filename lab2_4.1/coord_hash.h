@@ -0,0 +1,222 @@
+#ifndef COORD_HASH_H
+#define COORD_HASH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Hash index from coordinat to list node, used by linked_list.h to make
+// search_list and delete_node O(1) on average instead of walking the list
+//
+// Open addressing with linear probing, the key is x and y packed into 32 bits.
+// Removal shifts the following entries back instead of leaving tombstones, so
+// lookups never get slower after many inserts/deletes.
+// The same coordinat may be in the list several times, every node gets its own
+// entry and a lookup returns one of them.
+//
+// By default the table is malloced and doubles when count would go above
+// max_load_percent of the capacity. Define COORD_HASH_STATIC to use a fixed
+// table of COORD_HASH_CAPACITY entries inside the struct instead (no heap,
+// for the MCU), inserts then fail when the table is at max_load_percent.
+//-----------------------------------------------------------------------------
+#ifdef COORD_HASH_STATIC
+// Has to be a power of two
+#ifndef COORD_HASH_CAPACITY
+#define COORD_HASH_CAPACITY 256
+#endif
+#endif
+
+struct _node;
+
+typedef struct
+{
+    // x in the upper 16 bits, y in the lower
+    uint32_t key;
+    // NULL if the slot is empty
+    struct _node *node;
+} CoordHashEntry;
+
+typedef struct
+{
+#ifdef COORD_HASH_STATIC
+    CoordHashEntry entries[COORD_HASH_CAPACITY];
+#else
+    CoordHashEntry *entries;
+#endif
+    // Always a power of two
+    uint32_t capacity;
+    uint32_t count;
+    // 32 - log2(capacity), the hash is the top bits of key * constant
+    uint8_t shift;
+    uint8_t max_load_percent;
+} CoordHash;
+//-----------------------------------------------------------------------------
+uint32_t coord_hash_key(int16_t x, int16_t y)
+{
+    return ((uint32_t)(uint16_t)x << 16) | (uint16_t)y;
+}
+//-----------------------------------------------------------------------------
+// Home slot of key (Fibonacci hashing)
+uint32_t coord_hash_slot(CoordHash *hash, uint32_t key)
+{
+    return (key * 2654435769u) >> hash->shift;
+}
+//-----------------------------------------------------------------------------
+// Set up an empty table with room for (at least) capacity entries
+// max_load_percent is how full the table may get, lower is faster lookups but more memory
+// It is clamped to 1-99: the table must keep an empty slot or a find of a missing key never stops
+// In static mode capacity is ignored and COORD_HASH_CAPACITY is used
+// Returns 0 if the table could not be allocated
+int16_t coord_hash_init(CoordHash *hash, uint32_t capacity, uint8_t max_load_percent)
+{
+    uint8_t bits = 1;
+
+#ifdef COORD_HASH_STATIC
+    capacity = COORD_HASH_CAPACITY;
+#endif
+    while(((uint32_t)1 << bits) < capacity && bits < 31)
+        bits++;
+    hash->capacity = (uint32_t)1 << bits;
+    hash->shift = 32 - bits;
+    hash->count = 0;
+    if(max_load_percent < 1)
+        max_load_percent = 1;
+    if(max_load_percent > 99)
+        max_load_percent = 99;
+    hash->max_load_percent = max_load_percent;
+#ifndef COORD_HASH_STATIC
+    hash->entries = (CoordHashEntry*) calloc(hash->capacity, sizeof(CoordHashEntry));
+    if(hash->entries == NULL)
+    {
+        return 0;
+    }
+#else
+    memset(hash->entries, 0, sizeof(hash->entries));
+#endif
+    return 1;
+}
+//-----------------------------------------------------------------------------
+void coord_hash_free(CoordHash *hash)
+{
+#ifndef COORD_HASH_STATIC
+    free(hash->entries);
+    hash->entries = NULL;
+#endif
+    hash->capacity = 0;
+    hash->count = 0;
+}
+//-----------------------------------------------------------------------------
+// Remove all entries, keeps the table
+void coord_hash_clear(CoordHash *hash)
+{
+    memset(hash->entries, 0, hash->capacity * sizeof(CoordHashEntry));
+    hash->count = 0;
+}
+//-----------------------------------------------------------------------------
+// Put an entry in the first free slot from its home slot, table must not be full
+void coord_hash_place(CoordHash *hash, uint32_t key, struct _node *node)
+{
+    uint32_t mask = hash->capacity - 1;
+    uint32_t i = coord_hash_slot(hash, key);
+
+    while(hash->entries[i].node != NULL)
+        i = (i + 1) & mask;
+    hash->entries[i].key = key;
+    hash->entries[i].node = node;
+    hash->count++;
+}
+//-----------------------------------------------------------------------------
+#ifndef COORD_HASH_STATIC
+// Double the table and put every entry back in
+int16_t coord_hash_grow(CoordHash *hash)
+{
+    CoordHashEntry *old = hash->entries;
+    uint32_t old_capacity = hash->capacity;
+    uint32_t i;
+
+    hash->entries = (CoordHashEntry*) calloc(old_capacity * 2, sizeof(CoordHashEntry));
+    if(hash->entries == NULL)
+    {
+        hash->entries = old;
+        return 0;
+    }
+    hash->capacity = old_capacity * 2;
+    hash->shift--;
+    hash->count = 0;
+    for(i = 0; i < old_capacity; i++)
+    {
+        if(old[i].node != NULL)
+            coord_hash_place(hash, old[i].key, old[i].node);
+    }
+    free(old);
+    return 1;
+}
+#endif
+//-----------------------------------------------------------------------------
+// Add node (stored at x, y) to the index
+// Returns 0 if the table is full (static) or could not grow
+int16_t coord_hash_insert(CoordHash *hash, int16_t x, int16_t y, struct _node *node)
+{
+    if((hash->count + 1) * 100 > hash->capacity * hash->max_load_percent)
+    {
+#ifdef COORD_HASH_STATIC
+        return 0;
+#else
+        if(!coord_hash_grow(hash))
+            return 0;
+#endif
+    }
+    coord_hash_place(hash, coord_hash_key(x, y), node);
+    return 1;
+}
+//-----------------------------------------------------------------------------
+// A node stored at x, y, or NULL if there is none
+struct _node* coord_hash_find(CoordHash *hash, int16_t x, int16_t y)
+{
+    uint32_t key = coord_hash_key(x, y);
+    uint32_t mask = hash->capacity - 1;
+    uint32_t i = coord_hash_slot(hash, key);
+
+    while(hash->entries[i].node != NULL)
+    {
+        if(hash->entries[i].key == key)
+            return hash->entries[i].node;
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+//-----------------------------------------------------------------------------
+// Remove node (stored at x, y) from the index, does nothing if it is not in it
+void coord_hash_remove(CoordHash *hash, int16_t x, int16_t y, struct _node *node)
+{
+    uint32_t mask = hash->capacity - 1;
+    uint32_t i = coord_hash_slot(hash, coord_hash_key(x, y));
+    uint32_t j;
+    uint32_t home;
+
+    while(hash->entries[i].node != node)
+    {
+        if(hash->entries[i].node == NULL)
+            return;
+        i = (i + 1) & mask;
+    }
+    hash->entries[i].node = NULL;
+    hash->count--;
+
+    // Move back every following entry that can not be found anymore with the hole at i,
+    // that is every entry whose home slot is not between the hole and where it is now
+    for(j = (i + 1) & mask; hash->entries[j].node != NULL; j = (j + 1) & mask)
+    {
+        home = coord_hash_slot(hash, hash->entries[j].key);
+        if(((j - home) & mask) >= ((j - i) & mask))
+        {
+            hash->entries[i] = hash->entries[j];
+            hash->entries[j].node = NULL;
+            i = j;
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef INDEX_LIST_H
+#define INDEX_LIST_H
+
+#include <stdint.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Compact version of the list in linked_list.h
+//
+// All nodes of a list live in one array inside the list struct and link to
+// each other with a 16-bit index instead of a pointer, so a node is 6 bytes
+// (x, y, next) on any target and a whole list of INDEX_LIST_SIZE nodes is a
+// few hundred bytes of contiguous memory.
+// Since there are no pointers in it, a list can be copied (saved and restored)
+// with a plain memcpy or struct assignment, see ilist_copy.
+//
+// Same operations as linked_list.h, node handles are indexes into nodes[].
+// Singly linked to keep the node small, so delete_at_end and remove_node walk
+// the list to find the node before.
+//-----------------------------------------------------------------------------
+// Max number of nodes in one list, at most 65535
+#ifndef INDEX_LIST_SIZE
+#define INDEX_LIST_SIZE 128
+#endif
+// Index used as NULL
+#define INDEX_LIST_NULL 0xFFFF
+
+typedef char index_list_size_must_fit_in_16_bits[(INDEX_LIST_SIZE < INDEX_LIST_NULL) ? 1 : -1];
+
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    uint16_t next;
+} IndexNode;
+
+typedef struct
+{
+    IndexNode nodes[INDEX_LIST_SIZE];
+    uint16_t head;
+    uint16_t tail;
+    uint16_t count;
+    // Released nodes, linked through next
+    uint16_t free;
+    // Nodes 0 to used-1 have been handed out at some point, the rest have never been used
+    uint16_t used;
+} IndexList;
+//-----------------------------------------------------------------------------
+void ilist_init(IndexList *list)
+{
+    list->head = INDEX_LIST_NULL;
+    list->tail = INDEX_LIST_NULL;
+    list->count = 0;
+    list->free = INDEX_LIST_NULL;
+    list->used = 0;
+}
+//-----------------------------------------------------------------------------
+// Save or restore a whole list, a snapshot is just a copy of the struct
+void ilist_copy(IndexList *dst, const IndexList *src)
+{
+    memcpy(dst, src, sizeof(IndexList));
+}
+//-----------------------------------------------------------------------------
+// Get an unused node, returns INDEX_LIST_NULL if the list is full
+uint16_t ilist_new_node(IndexList *list, int16_t x, int16_t y)
+{
+    uint16_t i;
+
+    if(list->free != INDEX_LIST_NULL)
+    {
+        i = list->free;
+        list->free = list->nodes[i].next;
+    }
+    else if(list->used < INDEX_LIST_SIZE)
+    {
+        i = list->used++;
+    }
+    else
+    {
+        return INDEX_LIST_NULL;
+    }
+    list->nodes[i].x = x;
+    list->nodes[i].y = y;
+    return i;
+}
+//-----------------------------------------------------------------------------
+//insertion at the beginning
+// All inserts return the index of the new node, or INDEX_LIST_NULL if the list is full
+uint16_t ilist_insert_at_begin(IndexList *list, int16_t x, int16_t y)
+{
+    uint16_t i = ilist_new_node(list, x, y);
+    if(i == INDEX_LIST_NULL)
+    {
+        return INDEX_LIST_NULL;
+    }
+    list->nodes[i].next = list->head;
+    list->head = i;
+    if(list->tail == INDEX_LIST_NULL)
+        list->tail = i;
+    list->count++;
+    return i;
+}
+//-----------------------------------------------------------------------------
+uint16_t ilist_insert_at_end(IndexList *list, int16_t x, int16_t y)
+{
+    uint16_t i = ilist_new_node(list, x, y);
+    if(i == INDEX_LIST_NULL)
+    {
+        return INDEX_LIST_NULL;
+    }
+    list->nodes[i].next = INDEX_LIST_NULL;
+    if(list->tail != INDEX_LIST_NULL)
+        list->nodes[list->tail].next = i;
+    else
+        list->head = i;
+    list->tail = i;
+    list->count++;
+    return i;
+}
+//-----------------------------------------------------------------------------
+uint16_t ilist_insert_after_node(IndexList *list, uint16_t node, int16_t x, int16_t y)
+{
+    uint16_t i = ilist_new_node(list, x, y);
+    if(i == INDEX_LIST_NULL)
+    {
+        return INDEX_LIST_NULL;
+    }
+    list->nodes[i].next = list->nodes[node].next;
+    list->nodes[node].next = i;
+    if(list->tail == node)
+        list->tail = i;
+    list->count++;
+    return i;
+}
+//-----------------------------------------------------------------------------
+// Unlink node i, before is the node in front of it (INDEX_LIST_NULL if i is the head)
+void ilist_unlink(IndexList *list, uint16_t before, uint16_t i)
+{
+    if(before != INDEX_LIST_NULL)
+        list->nodes[before].next = list->nodes[i].next;
+    else
+        list->head = list->nodes[i].next;
+    if(list->tail == i)
+        list->tail = before;
+    list->nodes[i].next = list->free;
+    list->free = i;
+    list->count--;
+}
+//-----------------------------------------------------------------------------
+// Remove node i, walks the list to find the node before it
+void ilist_remove_node(IndexList *list, uint16_t i)
+{
+    uint16_t before = INDEX_LIST_NULL;
+    uint16_t temp = list->head;
+
+    while(temp != INDEX_LIST_NULL && temp != i)
+    {
+        before = temp;
+        temp = list->nodes[temp].next;
+    }
+    if(temp != INDEX_LIST_NULL)
+        ilist_unlink(list, before, i);
+}
+//-----------------------------------------------------------------------------
+void ilist_delete_at_begin(IndexList *list)
+{
+    if(list->head == INDEX_LIST_NULL)
+        return;
+    ilist_unlink(list, INDEX_LIST_NULL, list->head);
+}
+//-----------------------------------------------------------------------------
+void ilist_delete_at_end(IndexList *list)
+{
+    if(list->tail == INDEX_LIST_NULL)
+        return;
+    ilist_remove_node(list, list->tail);
+}
+//-----------------------------------------------------------------------------
+void ilist_delete_node(IndexList *list, int16_t x, int16_t y)
+{
+    uint16_t before = INDEX_LIST_NULL;
+    uint16_t temp = list->head;
+
+    // Find the key to be deleted
+    while(temp != INDEX_LIST_NULL && (list->nodes[temp].x != x || list->nodes[temp].y != y))
+    {
+        before = temp;
+        temp = list->nodes[temp].next;
+    }
+
+    // If the key is not present
+    if(temp == INDEX_LIST_NULL) return;
+
+    ilist_unlink(list, before, temp);
+}
+//-----------------------------------------------------------------------------
+int ilist_search_list(IndexList *list, int16_t x, int16_t y)
+{
+    uint16_t temp = list->head;
+    while(temp != INDEX_LIST_NULL)
+    {
+        if(list->nodes[temp].x == x && list->nodes[temp].y == y)
+        {
+            return 1;
+        }
+        temp = list->nodes[temp].next;
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+// Index of the last node, INDEX_LIST_NULL if the list is empty
+uint16_t ilist_get_last(IndexList *list)
+{
+    return list->tail;
+}
+//-----------------------------------------------------------------------------
+// Delete the whole list, O(1)
+void ilist_delete_list(IndexList *list)
+{
+    ilist_init(list);
+}
+//-----------------------------------------------------------------------------
+
+#endif
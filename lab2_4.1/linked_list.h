@@ -2,19 +2,70 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "../common/pool.h"
+#include "coord_hash.h"
+
 //-----------------------------------------------------------------------------
+// Nodes are doubly linked so that a node (or the last node) can be removed without walking the list,
+// define LINKED_LIST_SINGLY before including this file to drop prev and save a pointer per node
+// (delete_at_end and remove_node then have to walk the list to find the node before).
 struct _node
 {
 	int16_t x;
 	int16_t y;
 	struct _node *next;
+#ifndef LINKED_LIST_SINGLY
+	struct _node *prev;
+#endif
 };
 //-----------------------------------------------------------------------------
+// List handle, always pass this around instead of the head pointer
+// tail and count are kept up to date by every insert/delete so the end of the list is O(1)
+typedef struct
+{
+	struct _node *head;
+	struct _node *tail;
+	uint32_t count;
+	// Optional hash index (NULL if none, see set_index), makes search_list and delete_node O(1)
+	CoordHash *index;
+} LinkedList;
+//-----------------------------------------------------------------------------
+// Nodes are taken from a static pool instead of calloc/free, so there is no heap use
+// (and no running out of heap in the middle of a game) and getting/releasing a node is O(1).
+// Define LINKED_LIST_USE_MALLOC before including this file to go back to calloc/free.
+#ifndef LINKED_LIST_USE_MALLOC
+// Max number of nodes in all lists together
+#ifndef NODE_POOL_SIZE
+#define NODE_POOL_SIZE 128
+#endif
+POOL(NodePool, struct _node, NODE_POOL_SIZE)
+NodePool node_pool;
+#endif
+//-----------------------------------------------------------------------------
+// Get a new zeroed node, returns NULL if there are none left
+struct _node* node_alloc(void)
+{
+#ifdef LINKED_LIST_USE_MALLOC
+    return (struct _node*) calloc(1, sizeof(struct _node));
+#else
+    return NodePool_alloc(&node_pool);
+#endif
+}
+//-----------------------------------------------------------------------------
+void node_free(struct _node *node)
+{
+#ifdef LINKED_LIST_USE_MALLOC
+    free(node);
+#else
+    NodePool_free(&node_pool, node);
+#endif
+}
+//-----------------------------------------------------------------------------
 /*
 // display the list
-void printList(struct _node **head)
+void printList(LinkedList *list)
 {
-	struct _node *p = *head;
+	struct _node *p = list->head;
 	printf("\n[");
 
 	//start from the beginning
@@ -27,124 +78,187 @@ void printList(struct _node **head)
 }
 */
 //-----------------------------------------------------------------------------
-//insertion at the beginning
-void insert_at_begin(struct _node **head, int16_t x, int16_t y)
+void init_list(LinkedList *list)
 {
-    //create a link
-    // For some reason this points to a place in memory that we are not allowed to access and when we try to change any values of this node, the processor sends a fault interrupt
-    struct _node *lk = (struct _node*) calloc(1, sizeof(struct _node));
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->index = NULL;
+}
+//-----------------------------------------------------------------------------
+// Use index (set up with coord_hash_init) to look up coordinats in list, it is kept in sync by
+// every insert/delete from now on. Nodes already in the list are added to it.
+// Returns 0 if they did not all fit (static index), the list then goes on without an index
+int16_t set_index(LinkedList *list, CoordHash *index)
+{
+    struct _node *temp;
+
+    list->index = NULL;
+    coord_hash_clear(index);
+    for(temp = list->head; temp != NULL; temp = temp->next)
+    {
+        if(!coord_hash_insert(index, temp->x, temp->y, temp))
+            return 0;
+    }
+    list->index = index;
+    return 1;
+}
+//-----------------------------------------------------------------------------
+// Get a node for x, y and add it to the index, NULL if there are no nodes left or the index is full
+struct _node* new_node(LinkedList *list, int16_t x, int16_t y)
+{
+    struct _node *lk = node_alloc();
     if (lk == NULL)
     {
-        return;
+        return NULL;
     }
-    lk->next = NULL;
     lk->x = x;
     lk->y = y;
-
-    // point it to old first node
-    lk->next = *head;
-
-    //point first to new first node
-    *head = lk;
+    if(list->index != NULL && !coord_hash_insert(list->index, x, y, lk))
+    {
+        node_free(lk);
+        return NULL;
+    }
+    return lk;
+}
+//-----------------------------------------------------------------------------
+// Link lk in between before and after (either may be NULL for the ends of the list)
+void link_node(LinkedList *list, struct _node *before, struct _node *lk, struct _node *after)
+{
+    lk->next = after;
+#ifndef LINKED_LIST_SINGLY
+    lk->prev = before;
+    if(after != NULL)
+        after->prev = lk;
+#endif
+    if(before != NULL)
+        before->next = lk;
+    else
+        list->head = lk;
+    if(after == NULL)
+        list->tail = lk;
+    list->count++;
 }
 //-----------------------------------------------------------------------------
-void insert_at_end(struct _node **head, int16_t x, int16_t y)
+// Node in front of node, O(1) when doubly linked
+struct _node* node_before(LinkedList *list, struct _node *node)
 {
-    // If list is empty
-    if(*head == NULL)
+#ifndef LINKED_LIST_SINGLY
+    (void)list;
+    return node->prev;
+#else
+    struct _node *temp = list->head;
+    if(temp == node)
+        return NULL;
+    while(temp != NULL && temp->next != node)
+        temp = temp->next;
+    return temp;
+#endif
+}
+//-----------------------------------------------------------------------------
+//insertion at the beginning
+// All inserts return the new node (can be passed to remove_node later), or NULL if there are no nodes left
+struct _node* insert_at_begin(LinkedList *list, int16_t x, int16_t y)
+{
+    //create a link
+    struct _node *lk = new_node(list, x, y);
+    if (lk == NULL)
     {
-        insert_at_begin(head, x, y);
-    return;
+        return NULL;
     }
-
+    link_node(list, NULL, lk, list->head);
+    return lk;
+}
+//-----------------------------------------------------------------------------
+struct _node* insert_at_end(LinkedList *list, int16_t x, int16_t y)
+{
     //create a link
-    struct _node *lk = (struct _node*) calloc(1, sizeof(struct _node));
+    struct _node *lk = new_node(list, x, y);
     if (lk == NULL)
     {
-        return;
+        return NULL;
     }
-    lk->next = NULL;
-    lk->x = x;
-    lk->y = y;
-    struct _node *linkedlist = *head;
-
-    // point it to old first node
-    while(linkedlist->next != NULL)
-        linkedlist = linkedlist->next;
-
-    //point first to new first node
-    linkedlist->next = lk;
+    link_node(list, list->tail, lk, NULL);
+    return lk;
 }
 //-----------------------------------------------------------------------------
-void insert_after_node(struct _node **head, struct _node *list, int16_t x, int16_t y)
+struct _node* insert_after_node(LinkedList *list, struct _node *node, int16_t x, int16_t y)
 {
-    struct _node *lk = (struct _node*) calloc(1, sizeof(struct _node));
+    struct _node *lk = new_node(list, x, y);
     if (lk == NULL)
     {
-        return;
+        return NULL;
     }
-    lk->next = NULL;
-    lk->x = x;
-    lk->y = y;
-    lk->next = list->next;
-    list->next = lk;
+    link_node(list, node, lk, node->next);
+    return lk;
 }
 //-----------------------------------------------------------------------------
-void delete_at_begin(struct _node **head)
+// Unlink node from the list and release it
+void remove_node(LinkedList *list, struct _node *node)
 {
-    if(!(*head))
-        return;
+    struct _node *before = node_before(list, node);
 
-    struct _node *temp = *head;
-    *head = (*head)->next;
-    free(temp);
+    if(before != NULL)
+        before->next = node->next;
+    else
+        list->head = node->next;
+    if(node->next != NULL)
+    {
+#ifndef LINKED_LIST_SINGLY
+        node->next->prev = before;
+#endif
+    }
+    else
+        list->tail = before;
+    list->count--;
+    if(list->index != NULL)
+        coord_hash_remove(list->index, node->x, node->y, node);
+    node_free(node);
 }
 //-----------------------------------------------------------------------------
-void delete_at_end(struct _node **head)
+void delete_at_begin(LinkedList *list)
 {
-    if(!(*head))
+    if(list->head == NULL)
         return;
-
-    struct _node *temp = *head;
-    if(temp->next == NULL)
-    {
-    free(temp);
-    *head = NULL;
-    }
-    while (temp->next->next != NULL)
-        temp = temp->next;
-
-    free(temp->next);
-    temp->next = NULL;
+    remove_node(list, list->head);
 }
 //-----------------------------------------------------------------------------
-void delete_node(struct _node **head, int16_t x, int16_t y)
+void delete_at_end(LinkedList *list)
 {
-    struct _node *temp = *head, *prev;
-    if (temp != NULL && temp->x == x && temp->y == y)
+    if(list->tail == NULL)
+        return;
+    remove_node(list, list->tail);
+}
+//-----------------------------------------------------------------------------
+// Delete a node at x, y (the first one without index, any one of them with index if there are several)
+void delete_node(LinkedList *list, int16_t x, int16_t y)
+{
+    struct _node *temp = list->head;
+
+    if(list->index != NULL)
     {
-        *head = temp->next;
-    free(temp);
+        temp = coord_hash_find(list->index, x, y);
+        if(temp != NULL)
+            remove_node(list, temp);
         return;
     }
 
     // Find the key to be deleted
-    while (temp != NULL && temp->x != x || temp->y != y ) {
-        prev = temp;
+    while (temp != NULL && (temp->x != x || temp->y != y))
         temp = temp->next;
-    }
 
     // If the key is not present
     if (temp == NULL) return;
 
     // Remove the node
-    prev->next = temp->next;
-    free(temp);
+    remove_node(list, temp);
 }
 //-----------------------------------------------------------------------------
-int search_list(struct _node **head, int16_t x, int16_t y)
+int search_list(LinkedList *list, int16_t x, int16_t y)
 {
-    struct _node *temp = *head;
+    struct _node *temp = list->head;
+    if(list->index != NULL)
+        return coord_hash_find(list->index, x, y) != NULL;
     while(temp != NULL)
     {
         if (temp->x == x && temp->y == y)
@@ -156,11 +270,39 @@ int search_list(struct _node **head, int16_t x, int16_t y)
     return 0;
 }
 //-----------------------------------------------------------------------------
-struct _node get_last(struct _node **head)
+// Returns NULL if the list is empty
+struct _node* get_last(LinkedList *list)
+{
+    return list->tail;
+}
+//-----------------------------------------------------------------------------
+// Delete the whole list
+// Every node of list goes back to the pool (O(n)), other lists are not touched
+void delete_list(LinkedList *list)
+{
+    struct _node *temp = list->head;
+    struct _node *next;
+
+    while(temp != NULL)
+    {
+        next = temp->next;
+        node_free(temp);
+        temp = next;
+    }
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    if(list->index != NULL)
+        coord_hash_clear(list->index);
+}
+//-----------------------------------------------------------------------------
+#ifndef LINKED_LIST_USE_MALLOC
+// Release the nodes of all lists in one go (O(1)), meant for the end of a game round
+// Every list is invalid afterwards: init_list them (and coord_hash_clear their index) before
+// using them again.
+void node_pool_release_all(void)
 {
-    struct _node *linkedlist = *head;
-    while (linkedlist->next->next != NULL)
-        linkedlist = linkedlist->next;
-    return *linkedlist;
+    NodePool_reset(&node_pool);
 }
+#endif
 //-----------------------------------------------------------------------------
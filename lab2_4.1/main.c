@@ -22,6 +22,8 @@
 #include "drivers/pinout.h"
 #include "drivers/CF128x128x16_ST7735S.h"
 #include "circular_queue.h"
+#include "../common/profile.h"
+#include "../common/draw_list.h"
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 
@@ -52,62 +54,24 @@ void ConfigureUART(void)
 // Check if food overlaps with snake
 // Returns 1 if food overlaps with snake
 // Returns 0 if food does not overlap with snake
+// Only looks at the (at most 2x2) grid cells the food covers, so it does not depend on snake length
+// The head is not checked (food on it is eaten right away), only the parts from front up to rear
 int16_t check_rect_overlap_food(CircularQueue* q, int16_t size, tRectangle food_rectangle)
 {
-    tRectangle snake_part;
-    // Temp is used to step through the list and check all elements
-    int16_t temp = q->front;
-
-    // Go trough the list and check for any overlap
-    while (temp != q->rear)
-    {
-        snake_part.i16XMin = q->queue[temp].x;
-        snake_part.i16YMin = q->queue[temp].y;
-        snake_part.i16XMax = snake_part.i16XMin + size;
-        snake_part.i16YMax = snake_part.i16YMin + size;
-        if(GrRectOverlapCheck(&food_rectangle, &snake_part))
-        {
-            // Returns 1 if food overlaps with snake
-            return 1;
-        }
-        temp = (temp + 1) % QUEUESIZE;
-    }
-    // Returns 0 if food does not overlap with snake
-    return 0;
+    int16_t overlap;
+    PROFILE_BEGIN(check_rect_overlap_food);
+    overlap = check_occupied_rect(q, size, food_rectangle.i16XMin, food_rectangle.i16YMin, food_rectangle.i16XMax, food_rectangle.i16YMax, head_cell(q));
+    PROFILE_END(check_rect_overlap_food);
+    return overlap;
 }
 //=============================================================================
 // Check if snake overlaps itself
 // Returns 1 if snake overlaps with itself
 // Returns 0 if snake does not overlap itself
-int16_t check_rect_overlap_snake(CircularQueue* q, int16_t size)
+// The head is the last part that was enqueued, enqueue marks the queue if the head was put in a cell that was already occupied
+int16_t check_rect_overlap_snake(CircularQueue* q)
 {
-    tRectangle snake_head;
-    tRectangle snake_part;
-    // Temp is used to step through the list and check all elements
-    int16_t temp = q->front;
-
-    // Head of the snake is the last element in the list (rear)
-    snake_head.i16XMin = q->queue[q->rear].x;
-    snake_head.i16YMin = q->queue[q->rear].y;
-    snake_head.i16XMax = snake_head.i16XMin + size;
-    snake_head.i16YMax = snake_head.i16YMin + size;
-
-    // Go trough the list and check for any overlap
-    while (temp != q->rear)
-    {
-        snake_part.i16XMin = q->queue[temp].x;
-        snake_part.i16YMin = q->queue[temp].y;
-        snake_part.i16XMax = snake_part.i16XMin + size;
-        snake_part.i16YMax = snake_part.i16YMin + size;
-        if(GrRectOverlapCheck(&snake_head, &snake_part))
-        {
-            // Returns 1 if snake overlaps with itself
-            return 1;
-        }
-        temp = (temp + 1) % QUEUESIZE;
-    }
-    // Returns 0 if snake does not overlap itself
-    return 0;
+    return q->overlap;
 }
 //=============================================================================
 // Main Function
@@ -138,8 +102,7 @@ int main(void)
     int16_t skip_dequeue = 0;
     // Can not initialize instantly, it causes a fault interrupt
     CircularQueue snake_queue;
-    snake_queue.front = -1;
-    snake_queue.rear = -1;
+    empty_queue(&snake_queue);
     //-----------------------------------------------------------------------------
     // Food
     tRectangle food_;
@@ -153,6 +116,7 @@ int main(void)
 
     // Run from the PLL at 40 MHz (needs to be 2*15MHz for SSIConfigSetExpClk(); to work).
     systemClock = SysCtlClockFreqSet((SYSCTL_XTAL_25MHZ | SYSCTL_OSC_MAIN | SYSCTL_USE_PLL | SYSCTL_CFG_VCO_480), 40000000);
+    PROFILE_INIT(systemClock);
 
     // Configure the device pins (Ethernet and USB).
     PinoutSet(false, false);
@@ -164,7 +128,9 @@ int main(void)
     // Clears/redraws the screen.
     CF128x128x16_ST7735SClear(background_color);
     // Initialize the grlib library.
-    GrContextInit(&context, &g_sCF128x128x16_ST7735S);
+    // Fills go through a draw list, GrFlush sends them merged into as few LCD windows as possible
+    draw_list_init(&g_sCF128x128x16_ST7735S);
+    GrContextInit(&context, &draw_list_display);
     // Sets text font.
     GrContextFontSet(&context, &g_sFontFixed6x8);
     // Set the color for pixels drawn
@@ -217,6 +183,8 @@ int main(void)
         // Set number of food eaten to 0
         num_food_eaten = 0;
 
+        // Send what is left in the draw list before clearing the screen
+        GrFlush(&context);
         // Clears/redraws the screen.
         CF128x128x16_ST7735SClear(background_color);
         // Starting position, in the middle
@@ -230,6 +198,7 @@ int main(void)
         // While loop for one round, as long as you live (doesn't cross yourself or you go out of bound)
         while (1)
         {
+            PROFILE_BEGIN(frame);
             //-----------------------------------------------------------------------------
             // VERTICAL
             // Wait for joystick trigger and then get value.
@@ -259,6 +228,8 @@ int main(void)
             //-----------------------------------------------------------------------------
             // Movement
             //-----------------------------------------------------------------------------
+            // Includes enqueue, which is where the snake is checked against itself
+            PROFILE_BEGIN(move);
             // UP
             if (joystick_val_ver > 70)
             {
@@ -342,6 +313,7 @@ int main(void)
                 enqueue(&snake_queue, snake_body.i16XMin, snake_body.i16YMin);
                 skip_dequeue = 0;
             }
+            PROFILE_END(move);
             //-----------------------------------------------------------------------------
 
             //-----------------------------------------------------------------------------
@@ -389,7 +361,7 @@ int main(void)
                 break;
             }
             // Check if snake overlaps with itself
-            if(check_rect_overlap_snake(&snake_queue, (snake_body_size-snake_body_size)) == 1)
+            if(check_rect_overlap_snake(&snake_queue) == 1)
             {
                 empty_queue(&snake_queue);
                 break;
@@ -411,7 +383,8 @@ int main(void)
                 // Skip next dequeue to simulate increased length of snake
                 skip_dequeue = 1;
             }
-            if(num_food_eaten >= QUEUESIZE)
+            // Victory when the snake covers the whole board, it started with 1 part
+            if(num_food_eaten >= GRID_CELLS - 1)
             {
                 // Set the color for pixels drawn
                 GrContextForegroundSet(&context, text_color);
@@ -428,6 +401,9 @@ int main(void)
             }
             //-----------------------------------------------------------------------------
 
+            PROFILE_END(frame);
+            PROFILE_FRAME();
+
             // According to the documentation, GrFlush is important to use when drawing pixels, since it ensures any buffered pixels are drawn
             GrFlush(&context);
 
@@ -0,0 +1,250 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "../common/pool.h"
+
+//-----------------------------------------------------------------------------
+// Unrolled version of the list in linked_list.h
+//
+// Every node (chunk) holds up to ULIST_CHUNK_SIZE coordinats instead of one,
+// so the next/prev pointers are paid once per chunk instead of once per
+// coordinat, and walking the list mostly reads neighbouring memory.
+// x and y are kept in separate arrays so search compares a whole array in a
+// tight loop.
+//
+// Same operations as linked_list.h, but positions are only meaningful as
+// coordinats (there are no node handles, elements move between chunks).
+// Chunks come from a static pool like the nodes in linked_list.h.
+//-----------------------------------------------------------------------------
+// Coordinats per chunk
+#ifndef ULIST_CHUNK_SIZE
+#define ULIST_CHUNK_SIZE 8
+#endif
+// Max number of chunks in all unrolled lists together
+#ifndef ULIST_POOL_SIZE
+#define ULIST_POOL_SIZE 32
+#endif
+
+struct _chunk
+{
+    int16_t x[ULIST_CHUNK_SIZE];
+    int16_t y[ULIST_CHUNK_SIZE];
+    // Number of used elements, they are always at the start of x and y
+    uint16_t count;
+    struct _chunk *next;
+    struct _chunk *prev;
+};
+
+typedef struct
+{
+    struct _chunk *head;
+    struct _chunk *tail;
+    // Number of coordinats (not chunks)
+    uint32_t count;
+} UnrolledList;
+
+POOL(ChunkPool, struct _chunk, ULIST_POOL_SIZE)
+ChunkPool chunk_pool;
+//-----------------------------------------------------------------------------
+void ulist_init(UnrolledList *list)
+{
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+}
+//-----------------------------------------------------------------------------
+// Get an empty chunk and link it in after before (NULL for first), returns NULL if there are none left
+struct _chunk* ulist_new_chunk(UnrolledList *list, struct _chunk *before)
+{
+    struct _chunk *chunk = ChunkPool_alloc(&chunk_pool);
+    if(chunk == NULL)
+    {
+        return NULL;
+    }
+    chunk->prev = before;
+    chunk->next = (before != NULL) ? before->next : list->head;
+    if(chunk->next != NULL)
+        chunk->next->prev = chunk;
+    else
+        list->tail = chunk;
+    if(before != NULL)
+        before->next = chunk;
+    else
+        list->head = chunk;
+    return chunk;
+}
+//-----------------------------------------------------------------------------
+void ulist_free_chunk(UnrolledList *list, struct _chunk *chunk)
+{
+    if(chunk->prev != NULL)
+        chunk->prev->next = chunk->next;
+    else
+        list->head = chunk->next;
+    if(chunk->next != NULL)
+        chunk->next->prev = chunk->prev;
+    else
+        list->tail = chunk->prev;
+    ChunkPool_free(&chunk_pool, chunk);
+}
+//-----------------------------------------------------------------------------
+// Remove element i of chunk, moves the rest down and frees the chunk if it gets empty
+// If chunk and the next chunk fit in one they are merged, so chunks stay at least about half full
+void ulist_remove_at(UnrolledList *list, struct _chunk *chunk, uint16_t i)
+{
+    struct _chunk *next = chunk->next;
+    uint16_t after = chunk->count - i - 1;
+
+    memmove(&chunk->x[i], &chunk->x[i + 1], after * sizeof(int16_t));
+    memmove(&chunk->y[i], &chunk->y[i + 1], after * sizeof(int16_t));
+    chunk->count--;
+    list->count--;
+    if(chunk->count == 0)
+    {
+        ulist_free_chunk(list, chunk);
+    }
+    else if(next != NULL && chunk->count + next->count <= ULIST_CHUNK_SIZE)
+    {
+        memcpy(&chunk->x[chunk->count], next->x, next->count * sizeof(int16_t));
+        memcpy(&chunk->y[chunk->count], next->y, next->count * sizeof(int16_t));
+        chunk->count += next->count;
+        ulist_free_chunk(list, next);
+    }
+}
+//-----------------------------------------------------------------------------
+//insertion at the beginning
+// Returns 0 if there are no chunks left
+int16_t ulist_insert_at_begin(UnrolledList *list, int16_t x, int16_t y)
+{
+    struct _chunk *chunk = list->head;
+
+    if(chunk == NULL || chunk->count == ULIST_CHUNK_SIZE)
+    {
+        chunk = ulist_new_chunk(list, NULL);
+        if(chunk == NULL)
+        {
+            return 0;
+        }
+    }
+    memmove(&chunk->x[1], &chunk->x[0], chunk->count * sizeof(int16_t));
+    memmove(&chunk->y[1], &chunk->y[0], chunk->count * sizeof(int16_t));
+    chunk->x[0] = x;
+    chunk->y[0] = y;
+    chunk->count++;
+    list->count++;
+    return 1;
+}
+//-----------------------------------------------------------------------------
+// Returns 0 if there are no chunks left
+int16_t ulist_insert_at_end(UnrolledList *list, int16_t x, int16_t y)
+{
+    struct _chunk *chunk = list->tail;
+
+    if(chunk == NULL || chunk->count == ULIST_CHUNK_SIZE)
+    {
+        chunk = ulist_new_chunk(list, list->tail);
+        if(chunk == NULL)
+        {
+            return 0;
+        }
+    }
+    chunk->x[chunk->count] = x;
+    chunk->y[chunk->count] = y;
+    chunk->count++;
+    list->count++;
+    return 1;
+}
+//-----------------------------------------------------------------------------
+void ulist_delete_at_begin(UnrolledList *list)
+{
+    if(list->head == NULL)
+        return;
+    ulist_remove_at(list, list->head, 0);
+}
+//-----------------------------------------------------------------------------
+void ulist_delete_at_end(UnrolledList *list)
+{
+    if(list->tail == NULL)
+        return;
+    ulist_remove_at(list, list->tail, list->tail->count - 1);
+}
+//-----------------------------------------------------------------------------
+// Finds the first x, y, returns 0 if it is not in the list
+int16_t ulist_find(UnrolledList *list, int16_t x, int16_t y, struct _chunk **chunk, uint16_t *i)
+{
+    struct _chunk *temp;
+    uint16_t j;
+    uint16_t match;
+
+    for(temp = list->head; temp != NULL; temp = temp->next)
+    {
+        // Compare the whole chunk without branching first (the compiler can do this a few at a time),
+        // only go back for the position in the chunk that has it
+        match = 0;
+        for(j = 0; j < ULIST_CHUNK_SIZE; j++)
+            match |= (temp->x[j] == x) & (temp->y[j] == y) & (j < temp->count);
+        if(match)
+        {
+            for(j = 0; temp->x[j] != x || temp->y[j] != y; j++)
+                ;
+            *chunk = temp;
+            *i = j;
+            return 1;
+        }
+    }
+    return 0;
+}
+//-----------------------------------------------------------------------------
+void ulist_delete_node(UnrolledList *list, int16_t x, int16_t y)
+{
+    struct _chunk *chunk;
+    uint16_t i;
+
+    if(ulist_find(list, x, y, &chunk, &i))
+        ulist_remove_at(list, chunk, i);
+}
+//-----------------------------------------------------------------------------
+int ulist_search_list(UnrolledList *list, int16_t x, int16_t y)
+{
+    struct _chunk *chunk;
+    uint16_t i;
+    return ulist_find(list, x, y, &chunk, &i);
+}
+//-----------------------------------------------------------------------------
+// Last coordinat in x, y, returns 0 if the list is empty
+int16_t ulist_get_last(UnrolledList *list, int16_t *x, int16_t *y)
+{
+    if(list->tail == NULL)
+        return 0;
+    *x = list->tail->x[list->tail->count - 1];
+    *y = list->tail->y[list->tail->count - 1];
+    return 1;
+}
+//-----------------------------------------------------------------------------
+// Delete the whole list
+// Every chunk of list goes back to the pool (O(chunks)), other unrolled lists are not touched
+void ulist_delete_list(UnrolledList *list)
+{
+    struct _chunk *chunk = list->head;
+    struct _chunk *next;
+
+    while(chunk != NULL)
+    {
+        next = chunk->next;
+        ChunkPool_free(&chunk_pool, chunk);
+        chunk = next;
+    }
+    ulist_init(list);
+}
+//-----------------------------------------------------------------------------
+// Release the chunks of all unrolled lists in one go (O(1)), meant for the end of a game round
+// Like node_pool_release_all in linked_list.h, every unrolled list has to be ulist_init again.
+void chunk_pool_release_all(void)
+{
+    ChunkPool_reset(&chunk_pool);
+}
+//-----------------------------------------------------------------------------
+
+#endif
@@ -23,8 +23,37 @@
 #include "drivers/buttons.h"
 #include "drivers/pinout.h"
 #include "drivers/CF128x128x16_ST7735S.h"
+#include "../common/hud.h"
+#include "../common/acquire.h"
+#include "../common/capture.h"
+#include "../common/stats.h"
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+// Samples per second of every sensor, the values shown are over windows of 200 samples.
+#define SAMPLE_RATE_HZ 2000
+// Samples per second of the microphone, captured by the uDMA in buffers of CAPTURE_BUFFER_SIZE.
+#define MICROPHONE_RATE_HZ 16000
+// What is shown of every sensor: STATS_MEAN, STATS_MIN, STATS_MAX, STATS_VARIANCE, STATS_STDDEV or STATS_EMA.
+// The fields have 4 digits, a larger value (STATS_VARIANCE goes up to about 4.2M) is shown as 9999.
+#define SHOWN_STATISTIC STATS_MEAN
+// The EMA of every sensor follows over about 2^EMA_SHIFT samples.
+#define EMA_SHIFT 6
+
+// Statistics of the microphone samples since the last refresh of the screen.
+Stats microphone_stats;
+
+//=============================================================================
+// Called from the ADC interrupt with every full buffer of microphone samples.
+void microphone_buffer(const uint16_t* samples, uint16_t count)
+{
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        stats_add(&microphone_stats, samples[i]);
+    }
+}
+
 //=============================================================================
 // The error routine that is called if the driver library
 // encounters an error.
@@ -48,90 +77,6 @@ void ConfigureUART(void)
     UARTStdioConfig(0, 115200, 16000000);
 }
 //=============================================================================
-// Check if two integers are of the same length (if they are of the same power of 10)
-int same_length(uint32_t a, uint32_t b)
-{
-    // Need to handle special case of when one is 0, since 1 = 1*10^1 and 0 is undefined, resulting in 0 and 1 to 9 not being considered the same length, even though they are
-    if((a<10) && (b<10))
-    {
-        return 1;
-    }
-
-    // Reduce by a power of 10^1 each time, until one (or both) is 0
-    while((a>0) && (b>0))
-    {
-        a = a/10;
-        b = b/10;
-    }
-
-    // If both a 0, then they are of the same length (except the special case of 0 and 1 to 9)
-    if((a == 0) && (b == 0))
-    {
-        return 1;
-    }
-
-    return 0;
-}
-//=============================================================================
-// A utility function to reverse a string
-void reverse_string(char str[], int length)
-{
-    char temp;
-    int start = 0;
-    int end = length - 1;
-
-    // Switch place on everything until we meet in the middle
-    while (start < end)
-    {
-        temp = str[start];
-        str[start] = str[end];
-        str[end] = temp;
-        end--;
-        start++;
-    }
-}
-//=============================================================================
-// Implementation of itoa()
-char* itoa(int num, char* str, int base)
-{
-    int i = 0;
-    bool isNegative = false;
-
-    /* Handle 0 explicitly, otherwise empty string is
-     * printed for 0 */
-    if (num == 0) {
-        str[i++] = '0';
-        str[i] = '\0';
-        return str;
-    }
-
-    // In standard itoa(), negative numbers are handled
-    // only with base 10. Otherwise numbers are
-    // considered unsigned.
-    if (num < 0 && base == 10) {
-        isNegative = true;
-        num = -num;
-    }
-
-    // Process individual digits
-    while (num != 0) {
-        int rem = num % base;
-        str[i++] = (rem > 9) ? (rem - 10) + 'a' : rem + '0';
-        num = num / base;
-    }
-
-    // If number is negative, append '-'
-    if (isNegative)
-        str[i++] = '-';
-
-    str[i] = '\0'; // Append string terminator
-
-    // Reverse the string
-    reverse_string(str, i);
-
-    return str;
-}
-//=============================================================================
 // Main Function
 int main(void)
 {
@@ -147,25 +92,29 @@ int main(void)
     // blue channel, the next byte is the green channel, and the third byte is the
     // red channel.
 
-    char itoa_buf [10];
-
-    uint32_t acc_x = 0;
-    uint32_t acc_y = 0;
-    uint32_t acc_z = 0;
-
-    uint32_t joy_x = 0;
-    uint32_t joy_y = 0;
-
-    uint32_t microphone_value = 0;
-
-    uint32_t num_samples = 0;
+    // Values, 4 digits right aligned where the "    " used to be
+    HudField field_acc_x;
+    HudField field_acc_y;
+    HudField field_acc_z;
+    HudField field_joy_x;
+    HudField field_joy_y;
+    HudField field_micro;
+
+    // One sample of every sensor, in the order of the channels given to acquire_init
+    AcquireFrame frame;
+    // Accelerometer (gyroscope?) on ADC0: X (channel 2), Y (channel 1), Z (channel 3).
+    // However, channel 3 should be X-axis, channel 2 should be Y-axis and channel 1 should be Z-axis.
+    const uint32_t adc0_channels[] = {ADC_CTL_CH2, ADC_CTL_CH1, ADC_CTL_CH3};
+    // Joystick on ADC1: horizontal (channel 0), vertical (channel 8), the microphone (channel 9) is captured on its own.
+    // However, should be channel 8 is microphone, channel 9 is joystick horizontal, channel 0 is joystick vertical.
+    const uint32_t adc1_channels[] = {ADC_CTL_CH0, ADC_CTL_CH8};
 
-    uint32_t total_val_acc_x = 0;
-    uint32_t total_val_acc_y = 0;
-    uint32_t total_val_acc_z = 0;
-    uint32_t total_val_joy_x = 0;
-    uint32_t total_val_joy_y = 0;
-    uint32_t total_val_micro = 0;
+    // Statistics of every sensor since the last refresh of the screen.
+    Stats stats_acc_x;
+    Stats stats_acc_y;
+    Stats stats_acc_z;
+    Stats stats_joy_x;
+    Stats stats_joy_y;
 
     uint32_t print_acc_x = 0;
     uint32_t print_acc_y = 0;
@@ -192,193 +141,98 @@ int main(void)
     GrContextFontSet(&context, &g_sFontFixed6x8);
     // Sets text background color.
     GrContextBackgroundSet(&context, background_color_text);
+    // The labels never change, they are drawn once
+    GrStringDrawCentered(&context, "Accelerometer X:", -1, 50, 8, 1);
+    GrStringDrawCentered(&context, "Accelerometer Y:", -1, 50, 18, 1);
+    GrStringDrawCentered(&context, "Accelerometer Z:", -1, 50, 28, 1);
+    GrStringDrawCentered(&context, "joystick      X:", -1, 50, 38, 1);
+    GrStringDrawCentered(&context, "joystick      Y:", -1, 50, 48, 1);
+    GrStringDrawCentered(&context, "Microphone     :", -1, 50, 58, 1);
+    // Digits of the font for the values, the fields start out empty (background color)
+    hud_init(&g_sFontFixed6x8);
+    hud_field_init(&field_acc_x, 98, 5, 4);
+    hud_field_init(&field_acc_y, 98, 15, 4);
+    hud_field_init(&field_acc_z, 98, 25, 4);
+    hud_field_init(&field_joy_x, 98, 35, 4);
+    hud_field_init(&field_joy_y, 98, 45, 4);
+    hud_field_init(&field_micro, 98, 55, 4);
+    hud_field_clear(&field_acc_x, &context);
+    hud_field_clear(&field_acc_y, &context);
+    hud_field_clear(&field_acc_z, &context);
+    hud_field_clear(&field_joy_x, &context);
+    hud_field_clear(&field_joy_y, &context);
+    hud_field_clear(&field_micro, &context);
     //-----------------------------------------------------------------------------
-    // Accelerometer (gyroscope?)
-    // Enable the ADC0 module.
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
-    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC0))
-    {
-    }
+    // Accelerometer (gyroscope?), potentiometer (joystick) and microphone
     // Accelerometer (gyroscope?) is on: X (PE1), Y (PE2), Z (PE0).
     // But should be on: X (PE0), Y (PE1), Z (PE2).
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-    // Accelerometer (gyroscope) X-axis (PE1)
-    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_1);
-
-    // Enables trigger from ADC on the GPIO pin.
-    // Enable the first sample sequencer to capture the value of the channel when
-    // the processor trigger occurs.
-    // Channel 2 is X-axis, channel 1 is Y-axis, channel 3 is Z-axis.
-    // However, channel 3 should be X-axis, channel 2 should be Y-axis and channel 1 should be Z-axis.
-    ADCSequenceConfigure(ADC0_BASE, 0, ADC_TRIGGER_PROCESSOR, 0);
-    ADCSequenceStepConfigure(ADC0_BASE, 0, 0, ADC_CTL_IE | ADC_CTL_END | ADC_CTL_CH2);
-    ADCSequenceEnable(ADC0_BASE, 0);
-    //-----------------------------------------------------------------------------
-    // Potentiometer (joystick) and Microphone
-    // Enable the ADC1 module.
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC1);
-    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC1))
-    {
-    }
     // Microphone (PE3), joystick horizontal (PE4), joystick vertical (PE5).
     // However, should be Microphone (PE5), joystick horizontal (PE4), joystick vertical (PE3).
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-    //  Joystick vertical (PE3).
-    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_3);
-
-    // Enables trigger from ADC on the GPIO pin.
-    // Enable the first sample sequencer to capture the value of the channel when
-    // the processor trigger occurs.
-    // Channel 9 is microphone, channel 0 is joystick horizontal, channel 8 is joystick vertical.
-    // However, should be channel 8 is microphone, channel 9 is joystick horizontal, channel 0 is joystick vertical.
-    ADCSequenceConfigure(ADC1_BASE, 0, ADC_TRIGGER_PROCESSOR, 0);
-    ADCSequenceStepConfigure(ADC1_BASE, 0, 0, ADC_CTL_IE | ADC_CTL_END | ADC_CTL_CH9);
-    ADCSequenceEnable(ADC1_BASE, 0);
+    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5);
+    stats_init(&stats_acc_x, EMA_SHIFT);
+    stats_init(&stats_acc_y, EMA_SHIFT);
+    stats_init(&stats_acc_z, EMA_SHIFT);
+    stats_init(&stats_joy_x, EMA_SHIFT);
+    stats_init(&stats_joy_y, EMA_SHIFT);
+    stats_init(&microphone_stats, EMA_SHIFT);
+    // The five are sampled together SAMPLE_RATE_HZ times per second by TIMER0, one
+    // sequencer on each ADC, and come in through the ADC interrupts.
+    acquire_init(systemClock, SAMPLE_RATE_HZ, adc0_channels, 3, adc1_channels, 2);
+    // The microphone goes to memory with the uDMA, microphone_buffer gets every full buffer.
+    capture_init(systemClock, MICROPHONE_RATE_HZ, ADC_CTL_CH9, microphone_buffer);
     //-----------------------------------------------------------------------------
 
     while (1)
     {
-        // Used for taking average over 10 samples.
-        num_samples++;
-
-        //-----------------------------------------------------------------------------
-        // Accelerometer (Gyroscope?) X-axis
-        // Switch to PE1 (Accelerometer X-axis).
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_1);
-        // Switch ADC0 to channel 2 for Accelerometer (gyroscope?) X-axis.
-        ADCSequenceStepConfigure(ADC0_BASE, 0, 0, ADC_CTL_IE | ADC_CTL_END | ADC_CTL_CH2);
-        // Wait for Accelerometer (gyroscope) X-axis (PE1) value.
-        ADCProcessorTrigger(ADC0_BASE, 0);
-        while(!ADCIntStatus(ADC0_BASE, 0, false))
-        {
-        }
-        ADCSequenceDataGet(ADC0_BASE, 0, &acc_x);
-        // Used for average value.
-        total_val_acc_x = total_val_acc_x + acc_x;
-        //-----------------------------------------------------------------------------
-        // Accelerometer (Gyroscope?) Y-axis
-        // Switch to PE2 (Accelerometer Y-axis).
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_2);
-        // Switch ADC0 to channel 1 for Accelerometer (gyroscope?) Y-axis.
-        ADCSequenceStepConfigure(ADC0_BASE, 0, 0, ADC_CTL_IE | ADC_CTL_END | ADC_CTL_CH1);
-        // Wait for Accelerometer (gyroscope) Y-axis (PE2) value.
-        ADCProcessorTrigger(ADC0_BASE, 0);
-        while (!ADCIntStatus(ADC0_BASE, 0, false))
+        // Sleep until the next sample is in.
+        while (!acquire_get(&frame))
         {
+            SysCtlSleep();
         }
-        ADCSequenceDataGet(ADC0_BASE, 0, &acc_y);
-        // Used for average value.
-        total_val_acc_y = total_val_acc_y + acc_y;
-        //-----------------------------------------------------------------------------
-        // Accelerometer (Gyroscope?) Z-axis
-        // Switch to PE0 (Accelerometer Z-axis).
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_0);
-        // Switch ADC0 to channel 3 for Accelerometer (gyroscope?) Z-axis.
-        ADCSequenceStepConfigure(ADC0_BASE, 0, 0, ADC_CTL_IE | ADC_CTL_END | ADC_CTL_CH3);
-        // Wait for Accelerometer (gyroscope) Z-axis (PE0) value.
-        ADCProcessorTrigger(ADC0_BASE, 0);
-        while (!ADCIntStatus(ADC0_BASE, 0, false))
-        {
-        }
-        ADCSequenceDataGet(ADC0_BASE, 0, &acc_z);
-        // Used for average value.
-        total_val_acc_z = total_val_acc_z + acc_z;
-        //-----------------------------------------------------------------------------
-
-        //-----------------------------------------------------------------------------
-        // Joystick horizontal
-        // Switch to PE4 (Joystick horizontal).
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_4);
-        // Switch ADC1 to channel 0 for joystick horizontal.
-        ADCSequenceStepConfigure(ADC1_BASE, 0, 0, ADC_CTL_IE | ADC_CTL_END | ADC_CTL_CH0);
-        // Wait for joystick horizontal.
-        ADCProcessorTrigger(ADC1_BASE, 0);
-        while (!ADCIntStatus(ADC1_BASE, 0, false))
-        {
-        }
-        ADCSequenceDataGet(ADC1_BASE, 0, &joy_x);
-        // Used for average value.
-        total_val_joy_x = total_val_joy_x + joy_x;
-        //-----------------------------------------------------------------------------
-        // Joystick vertical
-        // Switch to PE5 (Joystick vertical).
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_5);
-        // Switch ADC1 to channel 8 for joystick vertical.
-        ADCSequenceStepConfigure(ADC1_BASE, 0, 0, ADC_CTL_IE | ADC_CTL_END | ADC_CTL_CH8);
-        // Wait for joystick vertical.
-        ADCProcessorTrigger(ADC1_BASE, 0);
-        while (!ADCIntStatus(ADC1_BASE, 0, false))
-        {
-        }
-        ADCSequenceDataGet(ADC1_BASE, 0, &joy_y);
-        // Used for average value.
-        total_val_joy_y = total_val_joy_y + joy_y;
-        //-----------------------------------------------------------------------------
-
-        //-----------------------------------------------------------------------------
-        // Microphone
-        // Switch to PE3 (Microphone).
-        GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_3);
-        // Switch ADC1 to channel 9 for microphone.
-        ADCSequenceStepConfigure(ADC1_BASE, 0, 0, ADC_CTL_IE | ADC_CTL_END | ADC_CTL_CH9);
-        // Wait for microphone.
-        ADCProcessorTrigger(ADC1_BASE, 0);
-        while (!ADCIntStatus(ADC1_BASE, 0, false))
-        {
-        }
-        ADCSequenceDataGet(ADC1_BASE, 0, &microphone_value);
-        // Used for average value.
-        total_val_micro = total_val_micro + microphone_value;
-        //-----------------------------------------------------------------------------
-
-        // Take average over 10 samples.
-        if(num_samples >= 200)
+        stats_add(&stats_acc_x, frame.values[0]);
+        stats_add(&stats_acc_y, frame.values[1]);
+        stats_add(&stats_acc_z, frame.values[2]);
+        stats_add(&stats_joy_x, frame.values[3]);
+        stats_add(&stats_joy_y, frame.values[4]);
+
+        // Refresh the screen every 200 samples, then start new windows (the EMAs go on).
+        if(stats_acc_x.count >= 200)
         {
             //-----------------------------------------------------------------------------
             // Accelerometer X-axis
-            print_acc_x = total_val_acc_x / num_samples;
-            GrStringDrawCentered(&context, "Accelerometer X:", -1, 50, 8, 1);
-            GrStringDrawCentered(&context, "    ", -1, 110, 8, 1);
-            GrStringDrawCentered(&context, itoa(print_acc_x, itoa_buf, 10), -1, 110, 8, 1);
-            total_val_acc_x = 0;
+            print_acc_x = stats_get(&stats_acc_x, SHOWN_STATISTIC);
+            hud_field_set(&field_acc_x, &context, print_acc_x);
+            stats_reset(&stats_acc_x);
             //-----------------------------------------------------------------------------
             // Accelerometer Y-axis
-            print_acc_y = total_val_acc_y / num_samples;
-            GrStringDrawCentered(&context, "Accelerometer Y:", -1, 50, 18, 1);
-            GrStringDrawCentered(&context, "    ", -1, 110, 18, 1);
-            GrStringDrawCentered(&context, itoa(print_acc_y, itoa_buf, 10), -1, 110, 18, 1);
-            total_val_acc_y = 0;
+            print_acc_y = stats_get(&stats_acc_y, SHOWN_STATISTIC);
+            hud_field_set(&field_acc_y, &context, print_acc_y);
+            stats_reset(&stats_acc_y);
             //-----------------------------------------------------------------------------
             // Accelerometer Z-axis
-            print_acc_z = total_val_acc_z / num_samples;
-            GrStringDrawCentered(&context, "Accelerometer Z:", -1, 50, 28, 1);
-            GrStringDrawCentered(&context, "    ", -1, 110, 28, 1);
-            GrStringDrawCentered(&context, itoa(print_acc_z, itoa_buf, 10), -1, 110, 28, 1);
-            total_val_acc_z = 0;
+            print_acc_z = stats_get(&stats_acc_z, SHOWN_STATISTIC);
+            hud_field_set(&field_acc_z, &context, print_acc_z);
+            stats_reset(&stats_acc_z);
             //-----------------------------------------------------------------------------
             // Joystick horizontal
-            print_joy_x = total_val_joy_x / num_samples;
-            GrStringDrawCentered(&context, "joystick      X:", -1, 50, 38, 1);
-            GrStringDrawCentered(&context, "    ", -1, 110, 38, 1);
-            GrStringDrawCentered(&context, itoa(print_joy_x, itoa_buf, 10), -1, 110, 38, 1);
-            total_val_joy_x = 0;
+            print_joy_x = stats_get(&stats_joy_x, SHOWN_STATISTIC);
+            hud_field_set(&field_joy_x, &context, print_joy_x);
+            stats_reset(&stats_joy_x);
             //-----------------------------------------------------------------------------
             // Joystick vertical
-            print_joy_y = total_val_joy_y / num_samples;
-            GrStringDrawCentered(&context, "joystick      Y:", -1, 50, 48, 1);
-            GrStringDrawCentered(&context, "    ", -1, 110, 48, 1);
-            GrStringDrawCentered(&context, itoa(print_joy_y, itoa_buf, 10), -1, 110, 48, 1);
-            total_val_joy_y = 0;
+            print_joy_y = stats_get(&stats_joy_y, SHOWN_STATISTIC);
+            hud_field_set(&field_joy_y, &context, print_joy_y);
+            stats_reset(&stats_joy_y);
             //-----------------------------------------------------------------------------
             // Microphone
-            print_micro = total_val_micro / num_samples;
-            GrStringDrawCentered(&context, "Microphone     :", -1, 50, 58, 1);
-            GrStringDrawCentered(&context, "    ", -1, 110, 58, 1);
-            GrStringDrawCentered(&context, itoa(print_micro, itoa_buf, 10), -1, 110, 58, 1);
-            total_val_micro = 0;
+            // microphone_buffer adds to it in the ADC interrupt.
+            IntDisable(INT_ADC1SS3);
+            print_micro = stats_get(&microphone_stats, SHOWN_STATISTIC);
+            stats_reset(&microphone_stats);
+            IntEnable(INT_ADC1SS3);
+            hud_field_set(&field_micro, &context, print_micro);
             //-----------------------------------------------------------------------------
-
-            num_samples = 0;
         }
     }
 }